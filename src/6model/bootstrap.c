@@ -578,6 +578,11 @@ static void string_consts(MVMThreadContext *tc) {
     string_creator(kind, "kind");
     string_creator(instrumented, "instrumented");
     string_creator(heap, "heap");
+    string_creator(queue, "queue");
+    string_creator(capacity, "capacity");
+    string_creator(sampling, "sampling");
+    string_creator(interval, "interval");
+    string_creator(path, "path");
 }
 
 /* Drives the overall bootstrap process. */
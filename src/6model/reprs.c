@@ -239,6 +239,8 @@ void MVM_repr_initialize_registry(MVMThreadContext *tc) {
     register_core_repr(NativeRef);
     register_core_repr(MultiDimArray);
     register_core_repr(Decoder);
+    register_core_repr(ConcLockFreeQueue);
+    register_core_repr(StrBuilder);
 
     tc->instance->num_reprs = MVM_REPR_CORE_COUNT;
 }
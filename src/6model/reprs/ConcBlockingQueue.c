@@ -290,3 +290,25 @@ MVMObject * MVM_concblockingqueue_poll(MVMThreadContext *tc, MVMConcBlockingQueu
 
     return result;
 }
+
+/* Takes up to max items that are immediately available from the queue and
+ * pushes them onto the target array, returning how many were taken. Does
+ * not block. */
+MVMint64 MVM_concblockingqueue_drain(MVMThreadContext *tc, MVMConcBlockingQueue *queue,
+        MVMObject *target, MVMint64 max) {
+    MVMint64 num_taken = 0;
+    MVMROOT(tc, queue, {
+    MVMROOT(tc, target, {
+        while (num_taken < max && MVM_load(&queue->body.elems) > 0) {
+            MVMObject *taken = MVM_concblockingqueue_poll(tc, queue);
+            if (MVM_is_null(tc, taken))
+                break;
+            MVMROOT(tc, taken, {
+                MVM_repr_push_o(tc, target, taken);
+            });
+            num_taken++;
+        }
+    });
+    });
+    return num_taken;
+}
@@ -35,3 +35,5 @@ const MVMREPROps * MVMConcBlockingQueue_initialize(MVMThreadContext *tc);
 
 /* Operations on concurrent blocking queues. */
 MVMObject * MVM_concblockingqueue_poll(MVMThreadContext *tc, MVMConcBlockingQueue *queue);
+MVMint64 MVM_concblockingqueue_drain(MVMThreadContext *tc, MVMConcBlockingQueue *queue,
+    MVMObject *target, MVMint64 max);
@@ -0,0 +1,429 @@
+#include "moar.h"
+#include <platform/threads.h>
+
+/* This representation's function pointer table. */
+static const MVMREPROps this_repr;
+
+/* Marker placed in a slot once a consumer has been at it. */
+#define TAKEN ((MVMObject *)1)
+
+/* Creates a new type object of this representation, and associates it with
+ * the given HOW. */
+static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
+    MVMSTable *st  = MVM_gc_allocate_stable(tc, &this_repr, HOW);
+
+    MVMROOT(tc, st, {
+        MVMObject *obj = MVM_gc_allocate_type_object(tc, st);
+        MVM_ASSIGN_REF(tc, &(st->header), st->WHAT, obj);
+        st->size = sizeof(MVMConcLockFreeQueue);
+    });
+
+    return st->WHAT;
+}
+
+/* Allocates a new, empty, segment. */
+static MVMConcLockFreeQueueSegment * new_segment(MVMThreadContext *tc) {
+    return MVM_fixed_size_alloc_zeroed(tc, tc->instance->fsa,
+        sizeof(MVMConcLockFreeQueueSegment));
+}
+
+/* Initializes a new instance. */
+static void initialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
+    MVMConcLockFreeQueueBody     *body      = (MVMConcLockFreeQueueBody *)data;
+    MVMConcLockFreeQueueREPRData *repr_data = (MVMConcLockFreeQueueREPRData *)st->REPR_data;
+    MVMConcLockFreeQueueState    *qs;
+    int init_stat;
+
+    qs = MVM_calloc(1, sizeof(MVMConcLockFreeQueueState));
+    if ((init_stat = uv_mutex_init(&qs->park_lock)) < 0)
+        MVM_exception_throw_adhoc(tc, "Failed to initialize mutex: %s",
+            uv_strerror(init_stat));
+    if ((init_stat = uv_cond_init(&qs->not_empty)) < 0)
+        MVM_exception_throw_adhoc(tc, "Failed to initialize condition variable: %s",
+            uv_strerror(init_stat));
+    if ((init_stat = uv_cond_init(&qs->not_full)) < 0)
+        MVM_exception_throw_adhoc(tc, "Failed to initialize condition variable: %s",
+            uv_strerror(init_stat));
+    qs->head = qs->tail = new_segment(tc);
+    qs->capacity = repr_data ? repr_data->capacity : 0;
+    body->state = qs;
+}
+
+/* Copies the body of one object to another. */
+static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
+    MVM_exception_throw_adhoc(tc, "Cannot copy object with representation ConcLockFreeQueue");
+}
+
+/* Called by the VM to mark any GCable items. */
+static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
+    /* At this point we know the world is stopped, and that nobody is part
+     * way through a queue operation, so we can just walk the segments. */
+    MVMConcLockFreeQueueBody    *body = (MVMConcLockFreeQueueBody *)data;
+    MVMConcLockFreeQueueSegment *cur  = body->state ? body->state->head : NULL;
+    while (cur) {
+        MVMuint32 i;
+        for (i = 0; i < MVM_CONC_LFQ_SEGMENT_SIZE; i++)
+            if (cur->items[i] && cur->items[i] != TAKEN)
+                MVM_gc_worklist_add(tc, worklist, &(cur->items[i]));
+        cur = cur->next;
+    }
+}
+
+/* Called by the VM in order to free memory associated with this object. */
+static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
+    MVMConcLockFreeQueue      *queue = (MVMConcLockFreeQueue *)obj;
+    MVMConcLockFreeQueueState *qs    = queue->body.state;
+    if (qs) {
+        MVMConcLockFreeQueueSegment *cur = qs->head;
+        while (cur) {
+            MVMConcLockFreeQueueSegment *next = cur->next;
+            MVM_fixed_size_free(tc, tc->instance->fsa,
+                sizeof(MVMConcLockFreeQueueSegment), cur);
+            cur = next;
+        }
+        uv_mutex_destroy(&qs->park_lock);
+        uv_cond_destroy(&qs->not_empty);
+        uv_cond_destroy(&qs->not_full);
+        MVM_free(qs);
+        queue->body.state = NULL;
+    }
+}
+
+/* Frees the REPR data. */
+static void gc_free_repr_data(MVMThreadContext *tc, MVMSTable *st) {
+    MVM_free(st->REPR_data);
+}
+
+static const MVMStorageSpec storage_spec = {
+    MVM_STORAGE_SPEC_REFERENCE, /* inlineable */
+    0,                          /* bits */
+    0,                          /* align */
+    MVM_STORAGE_SPEC_BP_NONE,   /* boxed_primitive */
+    0,                          /* can_box */
+    0,                          /* is_unsigned */
+};
+
+/* Gets the storage specification for this representation. */
+static const MVMStorageSpec * get_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    return &storage_spec;
+}
+
+/* Compose the representation. Optionally takes a queue hash with a capacity
+ * in it, making the queue bounded. */
+static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *repr_info) {
+    MVMStringConsts *str_consts = &(tc->instance->str_consts);
+    MVMObject *info = MVM_repr_at_key_o(tc, repr_info, str_consts->queue);
+    if (!MVM_is_null(tc, info)) {
+        MVMObject *capacity = MVM_repr_at_key_o(tc, info, str_consts->capacity);
+        if (!MVM_is_null(tc, capacity)) {
+            MVMint64 cap = MVM_repr_get_int(tc, capacity);
+            MVMConcLockFreeQueueREPRData *repr_data;
+            if (cap < 1)
+                MVM_exception_throw_adhoc(tc,
+                    "ConcLockFreeQueue capacity must be at least 1");
+            repr_data = MVM_calloc(1, sizeof(MVMConcLockFreeQueueREPRData));
+            repr_data->capacity = (MVMuint64)cap;
+            st->REPR_data = repr_data;
+        }
+    }
+}
+
+/* Tries to add an item to the tail of the queue. Never fails, though may
+ * have to retry internally. Does not allocate GC-able memory, so cannot
+ * trigger GC. */
+static void enqueue(MVMThreadContext *tc, MVMConcLockFreeQueueState *qs, MVMObject *item) {
+    while (1) {
+        MVMConcLockFreeQueueSegment *seg  = (MVMConcLockFreeQueueSegment *)MVM_load(&qs->tail);
+        MVMConcLockFreeQueueSegment *next = (MVMConcLockFreeQueueSegment *)MVM_load(&seg->next);
+        AO_t idx;
+
+        /* If the tail is lagging, help move it along. */
+        if (next) {
+            MVM_trycas(&qs->tail, seg, next);
+            continue;
+        }
+
+        /* Claim a slot; if it's in this segment, try to fill it. A consumer
+         * may have marked it taken already, in which case we go again. */
+        idx = MVM_incr(&seg->enq_idx);
+        if (idx < MVM_CONC_LFQ_SEGMENT_SIZE) {
+            if (MVM_trycas(&seg->items[idx], NULL, item))
+                return;
+            continue;
+        }
+
+        /* Segment is full. Try to link on a new one with our item already
+         * in it; if somebody else beat us to it, discard ours. */
+        if (seg == (MVMConcLockFreeQueueSegment *)MVM_load(&qs->tail)) {
+            MVMConcLockFreeQueueSegment *new_seg = new_segment(tc);
+            new_seg->items[0] = item;
+            new_seg->enq_idx = 1;
+            if (MVM_trycas(&seg->next, NULL, new_seg)) {
+                MVM_trycas(&qs->tail, seg, new_seg);
+                return;
+            }
+            MVM_fixed_size_free(tc, tc->instance->fsa,
+                sizeof(MVMConcLockFreeQueueSegment), new_seg);
+        }
+    }
+}
+
+/* Tries to take an item from the head of the queue, returning NULL if it is
+ * empty. Cannot trigger GC. */
+static MVMObject * dequeue(MVMThreadContext *tc, MVMConcLockFreeQueueState *qs) {
+    while (1) {
+        MVMConcLockFreeQueueSegment *seg = (MVMConcLockFreeQueueSegment *)MVM_load(&qs->head);
+        AO_t deq = MVM_load(&seg->deq_idx);
+        AO_t idx;
+        MVMObject *item;
+
+        /* If we've used up this segment, move on to the next one if there
+         * is one; the winner of the race to do so frees the old one once
+         * nobody can be looking at it any more. */
+        if (deq >= MVM_CONC_LFQ_SEGMENT_SIZE) {
+            MVMConcLockFreeQueueSegment *next = (MVMConcLockFreeQueueSegment *)MVM_load(&seg->next);
+            if (!next)
+                return NULL;
+            if (MVM_trycas(&qs->head, seg, next))
+                MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
+                    sizeof(MVMConcLockFreeQueueSegment), seg);
+            continue;
+        }
+
+        /* If no producer has claimed the slot, the queue is empty. */
+        if (deq >= MVM_load(&seg->enq_idx))
+            return NULL;
+
+        /* Claim a slot and mark it taken. If the producer didn't fill it yet,
+         * it will find the marker and go elsewhere, so we try again. */
+        idx = MVM_incr(&seg->deq_idx);
+        if (idx >= MVM_CONC_LFQ_SEGMENT_SIZE)
+            continue;
+        do {
+            item = (MVMObject *)MVM_load(&seg->items[idx]);
+        } while (!MVM_trycas(&seg->items[idx], item, TAKEN));
+        if (item)
+            return item;
+    }
+}
+
+/* Checks if the thing a waiter is waiting for is there. */
+MVM_STATIC_INLINE MVMint32 ready(MVMConcLockFreeQueueState *qs, MVMint32 for_space) {
+    return for_space
+        ? MVM_load(&qs->reserved) < qs->capacity
+        : MVM_load(&qs->elems) > 0;
+}
+
+/* Waits until there's an item in the queue (or, if for_space is set, until
+ * there's space for one). We spin a while first, since the wait is often
+ * short, and then park. Any objects the caller holds must be rooted, since
+ * GC may happen while we wait. */
+static void wait_for(MVMThreadContext *tc, MVMConcLockFreeQueueState *qs, MVMint32 for_space) {
+    AO_t      *waiters = for_space ? &qs->push_waiters : &qs->shift_waiters;
+    uv_cond_t *cond    = for_space ? &qs->not_full : &qs->not_empty;
+    MVMuint32  i;
+
+    /* Callers may loop back to us when what they wait for is announced but
+     * not yet there, so always reach a GC sync point before returning. */
+    for (i = 0; i < MVM_CONC_LFQ_SPIN_LIMIT; i++) {
+        GC_SYNC_POINT(tc);
+        if (ready(qs, for_space))
+            return;
+        if (i >= MVM_CONC_LFQ_SPIN_LIMIT / 2)
+            MVM_platform_thread_yield();
+    }
+
+    /* We announce ourselves as a waiter before checking again, and wakers
+     * change the state before checking for waiters, so one of us always
+     * sees the other. */
+    MVM_gc_mark_thread_blocked(tc);
+    uv_mutex_lock(&qs->park_lock);
+    MVM_incr(waiters);
+    while (!ready(qs, for_space))
+        uv_cond_wait(cond, &qs->park_lock);
+    MVM_decr(waiters);
+    uv_mutex_unlock(&qs->park_lock);
+    MVM_gc_mark_thread_unblocked(tc);
+}
+
+/* Wakes a thread waiting for an item (or for space), if there are any. The
+ * caller may hold an unrooted object, so we must not let GC run. There's no
+ * need to: waiters only hold the park lock briefly, and never while waiting
+ * for GC, so taking it cannot hold up a collection for long. */
+static void wake_one(MVMThreadContext *tc, MVMConcLockFreeQueueState *qs, MVMint32 for_space) {
+    if (MVM_load(for_space ? &qs->push_waiters : &qs->shift_waiters)) {
+        uv_mutex_lock(&qs->park_lock);
+        uv_cond_signal(for_space ? &qs->not_full : &qs->not_empty);
+        uv_mutex_unlock(&qs->park_lock);
+    }
+}
+
+/* Takes an item from the queue if there is one, updating counters and waking
+ * a producer waiting for space if needed. Returns NULL if the queue is
+ * empty. Cannot trigger GC. */
+static MVMObject * take(MVMThreadContext *tc, MVMConcLockFreeQueueState *qs) {
+    MVMObject *item = dequeue(tc, qs);
+    if (item) {
+        MVM_decr(&qs->elems);
+        if (qs->capacity) {
+            MVM_decr(&qs->reserved);
+            wake_one(tc, qs, 1);
+        }
+    }
+    return item;
+}
+
+static MVMuint64 elems(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
+    MVMConcLockFreeQueueBody *body = (MVMConcLockFreeQueueBody *)data;
+    return MVM_load(&body->state->elems);
+}
+
+static void push(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMRegister value, MVMuint16 kind) {
+    MVMConcLockFreeQueueState *qs = ((MVMConcLockFreeQueueBody *)data)->state;
+    MVMObject *to_add = value.o;
+
+    if (kind != MVM_reg_obj)
+        MVM_exception_throw_adhoc(tc,
+            "Can only push objects to a lock-free concurrent queue");
+    if (value.o == NULL)
+        MVM_exception_throw_adhoc(tc,
+            "Cannot store a null value in a lock-free concurrent queue");
+
+    /* If the queue is bounded, reserve a slot, waiting if it's full. */
+    if (qs->capacity) {
+        MVMROOT(tc, root, {
+        MVMROOT(tc, to_add, {
+            while (1) {
+                AO_t reserved = MVM_load(&qs->reserved);
+                if (reserved < qs->capacity) {
+                    if (MVM_trycas(&qs->reserved, reserved, reserved + 1))
+                        break;
+                }
+                else {
+                    wait_for(tc, qs, 1);
+                }
+            }
+        });
+        });
+    }
+
+    /* Add the item; nothing from here on can trigger GC. The count goes up
+     * first, as a consumer may take the item and decrement it as soon as it
+     * is enqueued, and it must never go below zero. */
+    MVM_gc_write_barrier(tc, &(root->header), &(to_add->header));
+    MVM_incr(&qs->elems);
+    enqueue(tc, qs, to_add);
+    wake_one(tc, qs, 0);
+}
+
+static void shift(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMRegister *value, MVMuint16 kind) {
+    MVMConcLockFreeQueueState *qs = ((MVMConcLockFreeQueueBody *)data)->state;
+    MVMObject *taken;
+
+    if (kind != MVM_reg_obj)
+        MVM_exception_throw_adhoc(tc, "Can only shift objects from a ConcLockFreeQueue");
+
+    /* The state is not GC-managed, so we don't need to re-fetch it after
+     * waiting. */
+    while (!(taken = take(tc, qs)))
+        wait_for(tc, qs, 0);
+    value->o = taken;
+}
+
+static void at_pos(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data, MVMint64 index, MVMRegister *value, MVMuint16 kind) {
+    MVM_exception_throw_adhoc(tc,
+        "Cannot peek at the head of a lock-free concurrent queue");
+}
+
+/* Set the size of the STable. */
+static void deserialize_stable_size(MVMThreadContext *tc, MVMSTable *st, MVMSerializationReader *reader) {
+    st->size = sizeof(MVMConcLockFreeQueue);
+}
+
+/* Calculates the non-GC-managed memory we hold on to. */
+static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
+    MVMConcLockFreeQueueBody    *body = (MVMConcLockFreeQueueBody *)data;
+    MVMConcLockFreeQueueSegment *cur  = body->state ? body->state->head : NULL;
+    MVMuint64 size = body->state ? sizeof(MVMConcLockFreeQueueState) : 0;
+    while (cur) {
+        size += sizeof(MVMConcLockFreeQueueSegment);
+        cur = cur->next;
+    }
+    return size;
+}
+
+/* Initializes the representation. */
+const MVMREPROps * MVMConcLockFreeQueue_initialize(MVMThreadContext *tc) {
+    return &this_repr;
+}
+
+static const MVMREPROps this_repr = {
+    type_object_for,
+    MVM_gc_allocate_object,
+    initialize,
+    copy_to,
+    MVM_REPR_DEFAULT_ATTR_FUNCS,
+    MVM_REPR_DEFAULT_BOX_FUNCS,
+    {
+        at_pos,
+        MVM_REPR_DEFAULT_BIND_POS,
+        MVM_REPR_DEFAULT_SET_ELEMS,
+        push,
+        MVM_REPR_DEFAULT_POP,
+        MVM_REPR_DEFAULT_UNSHIFT,
+        shift,
+        MVM_REPR_DEFAULT_SPLICE,
+        MVM_REPR_DEFAULT_AT_POS_MULTIDIM,
+        MVM_REPR_DEFAULT_BIND_POS_MULTIDIM,
+        MVM_REPR_DEFAULT_DIMENSIONS,
+        MVM_REPR_DEFAULT_SET_DIMENSIONS,
+        MVM_REPR_DEFAULT_GET_ELEM_STORAGE_SPEC
+    },    /* pos_funcs */
+    MVM_REPR_DEFAULT_ASS_FUNCS,
+    elems,
+    get_storage_spec,
+    NULL, /* change_type */
+    NULL, /* serialize */
+    NULL, /* deserialize */
+    NULL, /* serialize_repr_data */
+    NULL, /* deserialize_repr_data */
+    deserialize_stable_size,
+    gc_mark,
+    gc_free,
+    NULL, /* gc_cleanup */
+    NULL, /* gc_mark_repr_data */
+    gc_free_repr_data,
+    compose,
+    NULL, /* spesh */
+    "ConcLockFreeQueue", /* name */
+    MVM_REPR_ID_ConcLockFreeQueue,
+    unmanaged_size,
+    NULL, /* describe_refs */
+};
+
+/* Polls a queue for a value, returning VMNull if none is available. */
+MVMObject * MVM_conclockfreequeue_poll(MVMThreadContext *tc, MVMConcLockFreeQueue *queue) {
+    MVMObject *taken = take(tc, queue->body.state);
+    return taken ? taken : tc->instance->VMNull;
+}
+
+/* Takes up to max items that are immediately available from the queue and
+ * pushes them onto the target array, returning how many were taken. Does
+ * not block. */
+MVMint64 MVM_conclockfreequeue_drain(MVMThreadContext *tc, MVMConcLockFreeQueue *queue,
+        MVMObject *target, MVMint64 max) {
+    MVMConcLockFreeQueueState *qs = queue->body.state;
+    MVMint64 num_taken = 0;
+    MVMROOT(tc, target, {
+        while (num_taken < max) {
+            MVMObject *taken = take(tc, qs);
+            if (!taken)
+                break;
+            MVMROOT(tc, taken, {
+                MVM_repr_push_o(tc, target, taken);
+            });
+            num_taken++;
+        }
+    });
+    return num_taken;
+}
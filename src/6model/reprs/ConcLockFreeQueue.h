@@ -0,0 +1,86 @@
+/* A lock-free multi-producer, multi-consumer queue. Items live in a linked
+ * list of fixed size segments; producers claim a slot in the tail segment
+ * with an atomic increment and then CAS their item into it, while consumers
+ * claim a slot in the head segment the same way and swap a "taken" marker
+ * into it. If a consumer gets to a slot before its producer, the marker makes
+ * the producer's CAS fail and it just claims another slot. When the tail
+ * segment fills up, a new one is linked on; segments that consumers have
+ * finished with are freed at the next GC safepoint, so nobody can still be
+ * looking at them.
+ *
+ * Consumers that find the queue empty (and, for a bounded queue, producers
+ * that find it full) spin for a while and then park on a condition variable.
+ * Waking is only done when somebody is known to be parked, so the fast paths
+ * never touch a lock. */
+
+/* Number of item slots per segment. */
+#define MVM_CONC_LFQ_SEGMENT_SIZE 64
+
+/* How many times we spin waiting for an item (or space) before parking. */
+#define MVM_CONC_LFQ_SPIN_LIMIT 128
+
+/* A segment of the queue. */
+struct MVMConcLockFreeQueueSegment {
+    /* Index of the next slot to hand out to a producer and consumer. These
+     * keep on incrementing past the end of the segment when it is full. */
+    AO_t enq_idx;
+    AO_t deq_idx;
+
+    /* The next segment, if any. */
+    MVMConcLockFreeQueueSegment *next;
+
+    /* The item slots. Each is NULL, an object, or the taken marker. */
+    MVMObject *items[MVM_CONC_LFQ_SEGMENT_SIZE];
+};
+
+/* The shared state of the queue. This can't live in the object body directly,
+ * as it is accessed by threads that may be parked while the object moves. */
+struct MVMConcLockFreeQueueState {
+    /* Head and tail segments; consumers work at the head, producers at the
+     * tail. Kept apart so they don't share a cache line. */
+    MVMConcLockFreeQueueSegment *head;
+    char pad_head[64 - sizeof(void *)];
+    MVMConcLockFreeQueueSegment *tail;
+    char pad_tail[64 - sizeof(void *)];
+
+    /* Number of items in the queue, including any a producer is part way
+     * through adding. */
+    AO_t elems;
+
+    /* Number of slots reserved by producers; only used if bounded. */
+    AO_t reserved;
+
+    /* The capacity of the queue, or 0 if it is unbounded. */
+    MVMuint64 capacity;
+
+    /* Number of threads parked waiting for an item and for space. */
+    AO_t shift_waiters;
+    AO_t push_waiters;
+
+    /* Lock and condition variables used for parking. */
+    uv_mutex_t park_lock;
+    uv_cond_t  not_empty;
+    uv_cond_t  not_full;
+};
+
+/* Representation used for the lock-free concurrent queue. */
+struct MVMConcLockFreeQueueBody {
+    MVMConcLockFreeQueueState *state;
+};
+struct MVMConcLockFreeQueue {
+    MVMObject common;
+    MVMConcLockFreeQueueBody body;
+};
+
+/* REPR data specifies the capacity, if the queue is bounded. */
+struct MVMConcLockFreeQueueREPRData {
+    MVMuint64 capacity;
+};
+
+/* Function for REPR setup. */
+const MVMREPROps * MVMConcLockFreeQueue_initialize(MVMThreadContext *tc);
+
+/* Operations on lock-free concurrent queues. */
+MVMObject * MVM_conclockfreequeue_poll(MVMThreadContext *tc, MVMConcLockFreeQueue *queue);
+MVMint64 MVM_conclockfreequeue_drain(MVMThreadContext *tc, MVMConcLockFreeQueue *queue,
+    MVMObject *target, MVMint64 max);
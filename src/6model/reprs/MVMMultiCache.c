@@ -24,22 +24,21 @@ static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *d
 
 /* Called by the VM to mark any GCable items. */
 static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
-    MVMMultiCacheBody *mc = (MVMMultiCacheBody *)data;
-    size_t i;
-    for (i = 0; i < mc->num_results; i++)
-        MVM_gc_worklist_add(tc, worklist, &(mc->results[i]));
+    MVMMultiCacheBody    *mc      = (MVMMultiCacheBody *)data;
+    MVMMultiCacheVersion *version = mc->current;
+    if (version) {
+        MVMuint32 i;
+        for (i = 0; i < version->num_results; i++)
+            MVM_gc_worklist_add(tc, worklist, &(version->results[i]));
+    }
 }
 
 /* Called by the VM in order to free memory associated with this object. */
 static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
     MVMMultiCache *mc = (MVMMultiCache *)obj;
-    if (mc->body.node_hash_head)
-        MVM_fixed_size_free(tc, tc->instance->fsa, mc->body.cache_memory_size,
-            mc->body.node_hash_head);
-    if (mc->body.results)
-        MVM_fixed_size_free(tc, tc->instance->fsa,
-            mc->body.num_results * sizeof(MVMObject *),
-            mc->body.results);
+    if (mc->body.current)
+        MVM_fixed_size_free(tc, tc->instance->fsa, mc->body.current->alloc_size,
+            mc->body.current);
 }
 
 static const MVMStorageSpec storage_spec = {
@@ -64,7 +63,7 @@ static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
 /* Calculates the non-GC-managed memory we hold on to. */
 static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
     MVMMultiCacheBody *body = (MVMMultiCacheBody *)data;
-    return body->num_results * sizeof(MVMObject *) + body->cache_memory_size;
+    return body->current ? body->current->alloc_size : 0;
 }
 
 /* Initializes the representation. */
@@ -111,16 +110,15 @@ static const MVMREPROps this_repr = {
 /* Debug support dumps the tree after each addition. */
 #define MVM_MULTICACHE_DEBUG 0
 #if MVM_MULTICACHE_DEBUG
-static void dump_cache(MVMThreadContext *tc, MVMMultiCacheBody *cache) {
-    MVMint32 num_nodes = cache->cache_memory_size / sizeof(MVMMultiCacheNode);
-    MVMint32 i;
-    printf("Multi cache at %p (%d nodes, %d results)\n",
-        cache, num_nodes, cache->num_results);
-    for (i = 0; i < num_nodes; i++)
+static void dump_cache(MVMThreadContext *tc, MVMMultiCacheVersion *version) {
+    MVMuint32 i;
+    printf("Multi cache version at %p (%d nodes, %d results)\n",
+        version, version->num_nodes, version->num_results);
+    for (i = 0; i < version->num_nodes; i++)
         printf(" - %p -> (Y: %d, N: %d)\n",
-            cache->node_hash_head[i].action.cs,
-            cache->node_hash_head[i].match,
-            cache->node_hash_head[i].no_match);
+            version->nodes[i].action.cs,
+            version->nodes[i].match,
+            version->nodes[i].no_match);
     printf("\n");
 }
 #endif
@@ -142,93 +140,50 @@ MVM_STATIC_INLINE size_t hash_callsite(MVMThreadContext *tc, MVMCallsite *cs) {
     return ((size_t)cs >> 3) & MVM_MULTICACHE_HASH_FILTER;
 }
 
-/* Adds an entry to the multi-dispatch cache. */
-MVMObject * MVM_multi_cache_add(MVMThreadContext *tc, MVMObject *cache_obj, MVMObject *capture, MVMObject *result) {
-    MVMMultiCacheBody *cache;
-    MVMCallsite       *cs;
-    MVMArgProcContext *apc;
-    MVMuint64          match_flags[2 * MVM_INTERN_ARITY_LIMIT];
-    size_t             match_arg_idx[MVM_INTERN_ARITY_LIMIT];
-    MVMuint32          flag, i, num_obj_args, have_head, have_tree,
-                       have_callsite, matched_args, unmatched_arg,
-                       tweak_node, insert_node;
-    size_t             new_size;
-    MVMMultiCacheNode *new_head;
-    MVMObject        **new_results;
-    int                unlock_necessary = 0;
-
-    /* Allocate a cache if needed. */
-    if (MVM_is_null(tc, cache_obj) || !IS_CONCRETE(cache_obj) || REPR(cache_obj)->ID != MVM_REPR_ID_MVMMultiCache) {
-        MVMROOT(tc, capture, {
-        MVMROOT(tc, result, {
-            cache_obj = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTMultiCache);
-        });
-        });
-    }
-    cache = &((MVMMultiCache *)cache_obj)->body;
-
-    /* Ensure we got a capture in to cache on; bail if not interned. */
-    if (REPR(capture)->ID == MVM_REPR_ID_MVMCallCapture) {
-        cs         = ((MVMCallCapture *)capture)->body.effective_callsite;
-        apc        = ((MVMCallCapture *)capture)->body.apc;
-        if (!cs->is_interned)
-            return cache_obj;
-    }
-    else {
-        MVM_exception_throw_adhoc(tc, "Multi cache addition requires an MVMCallCapture");
-    }
-
-    /* Calculate matcher flags for all the object arguments. */
-    num_obj_args = 0;
-    for (i = 0, flag = 0; flag < cs->flag_count; i++, flag++) {
-        if (cs->arg_flags[flag] & MVM_CALLSITE_ARG_NAMED)
-            i++;
-        if ((cs->arg_flags[flag] & MVM_CALLSITE_ARG_MASK) == MVM_CALLSITE_ARG_OBJ) {
-            MVMRegister  arg   = apc->args[i];
-            MVMSTable   *st    = STABLE(arg.o);
-            MVMuint32    is_rw = 0;
-            if (st->container_spec && IS_CONCRETE(arg.o)) {
-                MVMContainerSpec const *contspec = st->container_spec;
-                if (!contspec->fetch_never_invokes)
-                    goto DONE; /* Impossible to cache. */
-                if (REPR(arg.o)->ID != MVM_REPR_ID_NativeRef) {
-                    is_rw = contspec->can_store(tc, arg.o);
-                    contspec->fetch(tc, arg.o, &arg);
-                }
-                else {
-                    is_rw = 1;
-                }
-            }
-            match_flags[i] = STABLE(arg.o)->type_cache_id |
-                (is_rw ? MVM_MULTICACHE_ARG_RW_FILTER : 0) |
-                (IS_CONCRETE(arg.o) ? MVM_MULTICACHE_ARG_CONC_FILTER : 0);
-            match_arg_idx[num_obj_args] = i;
-            num_obj_args++;
-        }
-    }
+/* Gets the current version of a cache. Readers must load it exactly once per
+ * lookup and then work only with that version. */
+MVM_STATIC_INLINE MVMMultiCacheVersion * current_version(MVMMultiCacheBody *cache) {
+    return (MVMMultiCacheVersion *)MVM_load(&(cache->current));
+}
 
-    /* If we're in a multi-threaded context, obtain the cache additions
-     * lock, and then do another lookup to ensure nobody beat us to
-     * making this entry. */
-    if (MVM_instance_have_user_threads(tc)) {
-        uv_mutex_lock(&(tc->instance->mutex_multi_cache_add));
-        unlock_necessary = 1;
-        if (MVM_multi_cache_find(tc, cache_obj, capture))
-            goto DONE;
-    }
+/* Allocates a cache version with space for the specified number of nodes and
+ * results, and sets up the array pointers into it. */
+#define VERSION_HEADER_SIZE ((sizeof(MVMMultiCacheVersion) + 7) & ~(size_t)7)
+static MVMMultiCacheVersion * allocate_version(MVMThreadContext *tc, MVMuint32 num_nodes,
+        MVMuint32 num_results) {
+    size_t alloc_size = VERSION_HEADER_SIZE +
+        num_nodes * sizeof(MVMMultiCacheNode) +
+        num_results * sizeof(MVMObject *);
+    MVMMultiCacheVersion *version = MVM_fixed_size_alloc(tc, tc->instance->fsa, alloc_size);
+    version->nodes       = (MVMMultiCacheNode *)((char *)version + VERSION_HEADER_SIZE);
+    version->results     = (MVMObject **)(version->nodes + num_nodes);
+    version->num_nodes   = num_nodes;
+    version->num_results = num_results;
+    version->alloc_size  = alloc_size;
+    return version;
+}
 
-    /* We're now udner the insertion lock and know nobody else can tweak the
-     * cache. First, see if there's even a current version and search tree. */
-    have_head = 0;
+/* Produces a new version of the cache, based on the passed current version
+ * (which may be NULL), that also has an entry mapping the callsite and the
+ * argument matchers to the result. Returns NULL if the current version
+ * already has such an entry. The current version is not modified. */
+static MVMMultiCacheVersion * make_version_with(MVMThreadContext *tc, MVMObject *cache_obj,
+        MVMMultiCacheVersion *cur, MVMCallsite *cs, MVMuint64 *match_flags,
+        size_t *match_arg_idx, MVMuint32 num_obj_args, MVMObject *result) {
+    MVMuint32             i, have_tree, have_callsite, matched_args, unmatched_arg,
+                          tweak_node, insert_node, new_num_nodes;
+    MVMMultiCacheVersion *new_version;
+    MVMMultiCacheNode    *new_nodes;
+
+    /* First, see if there's even a current version and search tree. */
     have_tree = 0;
     have_callsite = 0;
     matched_args = 0;
     unmatched_arg = 0;
     tweak_node = hash_callsite(tc, cs);
-    if (cache->node_hash_head) {
-        MVMMultiCacheNode *tree = cache->node_hash_head;
+    if (cur) {
+        MVMMultiCacheNode *tree = cur->nodes;
         MVMint32 cur_node = tweak_node;
-        have_head = 1;
         if (tree[cur_node].action.cs)
             have_tree = 1;
 
@@ -259,44 +214,47 @@ MVMObject * MVM_multi_cache_add(MVMThreadContext *tc, MVMObject *cache_obj, MVMO
             }
         }
 
-        /* If we found a candidate, something inconsistent, as we
-         * checked for non-entry above. */
+        /* If we reached a result, somebody else already added this entry. */
         if (cur_node != 0)
-            MVM_panic(1, "Corrupt multi dispatch cache: cur_node == 0");
+            return NULL;
     }
 
-    /* Now calculate the new size we'll need to allocate. */
-    new_size = cache->cache_memory_size;
-    if (!have_head)
-        new_size += MVM_MULTICACHE_HASH_SIZE * sizeof(MVMMultiCacheNode);
-    else if (!have_callsite)
-        new_size += sizeof(MVMMultiCacheNode);
-    new_size += (num_obj_args - matched_args) * sizeof(MVMMultiCacheNode);
-
-    /* Allocate and copy existing cache. */
-    new_head = MVM_fixed_size_alloc(tc, tc->instance->fsa, new_size);
-    memcpy(new_head, cache->node_hash_head, cache->cache_memory_size);
-
-    /* If we had no head, set it up. */
-    if (!have_head)
-        memset(new_head, 0, MVM_MULTICACHE_HASH_SIZE * sizeof(MVMMultiCacheNode));
+    /* Now calculate the number of nodes we'll need. */
+    new_num_nodes = cur ? cur->num_nodes : MVM_MULTICACHE_HASH_SIZE;
+    if (cur && !have_callsite && have_tree)
+        new_num_nodes++;
+    new_num_nodes += num_obj_args - matched_args;
+
+    /* Allocate the new version and copy the existing nodes and results into
+     * it; the results are append only, with the first one always NULL to
+     * save flow control around "no match". */
+    new_version = allocate_version(tc, new_num_nodes, cur ? cur->num_results + 1 : 2);
+    new_nodes = new_version->nodes;
+    if (cur) {
+        memcpy(new_nodes, cur->nodes, cur->num_nodes * sizeof(MVMMultiCacheNode));
+        memcpy(new_version->results, cur->results, cur->num_results * sizeof(MVMObject *));
+    }
+    else {
+        memset(new_nodes, 0, MVM_MULTICACHE_HASH_SIZE * sizeof(MVMMultiCacheNode));
+        new_version->results[0] = NULL;
+    }
+    MVM_ASSIGN_REF(tc, &(cache_obj->header),
+        new_version->results[new_version->num_results - 1], result);
 
     /* Calculate storage location of new nodes. */
-    insert_node = have_head
-        ? cache->cache_memory_size / sizeof(MVMMultiCacheNode)
-        : MVM_MULTICACHE_HASH_SIZE;
+    insert_node = cur ? cur->num_nodes : MVM_MULTICACHE_HASH_SIZE;
 
     /* If we had no callsite, add a node for it. */
     if (!have_callsite) {
         if (!have_tree) {
             /* We'll put it in the tree root. */
-            new_head[tweak_node].action.cs = cs;
+            new_nodes[tweak_node].action.cs = cs;
         }
         else {
             /* We'll insert a new node and chain it from the tweak node. */
-            new_head[insert_node].action.cs = cs;
-            new_head[insert_node].no_match = 0;
-            new_head[tweak_node].no_match = insert_node;
+            new_nodes[insert_node].action.cs = cs;
+            new_nodes[insert_node].no_match = 0;
+            new_nodes[tweak_node].no_match = insert_node;
             tweak_node = insert_node;
             insert_node++;
         }
@@ -305,68 +263,116 @@ MVMObject * MVM_multi_cache_add(MVMThreadContext *tc, MVMObject *cache_obj, MVMO
     /* Now insert any needed arg matchers. */
     for (i = matched_args; i < num_obj_args; i++) {
         MVMuint32 arg_idx = match_arg_idx[i];
-        new_head[insert_node].action.arg_match = match_flags[arg_idx] | arg_idx;
-        new_head[insert_node].no_match = 0;
+        new_nodes[insert_node].action.arg_match = match_flags[arg_idx] | arg_idx;
+        new_nodes[insert_node].no_match = 0;
         if (unmatched_arg) {
-            new_head[tweak_node].no_match = insert_node;
+            new_nodes[tweak_node].no_match = insert_node;
             unmatched_arg = 0;
         }
         else {
-            new_head[tweak_node].match = insert_node;
+            new_nodes[tweak_node].match = insert_node;
         }
         tweak_node = insert_node;
         insert_node++;
     }
 
-    /* Make a copy of the results, or allocate new (first result is NULL
-     * always) and insert the new result. Schedule old results for freeing. */
-    if (cache->num_results) {
-        new_results = MVM_fixed_size_alloc(tc, tc->instance->fsa,
-            (cache->num_results + 1) * sizeof(MVMObject *));
-        memcpy(new_results, cache->results, cache->num_results * sizeof(MVMObject *));
-        MVM_ASSIGN_REF(tc, &(cache_obj->header), new_results[cache->num_results], result);
-        MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
-            cache->num_results * sizeof(MVMObject *), cache->results);
-        cache->results = new_results;
-        cache->num_results++;
+    /* Associate final node with result index. */
+    new_nodes[tweak_node].match = -(MVMint32)(new_version->num_results - 1);
+
+    return new_version;
+}
+
+/* Adds an entry to the multi-dispatch cache. */
+MVMObject * MVM_multi_cache_add(MVMThreadContext *tc, MVMObject *cache_obj, MVMObject *capture, MVMObject *result) {
+    MVMMultiCacheBody    *cache;
+    MVMCallsite          *cs;
+    MVMArgProcContext    *apc;
+    MVMuint64             match_flags[2 * MVM_INTERN_ARITY_LIMIT];
+    size_t                match_arg_idx[MVM_INTERN_ARITY_LIMIT];
+    MVMuint32             flag, i, num_obj_args;
+    MVMMultiCacheVersion *cur, *new_version;
+
+    /* Allocate a cache if needed. */
+    if (MVM_is_null(tc, cache_obj) || !IS_CONCRETE(cache_obj) || REPR(cache_obj)->ID != MVM_REPR_ID_MVMMultiCache) {
+        MVMROOT(tc, capture, {
+        MVMROOT(tc, result, {
+            cache_obj = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTMultiCache);
+        });
+        });
+    }
+
+    /* Ensure we got a capture in to cache on; bail if not interned. */
+    if (REPR(capture)->ID == MVM_REPR_ID_MVMCallCapture) {
+        cs         = ((MVMCallCapture *)capture)->body.effective_callsite;
+        apc        = ((MVMCallCapture *)capture)->body.apc;
+        if (!cs->is_interned)
+            return cache_obj;
     }
     else {
-        new_results = MVM_fixed_size_alloc(tc, tc->instance->fsa,
-            2 * sizeof(MVMObject *));
-        new_results[0] = NULL; /* Sentinel */
-        MVM_ASSIGN_REF(tc, &(cache_obj->header), new_results[1], result);
-        cache->results = new_results;
-        cache->num_results = 2;
+        MVM_exception_throw_adhoc(tc, "Multi cache addition requires an MVMCallCapture");
     }
-    MVM_barrier();
-
-    /* Associate final node with result index. */
-    new_head[tweak_node].match = -(cache->num_results - 1);
 
-    /* Update the rest. */
-    if (cache->node_hash_head)
-        MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
-            cache->cache_memory_size, cache->node_hash_head);
-    cache->node_hash_head = new_head;
-    cache->cache_memory_size = new_size;
+    /* Calculate matcher flags for all the object arguments. */
+    num_obj_args = 0;
+    for (i = 0, flag = 0; flag < cs->flag_count; i++, flag++) {
+        if (cs->arg_flags[flag] & MVM_CALLSITE_ARG_NAMED)
+            i++;
+        if ((cs->arg_flags[flag] & MVM_CALLSITE_ARG_MASK) == MVM_CALLSITE_ARG_OBJ) {
+            MVMRegister  arg   = apc->args[i];
+            MVMSTable   *st    = STABLE(arg.o);
+            MVMuint32    is_rw = 0;
+            if (st->container_spec && IS_CONCRETE(arg.o)) {
+                MVMContainerSpec const *contspec = st->container_spec;
+                if (!contspec->fetch_never_invokes)
+                    return cache_obj; /* Impossible to cache. */
+                if (REPR(arg.o)->ID != MVM_REPR_ID_NativeRef) {
+                    is_rw = contspec->can_store(tc, arg.o);
+                    contspec->fetch(tc, arg.o, &arg);
+                }
+                else {
+                    is_rw = 1;
+                }
+            }
+            match_flags[i] = STABLE(arg.o)->type_cache_id |
+                (is_rw ? MVM_MULTICACHE_ARG_RW_FILTER : 0) |
+                (IS_CONCRETE(arg.o) ? MVM_MULTICACHE_ARG_CONC_FILTER : 0);
+            match_arg_idx[num_obj_args] = i;
+            num_obj_args++;
+        }
+    }
 
+    /* Build a new version from the current one and try to install it. If
+     * another thread replaced the current version in the meantime, throw
+     * ours away and try again against theirs; it may well already have the
+     * entry we wanted, in which case we're done. Nothing in here can trigger
+     * GC, so the cache object will not move under us. */
+    cache = &((MVMMultiCache *)cache_obj)->body;
+    while (1) {
+        cur = current_version(cache);
+        new_version = make_version_with(tc, cache_obj, cur, cs, match_flags,
+            match_arg_idx, num_obj_args, result);
+        if (!new_version)
+            break;
+        if (MVM_casptr(&(cache->current), cur, new_version) == cur) {
+            if (cur)
+                MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
+                    cur->alloc_size, cur);
 #if MVM_MULTICACHE_DEBUG
-    printf("Made new entry for callsite with %d object arguments\n", num_obj_args);
-    dump_cache(tc, cache);
+            printf("Made new entry for callsite with %d object arguments\n", num_obj_args);
+            dump_cache(tc, new_version);
 #endif
 #if MVM_MULTICACHE_BIG_PROFILE
-    if (cache->num_results >= 32 && is_power_of_2(cache->num_results)) {
-        MVMCode *code = (MVMCode *)MVM_frame_find_invokee(tc, result, NULL);
-        char *name = MVM_string_utf8_encode_C_string(tc, code->body.sf->body.name);
-        printf("Multi cache for %s reached %d entries\n", name, cache->num_results);
-        MVM_free(name);
-    }
+            if (new_version->num_results >= 32 && is_power_of_2(new_version->num_results)) {
+                MVMCode *code = (MVMCode *)MVM_frame_find_invokee(tc, result, NULL);
+                char *name = MVM_string_utf8_encode_C_string(tc, code->body.sf->body.name);
+                printf("Multi cache for %s reached %d entries\n", name, new_version->num_results);
+                MVM_free(name);
+            }
 #endif
-
-    /* Release lock if needed. */
-  DONE:
-    if (unlock_necessary)
-        uv_mutex_unlock(&(tc->instance->mutex_multi_cache_add));
+            break;
+        }
+        MVM_fixed_size_free(tc, tc->instance->fsa, new_version->alloc_size, new_version);
+    }
 
     /* Hand back the created/updated cache. */
     return cache_obj;
@@ -387,9 +393,9 @@ MVMObject * MVM_multi_cache_find(MVMThreadContext *tc, MVMObject *cache_obj, MVM
 /* Does a lookup in the multi-dispatch cache using a callsite and args. */
 MVMObject * MVM_multi_cache_find_callsite_args(MVMThreadContext *tc, MVMObject *cache_obj,
     MVMCallsite *cs, MVMRegister *args) {
-    MVMMultiCacheBody *cache;
-    MVMMultiCacheNode *tree;
-    MVMint32 cur_node;
+    MVMMultiCacheVersion *version;
+    MVMMultiCacheNode    *tree;
+    MVMint32              cur_node;
 
     /* Bail if callsite not interned. */
     if (!cs->is_interned)
@@ -398,15 +404,15 @@ MVMObject * MVM_multi_cache_find_callsite_args(MVMThreadContext *tc, MVMObject *
     /* If no cache, no result. */
     if (MVM_is_null(tc, cache_obj) || !IS_CONCRETE(cache_obj) || REPR(cache_obj)->ID != MVM_REPR_ID_MVMMultiCache)
         return NULL;
-    cache = &((MVMMultiCache *)cache_obj)->body;
-    if (!cache->node_hash_head)
+    version = current_version(&((MVMMultiCache *)cache_obj)->body);
+    if (!version)
         return NULL;
 
     /* Use hashed callsite to find the node to start with. */
     cur_node = hash_callsite(tc, cs);
 
     /* Walk tree until we match callsite. */
-    tree = cache->node_hash_head;
+    tree = version->nodes;
     do {
         if (tree[cur_node].action.cs == cs) {
             cur_node = tree[cur_node].match;
@@ -450,14 +456,14 @@ MVMObject * MVM_multi_cache_find_callsite_args(MVMThreadContext *tc, MVMObject *
 
     /* Negate result and index into results (the first result is always NULL
      * to save flow control around "no match"). */
-    return cache->results[-cur_node];
+    return version->results[-cur_node];
 }
 
 /* Do a multi cache lookup based upon spesh arg facts. */
 MVMObject * MVM_multi_cache_find_spesh(MVMThreadContext *tc, MVMObject *cache_obj, MVMSpeshCallInfo *arg_info) {
-    MVMMultiCacheBody *cache;
-    MVMMultiCacheNode *tree;
-    MVMint32 cur_node;
+    MVMMultiCacheVersion *version;
+    MVMMultiCacheNode    *tree;
+    MVMint32              cur_node;
 
     /* Bail if callsite not interned. */
     if (!arg_info->cs->is_interned)
@@ -466,15 +472,15 @@ MVMObject * MVM_multi_cache_find_spesh(MVMThreadContext *tc, MVMObject *cache_ob
     /* If no cache, no result. */
     if (MVM_is_null(tc, cache_obj) || !IS_CONCRETE(cache_obj) || REPR(cache_obj)->ID != MVM_REPR_ID_MVMMultiCache)
         return NULL;
-    cache = &((MVMMultiCache *)cache_obj)->body;
-    if (!cache->node_hash_head)
+    version = current_version(&((MVMMultiCache *)cache_obj)->body);
+    if (!version)
         return NULL;
 
     /* Use hashed callsite to find the node to start with. */
     cur_node = hash_callsite(tc, arg_info->cs);
 
     /* Walk tree until we match callsite. */
-    tree = cache->node_hash_head;
+    tree = version->nodes;
     do {
         if (tree[cur_node].action.cs == arg_info->cs) {
             cur_node = tree[cur_node].match;
@@ -543,5 +549,5 @@ MVMObject * MVM_multi_cache_find_spesh(MVMThreadContext *tc, MVMObject *cache_ob
 
     /* Negate result and index into results (the first result is always NULL
      * to save flow control around "no match"). */
-    return cache->results[-cur_node];
+    return version->results[-cur_node];
 }
@@ -26,9 +26,15 @@
  * block of memory is also aimed at getting good CPU cache hit rates.
  *
  * The tree array is immutable, and so can safely be read by many threads, and
- * kept in thier CPU caches. Upon a new entry, the cache will be copied, and the
- * tweaks made. The cache head pointer will then be set to the new cache, and the
- * old cache memory scheduled for freeeing at the next safepoint.
+ * kept in thier CPU caches. Each cache holds a pointer to its current version,
+ * which bundles the tree together with the results it refers to, so that a
+ * reader only has to load a single pointer to get a consistent view. Upon a
+ * new entry, the writer copies the current version, makes its tweaks, and then
+ * tries to CAS the head pointer over to the new version. If another thread got
+ * there first, the new version is discarded and the addition retried against
+ * the winner's version (which may already contain the entry). There is no
+ * lock; the replaced version is freed at the next safepoint, by which time no
+ * reader can still be looking at it.
  */
 
 /* A node in the cache. */
@@ -41,28 +47,31 @@ struct MVMMultiCacheNode {
     MVMint32 no_match;
 };
 
-/* Body of a multi-dispatch cache. */
-struct MVMMultiCacheBody {
-    /* Pointer to the an array of nodes, which we can initially index
-     * into using a hahsed calsite. Replaced in whole whenever there is
-     * a change. */
-    MVMMultiCacheNode *node_hash_head;
+/* A version of the cache. The nodes and results arrays live in the same
+ * memory block as this header, immediately following it. */
+struct MVMMultiCacheVersion {
+    /* Array of nodes, which we can initially index into using a hashed
+     * callsite. */
+    MVMMultiCacheNode *nodes;
 
-    /* Array of results we may return from the cache. Note that this is
-     * replaced entirely whenever we update the cache. It is append only,
-     * and so will be valid for older versions of the cache too. We must
-     * replace this and do a memory barrier before replacing node_hash_head
-     * with its new version on update. Conversely, readers must read the
-     * node_hash_head and *then* read results here, so it will always have
-     * been udpated in time. */
+    /* Array of results we may return from the cache. The first entry is
+     * always NULL. */
     MVMObject **results;
 
-    /* The number of results, so we can GC mark and free. */
-    size_t num_results;
+    /* The number of nodes and results. */
+    MVMuint32 num_nodes;
+    MVMuint32 num_results;
 
-    /* The amount of memory the cache uses. Used for freeing with the fixed
+    /* The amount of memory the version uses, for freeing it with the fixed
      * size allocator. */
-    size_t cache_memory_size;
+    size_t alloc_size;
+};
+
+/* Body of a multi-dispatch cache. */
+struct MVMMultiCacheBody {
+    /* The current version of the cache, or NULL if nothing was added yet.
+     * Replaced in whole, using CAS, whenever there is a change. */
+    MVMMultiCacheVersion *current;
 };
 
 /* Hash table size. Must be a power of 2. */
@@ -113,6 +113,22 @@ static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *d
     dest_body->fully_deserialized    = 1;
 }
 
+/* Adds the objects a specialization holds to the GC worklist. */
+static void mark_candidate(MVMThreadContext *tc, MVMSpeshCandidate *cand, MVMGCWorklist *worklist) {
+    MVMint32 j;
+    for (j = 0; j < cand->num_guards; j++)
+        MVM_gc_worklist_add(tc, worklist, &cand->guards[j].match);
+    for (j = 0; j < cand->num_spesh_slots; j++)
+        MVM_gc_worklist_add(tc, worklist, &cand->spesh_slots[j]);
+    if (cand->log_slots)
+        for (j = 0; j < cand->num_log_slots * MVM_SPESH_LOG_RUNS; j++)
+            MVM_gc_worklist_add(tc, worklist, &cand->log_slots[j]);
+    for (j = 0; j < cand->num_inlines; j++)
+        MVM_gc_worklist_add(tc, worklist, &cand->inlines[j].code);
+    if (cand->sg)
+        MVM_spesh_graph_mark(tc, cand->sg, worklist);
+}
+
 /* Adds held objects to the GC worklist. */
 static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorklist *worklist) {
     MVMStaticFrameBody *body = (MVMStaticFrameBody *)data;
@@ -146,22 +162,15 @@ static void gc_mark(MVMThreadContext *tc, MVMSTable *st, void *data, MVMGCWorkli
                 MVM_gc_worklist_add(tc, worklist, &body->static_env[i].o);
     }
 
-    /* Spesh slots. */
+    /* Spesh slots, including those of candidates that were replaced, which
+     * frames may still be running. */
     if (body->num_spesh_candidates) {
-        MVMint32 i, j;
-        for (i = 0; i < body->num_spesh_candidates; i++) {
-            for (j = 0; j < body->spesh_candidates[i].num_guards; j++)
-                MVM_gc_worklist_add(tc, worklist, &body->spesh_candidates[i].guards[j].match);
-            for (j = 0; j < body->spesh_candidates[i].num_spesh_slots; j++)
-                MVM_gc_worklist_add(tc, worklist, &body->spesh_candidates[i].spesh_slots[j]);
-            if (body->spesh_candidates[i].log_slots)
-                for (j = 0; j < body->spesh_candidates[i].num_log_slots * MVM_SPESH_LOG_RUNS; j++)
-                    MVM_gc_worklist_add(tc, worklist, &body->spesh_candidates[i].log_slots[j]);
-            for (j = 0; j < body->spesh_candidates[i].num_inlines; j++)
-                MVM_gc_worklist_add(tc, worklist, &body->spesh_candidates[i].inlines[j].code);
-            if (body->spesh_candidates[i].sg)
-                MVM_spesh_graph_mark(tc, body->spesh_candidates[i].sg, worklist);
-        }
+        MVMSpeshCandidate *cand;
+        MVMuint32 i;
+        for (i = 0; i < body->num_spesh_candidates; i++)
+            mark_candidate(tc, MVM_spesh_candidate_at(body, i), worklist);
+        for (cand = body->replaced_spesh_candidates; cand; cand = cand->next_replaced)
+            mark_candidate(tc, cand, worklist);
     }
 }
 
@@ -188,9 +197,7 @@ static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
     MVM_free(body->lexical_names_list);
     MVM_HASH_DESTROY(hash_handle, MVMLexicalRegistry, body->lexical_names);
 
-    for (i = 0; i < body->num_spesh_candidates; i++)
-        MVM_spesh_candidate_destroy(tc, &body->spesh_candidates[i]);
-    MVM_free(body->spesh_candidates);
+    MVM_spesh_candidate_destroy_all(tc, body);
 }
 
 static const MVMStorageSpec storage_spec = {
@@ -243,7 +250,7 @@ static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data)
         size += body->num_lexicals; /* static_env_flags */
 
         for (spesh_idx = 0; spesh_idx < body->num_spesh_candidates; spesh_idx++) {
-            MVMSpeshCandidate *cand = &body->spesh_candidates[spesh_idx];
+            MVMSpeshCandidate *cand = MVM_spesh_candidate_at(body, spesh_idx);
             size += sizeof(MVMSpeshGuard) * cand->num_guards;
 
             size += cand->bytecode_size;
@@ -337,26 +344,27 @@ static void describe_refs(MVMThreadContext *tc, MVMHeapSnapshotState *ss, MVMSTa
     if (body->num_spesh_candidates) {
         MVMint32 i, j;
         for (i = 0; i < body->num_spesh_candidates; i++) {
-            for (j = 0; j < body->spesh_candidates[i].num_guards; j++)
+            MVMSpeshCandidate *cand = MVM_spesh_candidate_at(body, i);
+            for (j = 0; j < cand->num_guards; j++)
                 MVM_profile_heap_add_collectable_rel_const_cstr(tc, ss,
-                    (MVMCollectable *)body->spesh_candidates[i].guards[j].match,
+                    (MVMCollectable *)cand->guards[j].match,
                     "Spesh guard match");
-            for (j = 0; j < body->spesh_candidates[i].num_spesh_slots; j++)
+            for (j = 0; j < cand->num_spesh_slots; j++)
                 MVM_profile_heap_add_collectable_rel_const_cstr(tc, ss,
-                    (MVMCollectable *)body->spesh_candidates[i].spesh_slots[j],
+                    (MVMCollectable *)cand->spesh_slots[j],
                     "Spesh slot entry");
-            if (body->spesh_candidates[i].log_slots)
-                for (j = 0; j < body->spesh_candidates[i].num_log_slots * MVM_SPESH_LOG_RUNS; j++)
+            if (cand->log_slots)
+                for (j = 0; j < cand->num_log_slots * MVM_SPESH_LOG_RUNS; j++)
                 MVM_profile_heap_add_collectable_rel_const_cstr(tc, ss,
-                    (MVMCollectable *)body->spesh_candidates[i].log_slots[j],
+                    (MVMCollectable *)cand->log_slots[j],
                     "Spesh log slots");
-            for (j = 0; j < body->spesh_candidates[i].num_inlines; j++)
+            for (j = 0; j < cand->num_inlines; j++)
                 MVM_profile_heap_add_collectable_rel_const_cstr(tc, ss,
-                    (MVMCollectable *)body->spesh_candidates[i].inlines[j].code,
+                    (MVMCollectable *)cand->inlines[j].code,
                     "Spesh inlined code object");
-            if (body->spesh_candidates[i].sg) {
+            if (cand->sg) {
                 MVMCollectable **c_ptr;
-                MVM_spesh_graph_mark(tc, body->spesh_candidates[i].sg, ss->gcwl);
+                MVM_spesh_graph_mark(tc, cand->sg, ss->gcwl);
                 while (c_ptr = MVM_gc_worklist_get(tc, ss->gcwl)) {
                     MVMCollectable *c = *c_ptr;
                     MVM_profile_heap_add_collectable_rel_const_cstr(tc, ss, c,
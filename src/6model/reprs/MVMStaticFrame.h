@@ -1,5 +1,8 @@
 /* Representation for static code in the VM. Partially populated on first
  * call or usage. */
+/* Number of chains in a static frame's index of specializations. */
+#define MVM_SPESH_DISPATCH_BUCKETS 16
+
 struct MVMStaticFrameBody {
     /* The start of the stream of bytecode for this routine. */
     MVMuint8 *bytecode;
@@ -39,9 +42,28 @@ struct MVMStaticFrameBody {
     /* Number of times we should invoke before spesh applies. */
     MVMuint32 spesh_threshold;
 
-    /* Specializations array, if there are any. */
-    MVMSpeshCandidate *spesh_candidates;
-    MVMuint32          num_spesh_candidates;
+    /* Specializations, if there are any; an array of MVM_SPESH_MAX_CANDIDATES
+     * slots, of which the first num_spesh_candidates are used. Also the
+     * number of candidates that have been retired, which still count towards
+     * num_spesh_candidates until their slot is reused, and the index of the
+     * candidate matched most recently, tried first on dispatch. */
+    MVMSpeshCandidate **spesh_candidates;
+    MVMuint32           num_spesh_candidates;
+    MVMuint32           num_retired_spesh_candidates;
+    MVMuint32           last_spesh_candidate;
+
+    /* Heads of the chains of live candidates, hashed on callsite and the
+     * type of the first argument; see MVM_spesh_candidate_find. Each holds
+     * a candidate index plus one, or zero for an empty chain. */
+    MVMuint8 spesh_dispatch[MVM_SPESH_DISPATCH_BUCKETS];
+
+    /* Candidates that were replaced when their slot was reused, and the
+     * number of dispatch misses since we last looked for one to retire. */
+    MVMSpeshCandidate *replaced_spesh_candidates;
+    MVMuint32          spesh_dispatch_misses;
+
+    /* ID of the frame in the spesh event log; zero if not given one yet. */
+    MVMuint32 spesh_event_id;
 
     /* The size in bytes to allocate for the lexical environment. */
     MVMuint32 env_size;
@@ -38,6 +38,8 @@ static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *d
         memcpy(dest_body->arg_types, src_body->arg_types, src_body->num_args * sizeof(MVMint16));
     }
     dest_body->ret_type = src_body->ret_type;
+    if (src_body->jit_stub)
+        dest_body->jit_stub = MVM_jit_compile_nativecall_stub(tc, dest_body);
 }
 
 
@@ -88,6 +90,8 @@ static void gc_cleanup(MVMThreadContext *tc, MVMSTable *st, void *data) {
         MVM_free(body->arg_types);
     if (body->arg_info)
         MVM_free(body->arg_info);
+    if (body->jit_stub)
+        MVM_jit_destroy_nativecall_stub(tc, body->jit_stub);
 }
 
 static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
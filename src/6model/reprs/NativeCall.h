@@ -15,6 +15,10 @@ struct MVMNativeCallBody {
     MVMint16    ret_type;
     MVMint16   *arg_types;
     MVMObject **arg_info;
+
+    /* JIT-compiled stub that calls entry_point directly, if the signature
+     * allows for one and the JIT is available. */
+    MVMJitNativeCallStub *jit_stub;
 };
 
 struct MVMNativeCall {
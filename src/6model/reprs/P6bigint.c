@@ -183,12 +183,8 @@ static void serialize(MVMThreadContext *tc, MVMSTable *st, void *data, MVMSerial
         int len;
         char *buf;
         MVMString *str;
-        mp_radix_size(i, 10, &len);
-        buf = (char *)MVM_malloc(len);
-        mp_toradix(i, buf, 10);
-
-        /* len - 1 because buf is \0-terminated */
-        str = MVM_string_ascii_decode(tc, tc->instance->VMString, buf, len - 1);
+        buf = MVM_bigint_mp_to_radix(i, 10, &len);
+        str = MVM_string_ascii_decode(tc, tc->instance->VMString, buf, len);
 
         /* write the "is small" flag */
         MVM_serialization_write_int(tc, writer, 0);
@@ -218,7 +214,7 @@ static void deserialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, vo
         char *buf = MVM_string_ascii_encode(tc, MVM_serialization_read_str(tc, reader), NULL, 0);
         body->u.bigint = MVM_malloc(sizeof(mp_int));
         mp_init(body->u.bigint);
-        mp_read_radix(body->u.bigint, buf, 10);
+        MVM_bigint_mp_read_radix(body->u.bigint, buf, 10);
         MVM_free(buf);
     }
 }
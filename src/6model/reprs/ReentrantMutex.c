@@ -122,14 +122,38 @@ void MVM_reentrantmutex_lock(MVMThreadContext *tc, MVMReentrantMutex *rm) {
         MVM_incr(&rm->body.lock_count);
     }
     else {
-        /* Not holding the lock; obtain it. */
-        MVMROOT(tc, rm, {
-            MVM_gc_mark_thread_blocked(tc);
-            uv_mutex_lock(rm->body.mutex);
-            MVM_gc_mark_thread_unblocked(tc);
-        });
+        /* Not holding the lock; obtain it. Critical sections are usually
+         * short, so if it's taken we spin a while (waiting for it to look
+         * free before trying again, to avoid hammering the cache line), and
+         * only mark ourselves blocked and park if that doesn't work out.
+         * The mutex itself isn't moved by GC, so it's fine to hold on to. */
+        uv_mutex_t *mutex = rm->body.mutex;
+        if (uv_mutex_trylock(mutex) != 0) {
+            MVMuint32 max_spins = MVM_LOCK_SPIN_LIMIT(&rm->body.contention);
+            MVMuint32 spins     = 0;
+            MVMuint32 acquired  = 0;
+            MVM_incr(&rm->body.contention.contended);
+            MVMROOT(tc, rm, {
+                while (spins < max_spins) {
+                    spins++;
+                    GC_SYNC_POINT(tc);
+                    if (MVM_load(&rm->body.holder_id) == 0 && uv_mutex_trylock(mutex) == 0) {
+                        acquired = 1;
+                        break;
+                    }
+                }
+                if (!acquired) {
+                    MVM_incr(&rm->body.contention.parked);
+                    MVM_gc_mark_thread_blocked(tc);
+                    uv_mutex_lock(mutex);
+                    MVM_gc_mark_thread_unblocked(tc);
+                }
+            });
+            MVM_LOCK_SPIN_ADAPT(&rm->body.contention, spins);
+        }
         MVM_store(&rm->body.holder_id, tc->thread_id);
         MVM_store(&rm->body.lock_count, 1);
+        rm->body.contention.acquires++;
         tc->num_locks++;
     }
 }
@@ -149,3 +173,40 @@ void MVM_reentrantmutex_unlock(MVMThreadContext *tc, MVMReentrantMutex *rm) {
         MVM_exception_throw_adhoc(tc, "Attempt to unlock mutex by thread not holding it");
     }
 }
+
+/* Adds an integer statistic to a hash. */
+static void add_stat(MVMThreadContext *tc, MVMObject *hash, const char *name, MVMint64 value) {
+    MVMObject *boxed;
+    MVMROOT(tc, hash, {
+        boxed = MVM_repr_box_int(tc, tc->instance->boot_types.BOOTInt, value);
+        MVMROOT(tc, boxed, {
+            MVMString *key = MVM_string_ascii_decode_nt(tc, tc->instance->VMString, name);
+            MVM_repr_bind_key_o(tc, hash, key, boxed);
+        });
+    });
+}
+
+/* Gets a hash of contention statistics for a ReentrantMutex or Semaphore. */
+MVMObject * MVM_lock_contention_stats(MVMThreadContext *tc, MVMObject *lock) {
+    MVMLockContention  contention;
+    MVMObject         *result;
+
+    /* Take a copy, since the lock object may move while we build the hash. */
+    if (REPR(lock)->ID == MVM_REPR_ID_ReentrantMutex && IS_CONCRETE(lock))
+        contention = ((MVMReentrantMutex *)lock)->body.contention;
+    else if (REPR(lock)->ID == MVM_REPR_ID_Semaphore && IS_CONCRETE(lock))
+        contention = ((MVMSemaphore *)lock)->body.contention;
+    else
+        MVM_exception_throw_adhoc(tc,
+            "lockstats requires a concrete object with REPR ReentrantMutex or Semaphore");
+
+    result = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTHash);
+    MVMROOT(tc, result, {
+        add_stat(tc, result, "acquires", contention.acquires);
+        add_stat(tc, result, "contended", contention.contended);
+        add_stat(tc, result, "parked", contention.parked);
+        add_stat(tc, result, "spin_estimate", contention.spin_estimate);
+    });
+
+    return result;
+}
@@ -1,3 +1,34 @@
+/* Contention statistics kept per lock object, along with the estimate of how
+ * long it is worth spinning for it before parking. */
+struct MVMLockContention {
+    /* Number of times the lock was acquired (not counting recursion). Not
+     * updated atomically; for a Semaphore it is approximate. */
+    AO_t acquires;
+
+    /* Number of times it was not immediately available. */
+    AO_t contended;
+
+    /* Number of times spinning failed and the thread had to block. */
+    AO_t parked;
+
+    /* Running estimate of how many spins it takes to get the lock when it
+     * is contended; updated without synchronization, as it's only a hint. */
+    MVMuint32 spin_estimate;
+};
+
+/* The most we'll spin on a lock before parking. */
+#define MVM_LOCK_SPIN_MAX 100
+
+/* Works out how long to spin for a lock, given its contention record. */
+#define MVM_LOCK_SPIN_LIMIT(lc) \
+    ((lc)->spin_estimate * 2 + 10 < MVM_LOCK_SPIN_MAX \
+        ? (lc)->spin_estimate * 2 + 10 \
+        : MVM_LOCK_SPIN_MAX)
+
+/* Moves the spin estimate towards the number of spins we just needed. */
+#define MVM_LOCK_SPIN_ADAPT(lc, spins) \
+    ((lc)->spin_estimate += ((MVMint32)(spins) - (MVMint32)(lc)->spin_estimate) / 8)
+
 /* Representation used for VM thread handles. */
 struct MVMReentrantMutexBody {
     /* The (non-reentrant) mutex supplied by libuv. Sadly, we have to hold it
@@ -10,6 +41,9 @@ struct MVMReentrantMutexBody {
 
     /* How many times we've taken the lock. */
     AO_t lock_count;
+
+    /* Contention statistics. */
+    MVMLockContention contention;
 };
 struct MVMReentrantMutex {
     MVMObject common;
@@ -22,3 +56,6 @@ const MVMREPROps * MVMReentrantMutex_initialize(MVMThreadContext *tc);
 /* Lock and unlock functions. */
 void MVM_reentrantmutex_lock(MVMThreadContext *tc, MVMReentrantMutex *rm);
 void MVM_reentrantmutex_unlock(MVMThreadContext *tc, MVMReentrantMutex *rm);
+
+/* Gets a hash of contention statistics for a ReentrantMutex or Semaphore. */
+MVMObject * MVM_lock_contention_stats(MVMThreadContext *tc, MVMObject *lock);
@@ -116,15 +116,42 @@ static const MVMREPROps this_repr = {
 
 MVMint64 MVM_semaphore_tryacquire(MVMThreadContext *tc, MVMSemaphore *sem) {
     int r = uv_sem_trywait(sem->body.sem);
+    if (!r)
+        sem->body.contention.acquires++;
     return !r;
 }
 
+/* Acquires the semaphore. As with ReentrantMutex, we spin a while before
+ * marking ourselves blocked and waiting, which is far cheaper when the
+ * semaphore is only held briefly. Several threads may hold it at once, so
+ * the acquires count is bumped without synchronization, keeping atomics off
+ * the uncontended path; it may lose the odd count. */
 void MVM_semaphore_acquire(MVMThreadContext *tc, MVMSemaphore *sem) {
-    MVMROOT(tc, sem, {
-        MVM_gc_mark_thread_blocked(tc);
-        uv_sem_wait(sem->body.sem);
-        MVM_gc_mark_thread_unblocked(tc);
-    });
+    uv_sem_t *s = sem->body.sem;
+    if (uv_sem_trywait(s) != 0) {
+        MVMuint32 max_spins = MVM_LOCK_SPIN_LIMIT(&sem->body.contention);
+        MVMuint32 spins     = 0;
+        MVMuint32 acquired  = 0;
+        MVM_incr(&sem->body.contention.contended);
+        MVMROOT(tc, sem, {
+            while (spins < max_spins) {
+                spins++;
+                GC_SYNC_POINT(tc);
+                if (uv_sem_trywait(s) == 0) {
+                    acquired = 1;
+                    break;
+                }
+            }
+            if (!acquired) {
+                MVM_incr(&sem->body.contention.parked);
+                MVM_gc_mark_thread_blocked(tc);
+                uv_sem_wait(s);
+                MVM_gc_mark_thread_unblocked(tc);
+            }
+        });
+        MVM_LOCK_SPIN_ADAPT(&sem->body.contention, spins);
+    }
+    sem->body.contention.acquires++;
 }
 
 void MVM_semaphore_release(MVMThreadContext *tc, MVMSemaphore *sem) {
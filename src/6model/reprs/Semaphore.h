@@ -1,6 +1,9 @@
 /* Representation used for VM thread handles. */
 struct MVMSemaphoreBody {
     uv_sem_t *sem;
+
+    /* Contention statistics. */
+    MVMLockContention contention;
 };
 struct MVMSemaphore {
     MVMObject common;
@@ -0,0 +1,305 @@
+#include "moar.h"
+
+/* This representation's function pointer table. */
+static const MVMREPROps this_repr;
+
+/* The number of graphemes we allocate space for when first appending. */
+#define MIN_ALLOC_GRAPHS 16
+
+/* Creates a new type object of this representation, and associates it with
+ * the given HOW. */
+static MVMObject * type_object_for(MVMThreadContext *tc, MVMObject *HOW) {
+    MVMSTable *st  = MVM_gc_allocate_stable(tc, &this_repr, HOW);
+
+    MVMROOT(tc, st, {
+        MVMObject *obj = MVM_gc_allocate_type_object(tc, st);
+        MVM_ASSIGN_REF(tc, &(st->header), st->WHAT, obj);
+        st->size = sizeof(MVMStrBuilder);
+    });
+
+    return st->WHAT;
+}
+
+/* Initializes a new instance; we start out with 8-bit storage. */
+static void initialize(MVMThreadContext *tc, MVMSTable *st, MVMObject *root, void *data) {
+    MVMStrBuilderBody *body = (MVMStrBuilderBody *)data;
+    body->storage_type = MVM_STRING_GRAPHEME_8;
+}
+
+/* Size in bytes of a grapheme in the buffer. */
+MVM_STATIC_INLINE size_t grapheme_size(MVMStrBuilderBody *body) {
+    return body->storage_type == MVM_STRING_GRAPHEME_32
+        ? sizeof(MVMGrapheme32)
+        : sizeof(MVMGrapheme8);
+}
+
+/* Copies the body of one object to another. */
+static void copy_to(MVMThreadContext *tc, MVMSTable *st, void *src, MVMObject *dest_root, void *dest) {
+    MVMStrBuilderBody *src_body  = (MVMStrBuilderBody *)src;
+    MVMStrBuilderBody *dest_body = (MVMStrBuilderBody *)dest;
+    dest_body->storage_type = src_body->storage_type;
+    dest_body->num_graphs   = src_body->num_graphs;
+    dest_body->alloc_graphs = src_body->num_graphs;
+    if (src_body->num_graphs) {
+        size_t size = src_body->num_graphs * grapheme_size(src_body);
+        dest_body->buffer.any = MVM_malloc(size);
+        memcpy(dest_body->buffer.any, src_body->buffer.any, size);
+    }
+}
+
+/* Called by the VM in order to free memory associated with this object. */
+static void gc_free(MVMThreadContext *tc, MVMObject *obj) {
+    MVMStrBuilder *sb = (MVMStrBuilder *)obj;
+    MVM_free(sb->body.buffer.any);
+}
+
+static const MVMStorageSpec storage_spec = {
+    MVM_STORAGE_SPEC_REFERENCE, /* inlineable */
+    0,                          /* bits */
+    0,                          /* align */
+    MVM_STORAGE_SPEC_BP_NONE,   /* boxed_primitive */
+    0,                          /* can_box */
+    0,                          /* is_unsigned */
+};
+
+/* Gets the storage specification for this representation. */
+static const MVMStorageSpec * get_storage_spec(MVMThreadContext *tc, MVMSTable *st) {
+    return &storage_spec;
+}
+
+/* Compose the representation. */
+static void compose(MVMThreadContext *tc, MVMSTable *st, MVMObject *info) {
+    /* Nothing to do for this REPR. */
+}
+
+/* Set the size of the STable. */
+static void deserialize_stable_size(MVMThreadContext *tc, MVMSTable *st, MVMSerializationReader *reader) {
+    st->size = sizeof(MVMStrBuilder);
+}
+
+/* Calculates the non-GC-managed memory we hold on to. */
+static MVMuint64 unmanaged_size(MVMThreadContext *tc, MVMSTable *st, void *data) {
+    MVMStrBuilderBody *body = (MVMStrBuilderBody *)data;
+    return body->alloc_graphs * grapheme_size(body);
+}
+
+/* Initializes the representation. */
+const MVMREPROps * MVMStrBuilder_initialize(MVMThreadContext *tc) {
+    return &this_repr;
+}
+
+static const MVMREPROps this_repr = {
+    type_object_for,
+    MVM_gc_allocate_object,
+    initialize,
+    copy_to,
+    MVM_REPR_DEFAULT_ATTR_FUNCS,
+    MVM_REPR_DEFAULT_BOX_FUNCS,
+    MVM_REPR_DEFAULT_POS_FUNCS,
+    MVM_REPR_DEFAULT_ASS_FUNCS,
+    MVM_REPR_DEFAULT_ELEMS,
+    get_storage_spec,
+    NULL, /* change_type */
+    NULL, /* serialize */
+    NULL, /* deserialize */
+    NULL, /* serialize_repr_data */
+    NULL, /* deserialize_repr_data */
+    deserialize_stable_size,
+    NULL, /* gc_mark */
+    gc_free,
+    NULL, /* gc_cleanup */
+    NULL, /* gc_mark_repr_data */
+    NULL, /* gc_free_repr_data */
+    compose,
+    NULL, /* spesh */
+    "StrBuilder", /* name */
+    MVM_REPR_ID_StrBuilder,
+    unmanaged_size,
+    NULL, /* describe_refs */
+};
+
+/* Assert that the passed object really is a string builder; throw if not. */
+static MVMStrBuilderBody * get_body(MVMThreadContext *tc, MVMObject *sb, const char *op) {
+    if (REPR(sb)->ID != MVM_REPR_ID_StrBuilder || !IS_CONCRETE(sb))
+        MVM_exception_throw_adhoc(tc,
+            "Operation '%s' can only work on an object with the StrBuilder representation",
+            op);
+    return &(((MVMStrBuilder *)sb)->body);
+}
+
+/* Checks if a grapheme can be stored in 8 bits. */
+MVM_STATIC_INLINE MVMint32 fits_8bit(MVMGrapheme32 g) {
+    return g >= -127 && g <= 127;
+}
+
+/* Makes sure there is space for at least the specified number of graphemes,
+ * at least doubling the space each time we grow it. */
+static void ensure_space(MVMThreadContext *tc, MVMStrBuilderBody *body, MVMuint64 needed) {
+    if (needed > 0xFFFFFFFF)
+        MVM_exception_throw_adhoc(tc, "Cannot build a string of %"PRIu64" graphemes", needed);
+    if (needed > body->alloc_graphs) {
+        MVMuint64 alloc = (MVMuint64)body->alloc_graphs * 2;
+        if (alloc < needed)
+            alloc = needed;
+        if (alloc < MIN_ALLOC_GRAPHS)
+            alloc = MIN_ALLOC_GRAPHS;
+        if (alloc > 0xFFFFFFFF)
+            alloc = 0xFFFFFFFF;
+        body->buffer.any    = MVM_realloc(body->buffer.any, alloc * grapheme_size(body));
+        body->alloc_graphs  = (MVMuint32)alloc;
+    }
+}
+
+/* Widens the buffer from 8-bit to 32-bit graphemes, keeping the specified
+ * number of them. */
+static void widen(MVMThreadContext *tc, MVMStrBuilderBody *body, MVMuint32 used) {
+    MVMGrapheme32 *wide = MVM_malloc(body->alloc_graphs * sizeof(MVMGrapheme32));
+    MVMuint32      i;
+    for (i = 0; i < used; i++)
+        wide[i] = body->buffer.blob_8[i];
+    MVM_free(body->buffer.blob_8);
+    body->buffer.blob_32 = wide;
+    body->storage_type   = MVM_STRING_GRAPHEME_32;
+}
+
+/* Appends the graphemes of a string to the buffer; does not allocate any GC
+ * managed memory. */
+static void append_graphemes(MVMThreadContext *tc, MVMStrBuilderBody *body, MVMString *s) {
+    MVMuint32 n = s->body.num_graphs;
+    MVMuint32 i;
+    ensure_space(tc, body, (MVMuint64)body->num_graphs + n);
+    switch (s->body.storage_type) {
+        case MVM_STRING_GRAPHEME_ASCII:
+        case MVM_STRING_GRAPHEME_8:
+            if (body->storage_type == MVM_STRING_GRAPHEME_8) {
+                memcpy(body->buffer.blob_8 + body->num_graphs, s->body.storage.blob_8, n);
+            }
+            else {
+                for (i = 0; i < n; i++)
+                    body->buffer.blob_32[body->num_graphs + i] = s->body.storage.blob_8[i];
+            }
+            break;
+        case MVM_STRING_GRAPHEME_32:
+            if (body->storage_type == MVM_STRING_GRAPHEME_8) {
+                for (i = 0; i < n; i++)
+                    if (!fits_8bit(s->body.storage.blob_32[i]))
+                        break;
+                if (i < n) {
+                    widen(tc, body, body->num_graphs);
+                }
+                else {
+                    for (i = 0; i < n; i++)
+                        body->buffer.blob_8[body->num_graphs + i] =
+                            (MVMGrapheme8)s->body.storage.blob_32[i];
+                    break;
+                }
+            }
+            memcpy(body->buffer.blob_32 + body->num_graphs, s->body.storage.blob_32,
+                n * sizeof(MVMGrapheme32));
+            break;
+        case MVM_STRING_STRAND: {
+            MVMGraphemeIter gi;
+            MVM_string_gi_init(tc, &gi, s);
+            for (i = 0; i < n; i++) {
+                MVMGrapheme32 g = MVM_string_gi_get_grapheme(tc, &gi);
+                if (body->storage_type == MVM_STRING_GRAPHEME_8) {
+                    if (fits_8bit(g)) {
+                        body->buffer.blob_8[body->num_graphs + i] = (MVMGrapheme8)g;
+                        continue;
+                    }
+                    widen(tc, body, body->num_graphs + i);
+                }
+                body->buffer.blob_32[body->num_graphs + i] = g;
+            }
+            break;
+        }
+        default:
+            MVM_exception_throw_adhoc(tc, "String corruption detected: bad storage type");
+    }
+    body->num_graphs += n;
+}
+
+/* Takes the last grapheme off the buffer and returns a string of it followed
+ * by the string being appended, in NFG. The string builder must be rooted by
+ * the caller. */
+static MVMString * renormalize_last(MVMThreadContext *tc, MVMObject *sb, MVMString *s) {
+    MVMStrBuilderBody *body = &(((MVMStrBuilder *)sb)->body);
+    MVMGrapheme32      last = body->storage_type == MVM_STRING_GRAPHEME_32
+        ? body->buffer.blob_32[body->num_graphs - 1]
+        : body->buffer.blob_8[body->num_graphs - 1];
+    MVMString *last_str;
+    body->num_graphs--;
+    MVMROOT(tc, s, {
+        last_str = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+    });
+    last_str->body.storage_type    = MVM_STRING_GRAPHEME_32;
+    last_str->body.storage.blob_32 = MVM_malloc(sizeof(MVMGrapheme32));
+    last_str->body.storage.blob_32[0] = last;
+    last_str->body.num_graphs      = 1;
+    return MVM_string_concatenate(tc, last_str, s);
+}
+
+/* Appends a string to a string builder. Graphemes are copied into the buffer,
+ * which grows geometrically, so building a string of n graphemes costs O(n)
+ * no matter how many pieces it is made from. */
+void MVM_strbuilder_append(MVMThreadContext *tc, MVMObject *sb, MVMString *s) {
+    MVMStrBuilderBody *body = get_body(tc, sb, "sbappend");
+    MVM_string_check_arg(tc, s, "sbappend");
+    if (s->body.num_graphs == 0)
+        return;
+
+    /* If the join between what we have and the new string would not be in
+     * NFG, such as when appending a combining character, then we normalize
+     * the last grapheme we have together with the new string. This should be
+     * rare, so we don't mind the allocation. */
+    if (body->num_graphs) {
+        MVMGrapheme32 last = body->storage_type == MVM_STRING_GRAPHEME_32
+            ? body->buffer.blob_32[body->num_graphs - 1]
+            : body->buffer.blob_8[body->num_graphs - 1];
+        if (!MVM_nfg_is_concat_stable_graphemes(tc, last,
+                MVM_string_get_grapheme_at_nocheck(tc, s, 0))) {
+            MVMROOT(tc, sb, {
+                s = renormalize_last(tc, sb, s);
+            });
+            body = &(((MVMStrBuilder *)sb)->body);
+        }
+    }
+
+    append_graphemes(tc, body, s);
+}
+
+/* Gets the number of graphemes in a string builder. */
+MVMint64 MVM_strbuilder_chars(MVMThreadContext *tc, MVMObject *sb) {
+    return get_body(tc, sb, "sbchars")->num_graphs;
+}
+
+/* Takes the string built so far, leaving the string builder empty. The buffer
+ * becomes the storage of the string, so nothing is copied. */
+MVMString * MVM_strbuilder_take(MVMThreadContext *tc, MVMObject *sb) {
+    MVMStrBuilderBody *body = get_body(tc, sb, "sbtake");
+    MVMString         *result;
+
+    if (body->num_graphs == 0)
+        return tc->instance->str_consts.empty;
+
+    MVMROOT(tc, sb, {
+        result = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+    });
+    body = &(((MVMStrBuilder *)sb)->body);
+
+    /* Give back any space we over-allocated, if it is a lot. */
+    if (body->alloc_graphs - body->num_graphs > body->num_graphs / 4)
+        body->buffer.any = MVM_realloc(body->buffer.any,
+            body->num_graphs * grapheme_size(body));
+
+    result->body.storage_type = body->storage_type;
+    result->body.storage.any  = body->buffer.any;
+    result->body.num_graphs   = body->num_graphs;
+
+    body->buffer.any   = NULL;
+    body->storage_type = MVM_STRING_GRAPHEME_8;
+    body->num_graphs   = 0;
+    body->alloc_graphs = 0;
+
+    return result;
+}
@@ -0,0 +1,27 @@
+/* Representation used for building up a string piece by piece. Graphemes are
+ * appended to a growable buffer, which is 8-bit until a grapheme that does
+ * not fit in 8 bits is appended, at which point it is widened to 32-bit. The
+ * buffer is handed over to a new string when the result is taken, without
+ * copying it, and the builder is left empty. */
+struct MVMStrBuilderBody {
+    union {
+        MVMGrapheme32 *blob_32;
+        MVMGrapheme8  *blob_8;
+        void          *any;
+    } buffer;
+    MVMuint16 storage_type;
+    MVMuint32 num_graphs;
+    MVMuint32 alloc_graphs;
+};
+struct MVMStrBuilder {
+    MVMObject common;
+    MVMStrBuilderBody body;
+};
+
+/* Function for REPR setup. */
+const MVMREPROps * MVMStrBuilder_initialize(MVMThreadContext *tc);
+
+/* Operations on a StrBuilder object. */
+void MVM_strbuilder_append(MVMThreadContext *tc, MVMObject *sb, MVMString *s);
+MVMint64 MVM_strbuilder_chars(MVMThreadContext *tc, MVMObject *sb);
+MVMString * MVM_strbuilder_take(MVMThreadContext *tc, MVMObject *sb);
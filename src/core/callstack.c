@@ -1,27 +1,46 @@
 #include "moar.h"
 
-/* Allocates a new call stack region, not incorporated into the regions double
- * linked list yet. */
-static MVMCallStackRegion * create_region() {
-    MVMCallStackRegion *region = MVM_malloc(MVM_CALLSTACK_REGION_SIZE);
+/* Allocates a new call stack region of the specified size, not incorporated
+ * into the regions double linked list yet. */
+static MVMCallStackRegion * create_region(MVMThreadContext *tc, size_t size) {
+    MVMCallStackRegion *region = MVM_malloc(size);
     region->prev = region->next = NULL;
     region->alloc = (char *)region + sizeof(MVMCallStackRegion);
-    region->alloc_limit = (char *)region + MVM_CALLSTACK_REGION_SIZE;
+    region->alloc_limit = (char *)region + size;
+    tc->stack_reserved += size;
+    if (tc->stack_reserved > tc->stack_max_reserved)
+        tc->stack_max_reserved = tc->stack_reserved;
+    tc->stack_regions_allocated++;
     return region;
 }
 
+/* Frees a call stack region and all of those after it. */
+static void free_regions_from(MVMThreadContext *tc, MVMCallStackRegion *region) {
+    while (region) {
+        MVMCallStackRegion *next = region->next;
+        tc->stack_reserved -= region->alloc_limit - (char *)region;
+        tc->stack_regions_freed++;
+        MVM_free(region);
+        region = next;
+    }
+}
+
 /* Called upon thread creation to set up an initial callstack region for the
  * thread. */
 void MVM_callstack_region_init(MVMThreadContext *tc) {
-    tc->stack_first = tc->stack_current = create_region();
+    tc->stack_first = tc->stack_current = create_region(tc, MVM_CALLSTACK_REGION_SIZE);
 }
 
 /* Moves the current call stack region we're allocating/freeing in along to
- * the next one in the region chain, allocating that next one if needed. */
+ * the next one in the region chain, allocating that next one if needed. It
+ * is made twice the size of the current one, up to a limit. */
 MVMCallStackRegion * MVM_callstack_region_next(MVMThreadContext *tc) {
     MVMCallStackRegion *next_region = tc->stack_current->next;
     if (!next_region) {
-        next_region = create_region();
+        size_t size = 2 * (tc->stack_current->alloc_limit - (char *)tc->stack_current);
+        if (size > MVM_CALLSTACK_REGION_MAX_SIZE)
+            size = MVM_CALLSTACK_REGION_MAX_SIZE;
+        next_region = create_region(tc, size);
         tc->stack_current->next = next_region;
         next_region->prev = tc->stack_current;
     }
@@ -30,34 +49,46 @@ MVMCallStackRegion * MVM_callstack_region_next(MVMThreadContext *tc) {
 }
 
 /* Switches to the previous call stack region, if any. Otherwise, stays in
- * the current region. */
+ * the current region. The region we leave is kept for when the stack grows
+ * again, but any regions after it are freed, so that a deep recursion does
+ * not keep its memory for the life of the thread. Keeping one spare means
+ * a stack going back and forth over a region boundary doesn't keep on
+ * allocating and freeing. */
 MVMCallStackRegion * MVM_callstack_region_prev(MVMThreadContext *tc) {
     MVMCallStackRegion *prev_region = tc->stack_current->prev;
-    if (prev_region)
+    if (prev_region) {
+        MVMCallStackRegion *spare = tc->stack_current;
+        if (spare->next) {
+            free_regions_from(tc, spare->next);
+            spare->next = NULL;
+        }
         tc->stack_current = prev_region;
-    else
+    }
+    else {
         prev_region = tc->stack_current;
+    }
     return prev_region;
 }
 
 /* Resets a threads's callstack to be empty. Used when its contents has been
- * promoted to the heap. */
+ * promoted to the heap. As when moving back a region, we keep one spare
+ * region after the first, and free any others. */
 void MVM_callstack_reset(MVMThreadContext *tc) {
-    MVMCallStackRegion *cur_region = tc->stack_current;
-    while (cur_region) {
-        cur_region->alloc = (char *)cur_region + sizeof(MVMCallStackRegion);
-        cur_region = cur_region->prev;
+    MVMCallStackRegion *first = tc->stack_first;
+    MVMCallStackRegion *spare = first->next;
+    first->alloc = (char *)first + sizeof(MVMCallStackRegion);
+    if (spare) {
+        spare->alloc = (char *)spare + sizeof(MVMCallStackRegion);
+        if (spare->next) {
+            free_regions_from(tc, spare->next);
+            spare->next = NULL;
+        }
     }
-    tc->stack_current = tc->stack_first;
+    tc->stack_current = first;
 }
 
 /* Called at thread exit to destroy all callstack regions the thread has. */
 void MVM_callstack_region_destroy_all(MVMThreadContext *tc) {
-    MVMCallStackRegion *cur = tc->stack_first;
-    while (cur) {
-        MVMCallStackRegion *next = cur->next;
-        MVM_free(cur);
-        cur = next;
-    }
+    free_regions_from(tc, tc->stack_first);
     tc->stack_first = NULL;
 }
@@ -15,8 +15,11 @@ struct MVMCallStackRegion {
     char *alloc_limit;
 };
 
-/* The default size of a call stack region. */
-#define MVM_CALLSTACK_REGION_SIZE 131072
+/* The size of the first call stack region. Each region after it is twice the
+ * size of the one before, up to the maximum size, so deep recursion needs
+ * fewer of them. */
+#define MVM_CALLSTACK_REGION_SIZE       131072
+#define MVM_CALLSTACK_REGION_MAX_SIZE   4194304
 
 /* Checks if a frame is allocated on a call stack or on the heap. If it is on
  * the call stack, then it will have zeroed flags (since heap-allocated frames
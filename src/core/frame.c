@@ -321,6 +321,10 @@ void MVM_frame_invoke(MVMThreadContext *tc, MVMStaticFrame *static_frame,
     MVMFrame *frame;
     MVMuint32 found_spesh;
 
+    /* Take a sampling profiler sample if one is due; doing it on calls as
+     * well as on branches means we also catch code that recurses. */
+    MVM_PROFILE_SAMPLE_POINT(tc);
+
     /* If the frame was never invoked before, or never before at the current
      * instrumentation level, we need to trigger the instrumentation level
      * barrier. */
@@ -410,9 +414,11 @@ void MVM_frame_invoke(MVMThreadContext *tc, MVMStaticFrame *static_frame,
 
     /* See if any specializations apply. */
     found_spesh = 0;
-    if (spesh_cand >= 0 && spesh_cand < static_frame->body.num_spesh_candidates) {
-        MVMSpeshCandidate *chosen_cand = &static_frame->body.spesh_candidates[spesh_cand];
-        if (!chosen_cand->sg) {
+    if (spesh_cand >= 0 && MVM_spesh_candidate_ref_idx(spesh_cand) < static_frame->body.num_spesh_candidates) {
+        MVMSpeshCandidate *chosen_cand = MVM_spesh_candidate_at(&static_frame->body,
+            MVM_spesh_candidate_ref_idx(spesh_cand));
+        if (chosen_cand->generation == MVM_spesh_candidate_ref_gen(spesh_cand) && !chosen_cand->sg) {
+            chosen_cand->hits++;
             frame = allocate_frame(tc, static_frame, chosen_cand);
             frame->effective_bytecode    = chosen_cand->bytecode;
             frame->effective_handlers    = chosen_cand->handlers;
@@ -424,82 +430,13 @@ void MVM_frame_invoke(MVMThreadContext *tc, MVMStaticFrame *static_frame,
     }
     if (!found_spesh && ++static_frame->body.invocations >= static_frame->body.spesh_threshold && callsite->is_interned) {
         /* Look for specialized bytecode. */
-        MVMint32 num_spesh = static_frame->body.num_spesh_candidates;
-        MVMSpeshCandidate *chosen_cand = NULL;
-        MVMint32 i, j;
-        for (i = 0; i < num_spesh; i++) {
-            MVMSpeshCandidate *cand = &static_frame->body.spesh_candidates[i];
-            if (cand->cs == callsite) {
-                MVMint32 match = 1;
-                for (j = 0; j < cand->num_guards; j++) {
-                    MVMint32   pos = cand->guards[j].slot;
-                    MVMSTable *st  = (MVMSTable *)cand->guards[j].match;
-                    MVMObject *arg = args[pos].o;
-                    if (!arg) {
-                        match = 0;
-                        break;
-                    }
-                    switch (cand->guards[j].kind) {
-                    case MVM_SPESH_GUARD_CONC:
-                        if (!IS_CONCRETE(arg) || STABLE(arg) != st)
-                            match = 0;
-                        break;
-                    case MVM_SPESH_GUARD_TYPE:
-                        if (IS_CONCRETE(arg) || STABLE(arg) != st)
-                            match = 0;
-                        break;
-                    case MVM_SPESH_GUARD_DC_CONC: {
-                        MVMRegister dc;
-                        STABLE(arg)->container_spec->fetch(tc, arg, &dc);
-                        if (!dc.o || !IS_CONCRETE(dc.o) || STABLE(dc.o) != st)
-                            match = 0;
-                        break;
-                    }
-                    case MVM_SPESH_GUARD_DC_TYPE: {
-                        MVMRegister dc;
-                        STABLE(arg)->container_spec->fetch(tc, arg, &dc);
-                        if (!dc.o || IS_CONCRETE(dc.o) || STABLE(dc.o) != st)
-                            match = 0;
-                        break;
-                    }
-                    case MVM_SPESH_GUARD_DC_CONC_RW: {
-                        if (STABLE(arg)->container_spec->can_store(tc, arg)) {
-                            MVMRegister dc;
-                            STABLE(arg)->container_spec->fetch(tc, arg, &dc);
-                            if (!dc.o || !IS_CONCRETE(dc.o) || STABLE(dc.o) != st)
-                                match = 0;
-                        }
-                        else {
-                            match = 0;
-                        }
-                        break;
-                    }
-                    case MVM_SPESH_GUARD_DC_TYPE_RW: {
-                        if (STABLE(arg)->container_spec->can_store(tc, arg)) {
-                            MVMRegister dc;
-                            STABLE(arg)->container_spec->fetch(tc, arg, &dc);
-                            if (!dc.o || IS_CONCRETE(dc.o) || STABLE(dc.o) != st)
-                                match = 0;
-                        }
-                        else {
-                            match = 0;
-                        }
-                        break;
-                    }
-                    }
-                    if (!match)
-                        break;
-                }
-                if (match) {
-                    chosen_cand = cand;
-                    break;
-                }
-            }
-        }
+        MVMSpeshCandidate *chosen_cand = MVM_spesh_candidate_find(tc,
+            static_frame, callsite, args);
 
-        /* If we didn't find any, and we're below the limit, can set up a
+        /* If we didn't find any, and there's room for another, can set up a
          * specialization. */
-        if (!chosen_cand && num_spesh < MVM_SPESH_LIMIT && tc->instance->spesh_enabled)
+        if (!chosen_cand && tc->instance->spesh_enabled &&
+                MVM_spesh_candidate_has_room(tc, static_frame))
             chosen_cand = MVM_spesh_candidate_setup(tc, static_frame,
                 callsite, args, 0);
 
@@ -643,6 +580,7 @@ MVMFrame * MVM_frame_force_to_heap(MVMThreadContext *tc, MVMFrame *frame) {
             while (cur_to_promote) {
                 /* Allocate a heap frame. */
                 MVMFrame *promoted = MVM_gc_allocate_frame(tc);
+                tc->gc_stats.frames_promoted++;
 
                 /* Copy current frame's body to it. */
                 memcpy(
@@ -713,6 +651,7 @@ MVMFrame * MVM_frame_force_to_heap(MVMThreadContext *tc, MVMFrame *frame) {
 
         /* All is promoted. Update thread's current frame and reset the thread
          * local callstack. */
+        tc->gc_stats.heap_promotions++;
         tc->cur_frame = new_cur_frame;
         MVM_callstack_reset(tc);
 
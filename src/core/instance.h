@@ -79,6 +79,11 @@ struct MVMStringConsts {
     MVMString *kind;
     MVMString *instrumented;
     MVMString *heap;
+    MVMString *queue;
+    MVMString *capacity;
+    MVMString *sampling;
+    MVMString *interval;
+    MVMString *path;
 };
 
 /* An entry in the representations registry. */
@@ -127,6 +132,12 @@ struct MVMInstance {
     MVMObject        *event_loop_active;
     uv_async_t       *event_loop_wakeup;
 
+    /* The pool of worker threads that run work submitted to the VM's
+     * scheduler, created on first submission, and a mutex to avoid start
+     * races. */
+    MVMWorkerPool *worker_pool;
+    uv_mutex_t     mutex_worker_pool_start;
+
     /* The VM null object. */
     MVMObject *VMNull;
 
@@ -167,15 +178,17 @@ struct MVMInstance {
     /* int -> str cache */
     MVMString **int_to_str_cache;
 
-    /* Multi-dispatch cache and specialization installation mutexes
-     * (global, as the additions are quite low contention, so no
-     * real motivation to have it more fine-grained at present). */
-    uv_mutex_t mutex_multi_cache_add;
+    /* Specialization installation mutex (global, as the additions are
+     * quite low contention, so no real motivation to have it more
+     * fine-grained at present). */
     uv_mutex_t mutex_spesh_install;
 
     /* Log file for specializations, if we're to log them. */
     FILE *spesh_log_fh;
 
+    /* Binary log of spesh and JIT events, if we're to log them. */
+    MVMSpeshEventLog *spesh_event_log;
+
     /* Log file for dynamic var performance, if we're to log it. */
     FILE *dynvar_log_fh;
     MVMint64 dynvar_log_lasttime;
@@ -194,6 +207,10 @@ struct MVMInstance {
     /* Flag for if NFA debugging is enabled. */
     MVMint8 nfa_debug_enabled;
 
+    /* Flag for if full collections should count the live strings in gen2 by
+     * storage type, for the GC statistics. */
+    MVMint8 gc_string_stats;
+
     /* Flag for if jit is enabled */
     MVMint32 jit_enabled;
 
@@ -251,6 +268,9 @@ struct MVMInstance {
      * since we last did a full collection? */
     AO_t gc_promoted_bytes_since_last_full;
 
+    /* GC telemetry for all runs, as seen by their coordinators. */
+    MVMGCStats gc_stats;
+
     /* Persistent object ID hash, used to give nursery objects a lifetime
      * unique ID. Plus a lock to protect it. */
     MVMObjectId *object_ids;
@@ -260,6 +280,10 @@ struct MVMInstance {
     /* note: used atomically */
     MVMThread *threads;
 
+    /* Held while adding to the threads list, and by anything that walks it
+     * outside of GC; GC rewrites the list with the world stopped. */
+    uv_mutex_t mutex_threads;
+
     /* raw command line args from APR */
     char          **raw_clargs;
     /* Number of passed command-line args */
@@ -332,6 +356,10 @@ struct MVMInstance {
     MVMCallsiteInterns *callsite_interns;
     uv_mutex_t          mutex_callsite_interns;
 
+    /* Interned strings; NULL if string interning is disabled. */
+    MVMStringInternTable *string_interns;
+    uv_mutex_t            mutex_string_interns;
+
     /* Standard file handles. */
     MVMObject *stdin_handle;
     MVMObject *stdout_handle;
@@ -359,6 +387,9 @@ struct MVMInstance {
     /* Heap snapshots, if we're doing heap snapshotting. */
     MVMHeapSnapshotCollection *heap_snapshots;
 
+    /* The sampling profiler, if it was ever started. */
+    MVMProfileSampler *sampler;
+
     /* Whether cross-thread write logging is turned on or not, and an output
      * mutex for it. */
     MVMuint32  cross_thread_write_logging;
@@ -1,53 +1,72 @@
 #include "moar.h"
 
+/* Looks up the slot of an already registered type, or returns -1. Safe to
+ * call without holding the lock. */
+static MVMint32 find_type_slot(MVMIntConstCache *cache, MVMObject *type) {
+    MVMuint32 num_types = (MVMuint32)MVM_load(&cache->num_types);
+    MVMuint32 type_index;
+    for (type_index = 0; type_index < num_types; type_index++)
+        if (cache->types[type_index] == type)
+            return type_index;
+    return -1;
+}
+
+/* Registers a type for boxed integer caching, boxing all of the values in
+ * the cached range. Does nothing if the type is already registered or if
+ * all of the type slots are taken. */
 void MVM_intcache_for(MVMThreadContext *tc, MVMObject *type) {
-    int type_index;
-    int right_slot = -1;
+    MVMIntConstCache *cache = tc->instance->int_const_cache;
+    MVMuint32 type_index;
+
+    /* Cheap check first, so re-registration never needs the lock. */
+    if (find_type_slot(cache, type) >= 0)
+        return;
+
     uv_mutex_lock(&tc->instance->mutex_int_const_cache);
-    for (type_index = 0; type_index < 4; type_index++) {
-        if (tc->instance->int_const_cache->types[type_index] == NULL) {
-            right_slot = type_index;
-            break;
-        }
-        else if (tc->instance->int_const_cache->types[type_index] == type) {
-            uv_mutex_unlock(&tc->instance->mutex_int_const_cache);
-            return;
-        }
-    }
-    if (right_slot != -1) {
-        int val;
-        for (val = -1; val < 15; val++) {
-            MVMObject *obj;
-            obj = MVM_repr_alloc_init(tc, type);
+    type_index = (MVMuint32)MVM_load(&cache->num_types);
+    if (type_index < MVM_INTCACHE_TYPES && find_type_slot(cache, type) < 0) {
+        MVMObject **boxes = MVM_calloc(MVM_INTCACHE_SIZE, sizeof(MVMObject *));
+        MVMint64    val;
+
+        /* The boxes live for as long as the instance, so allocate them
+         * straight into gen2; that also means no GC can be triggered while
+         * we are filling the cache. The array is marked by the instance
+         * roots once it's installed. */
+        cache->cache[type_index] = boxes;
+        MVM_gc_allocate_gen2_default_set(tc);
+        for (val = MVM_INTCACHE_LOW; val <= MVM_INTCACHE_HIGH; val++) {
+            MVMObject *obj = MVM_repr_alloc_init(tc, type);
             MVM_repr_set_int(tc, obj, val);
-            tc->instance->int_const_cache->cache[type_index][val + 1] = obj;
-            MVM_gc_root_add_permanent_desc(tc,
-                (MVMCollectable **)&tc->instance->int_const_cache->cache[type_index][val + 1],
-                "Boxed integer cache entry");
+            boxes[val - MVM_INTCACHE_LOW] = obj;
         }
-        tc->instance->int_const_cache->types[type_index] = type;
-        MVM_gc_root_add_permanent_desc(tc,
-            (MVMCollectable **)&tc->instance->int_const_cache->types[type_index],
-            "Boxed integer cache type");
+        MVM_gc_allocate_gen2_default_clear(tc);
+
+        /* Publish the type only after all of its boxes are in place. */
+        cache->types[type_index] = type;
+        MVM_store(&cache->num_types, type_index + 1);
     }
     uv_mutex_unlock(&tc->instance->mutex_int_const_cache);
 }
 
+/* Gets a cached boxed integer, or NULL if the value is outside of the cached
+ * range or the type is not registered. Lock-free. */
 MVMObject *MVM_intcache_get(MVMThreadContext *tc, MVMObject *type, MVMint64 value) {
-    int type_index;
-    int right_slot = -1;
+    MVMint32 type_index;
 
-    if (value < -1 || value >= 15)
+    if (value < MVM_INTCACHE_LOW || value > MVM_INTCACHE_HIGH)
         return NULL;
 
-    for (type_index = 0; type_index < 4; type_index++) {
-        if (tc->instance->int_const_cache->types[type_index] == type) {
-            right_slot = type_index;
-            break;
-        }
-    }
-    if (right_slot != -1) {
-        return tc->instance->int_const_cache->cache[right_slot][value + 1];
-    }
+    type_index = find_type_slot(tc->instance->int_const_cache, type);
+    if (type_index >= 0)
+        return tc->instance->int_const_cache->cache[type_index][value - MVM_INTCACHE_LOW];
     return NULL;
 }
+
+/* Frees the cache arrays at instance destruction. */
+void MVM_intcache_destroy(MVMThreadContext *tc) {
+    MVMIntConstCache *cache = tc->instance->int_const_cache;
+    MVMuint32 type_index;
+    for (type_index = 0; type_index < MVM_INTCACHE_TYPES; type_index++)
+        MVM_free(cache->cache[type_index]);
+    MVM_free(cache);
+}
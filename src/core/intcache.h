@@ -1,7 +1,26 @@
+/* The range of integer values we keep pre-boxed for each registered type,
+ * and the number of types that may be registered. These can be overridden
+ * at build time. */
+#ifndef MVM_INTCACHE_LOW
+#define MVM_INTCACHE_LOW    -128
+#endif
+#ifndef MVM_INTCACHE_HIGH
+#define MVM_INTCACHE_HIGH   1023
+#endif
+#ifndef MVM_INTCACHE_TYPES
+#define MVM_INTCACHE_TYPES  8
+#endif
+#define MVM_INTCACHE_SIZE   (MVM_INTCACHE_HIGH - MVM_INTCACHE_LOW + 1)
+
+/* Cache of boxed integer constants. Entries are only ever added, under the
+ * mutex_int_const_cache lock; a type's boxes are filled in before the type
+ * is published by bumping num_types, so readers need no lock. */
 struct MVMIntConstCache {
-    MVMObject *types[4];
-    MVMObject *cache[4][16];
+    MVMObject  *types[MVM_INTCACHE_TYPES];
+    MVMObject **cache[MVM_INTCACHE_TYPES];
+    AO_t        num_types;
 };
 
 void MVM_intcache_for(MVMThreadContext *tc, MVMObject *type);
 MVMObject *MVM_intcache_get(MVMThreadContext *tc, MVMObject *type, MVMint64 value);
+void MVM_intcache_destroy(MVMThreadContext *tc);
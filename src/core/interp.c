@@ -4111,9 +4111,12 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 if (REPR(queue)->ID == MVM_REPR_ID_ConcBlockingQueue && IS_CONCRETE(queue))
                     GET_REG(cur_op, 0).o = MVM_concblockingqueue_poll(tc,
                         (MVMConcBlockingQueue *)queue);
+                else if (REPR(queue)->ID == MVM_REPR_ID_ConcLockFreeQueue && IS_CONCRETE(queue))
+                    GET_REG(cur_op, 0).o = MVM_conclockfreequeue_poll(tc,
+                        (MVMConcLockFreeQueue *)queue);
                 else
                     MVM_exception_throw_adhoc(tc,
-                        "queuepoll requires a concrete object with REPR ConcBlockingQueue");
+                        "queuepoll requires a concrete object with REPR ConcBlockingQueue or ConcLockFreeQueue");
                 cur_op += 4;
                 goto NEXT;
             }
@@ -5611,6 +5614,48 @@ void MVM_interp_run(MVMThreadContext *tc, void (*initial_invoke)(MVMThreadContex
                 MVM_cross_thread_write_check(tc, obj, blame);
                 goto NEXT;
             }
+            OP(queuedrain): {
+                MVMObject *queue  = GET_REG(cur_op, 2).o;
+                MVMObject *target = GET_REG(cur_op, 4).o;
+                MVMint64   max    = GET_REG(cur_op, 6).i64;
+                if (REPR(queue)->ID == MVM_REPR_ID_ConcBlockingQueue && IS_CONCRETE(queue))
+                    GET_REG(cur_op, 0).i64 = MVM_concblockingqueue_drain(tc,
+                        (MVMConcBlockingQueue *)queue, target, max);
+                else if (REPR(queue)->ID == MVM_REPR_ID_ConcLockFreeQueue && IS_CONCRETE(queue))
+                    GET_REG(cur_op, 0).i64 = MVM_conclockfreequeue_drain(tc,
+                        (MVMConcLockFreeQueue *)queue, target, max);
+                else
+                    MVM_exception_throw_adhoc(tc,
+                        "queuedrain requires a concrete object with REPR ConcBlockingQueue or ConcLockFreeQueue");
+                cur_op += 8;
+                goto NEXT;
+            }
+            OP(submitwork): {
+                MVMObject *invokee = GET_REG(cur_op, 0).o;
+                cur_op += 2;
+                MVM_scheduler_submit(tc, invokee);
+                goto NEXT;
+            }
+            OP(lockstats):
+                GET_REG(cur_op, 0).o = MVM_lock_contention_stats(tc, GET_REG(cur_op, 2).o);
+                cur_op += 4;
+                goto NEXT;
+            OP(gcstats):
+                GET_REG(cur_op, 0).o = MVM_gc_stats(tc);
+                cur_op += 2;
+                goto NEXT;
+            OP(sbappend):
+                MVM_strbuilder_append(tc, GET_REG(cur_op, 0).o, GET_REG(cur_op, 2).s);
+                cur_op += 4;
+                goto NEXT;
+            OP(sbchars):
+                GET_REG(cur_op, 0).i64 = MVM_strbuilder_chars(tc, GET_REG(cur_op, 2).o);
+                cur_op += 4;
+                goto NEXT;
+            OP(sbtake):
+                GET_REG(cur_op, 0).s = MVM_strbuilder_take(tc, GET_REG(cur_op, 2).o);
+                cur_op += 4;
+                goto NEXT;
             OP(DEPRECATED_2):
             OP(DEPRECATED_3):
             OP(DEPRECATED_4):
@@ -9,7 +9,8 @@
 #define GC_SYNC_POINT(tc) \
     if (tc->gc_status) { \
         MVM_gc_enter_from_interrupt(tc); \
-    }
+    } \
+    MVM_PROFILE_SAMPLE_POINT(tc)
 
 /* Different views of a register. */
 union MVMRegister {
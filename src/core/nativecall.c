@@ -446,6 +446,235 @@ void MVM_nativecall_build(MVMThreadContext *tc, MVMObject *site, MVMString *lib,
 #ifdef HAVE_LIBFFI
     body->ffi_ret_type = MVM_nativecall_get_ffi_type(tc, body->ret_type);
 #endif
+
+    /* If we can, compile a stub that calls the function directly. */
+    if (body->jit_stub) {
+        MVM_jit_destroy_nativecall_stub(tc, body->jit_stub);
+        body->jit_stub = NULL;
+    }
+    if (tc->instance->jit_enabled && MVM_nativecall_stub_supported(tc, body))
+        body->jit_stub = MVM_jit_compile_nativecall_stub(tc, body);
+}
+
+/* Checks if a native call site has a signature that can be called through a
+ * JIT-compiled stub: the default calling convention, no strings, callbacks or
+ * rw arguments to manage, and a return value we know how to box. */
+MVMint32 MVM_nativecall_stub_supported(MVMThreadContext *tc, MVMNativeCallBody *body) {
+    MVMint16 i;
+#ifdef HAVE_LIBFFI
+    if (body->convention != FFI_DEFAULT_ABI)
+        return 0;
+#else
+    if (body->convention != DC_CALL_C_DEFAULT)
+        return 0;
+#endif
+    if (body->num_args > MVM_NATIVECALL_MAX_STUB_ARGS)
+        return 0;
+    for (i = 0; i < body->num_args; i++) {
+        if ((body->arg_types[i] & MVM_NATIVECALL_ARG_RW_MASK) == MVM_NATIVECALL_ARG_RW)
+            return 0;
+        switch (body->arg_types[i] & MVM_NATIVECALL_ARG_TYPE_MASK) {
+            case MVM_NATIVECALL_ARG_CHAR:
+            case MVM_NATIVECALL_ARG_SHORT:
+            case MVM_NATIVECALL_ARG_INT:
+            case MVM_NATIVECALL_ARG_LONG:
+            case MVM_NATIVECALL_ARG_LONGLONG:
+            case MVM_NATIVECALL_ARG_UCHAR:
+            case MVM_NATIVECALL_ARG_USHORT:
+            case MVM_NATIVECALL_ARG_UINT:
+            case MVM_NATIVECALL_ARG_ULONG:
+            case MVM_NATIVECALL_ARG_ULONGLONG:
+            case MVM_NATIVECALL_ARG_FLOAT:
+            case MVM_NATIVECALL_ARG_DOUBLE:
+            case MVM_NATIVECALL_ARG_CSTRUCT:
+            case MVM_NATIVECALL_ARG_CARRAY:
+            case MVM_NATIVECALL_ARG_CPOINTER:
+            case MVM_NATIVECALL_ARG_CUNION:
+            case MVM_NATIVECALL_ARG_VMARRAY:
+                break;
+            default:
+                return 0;
+        }
+    }
+    switch (body->ret_type & MVM_NATIVECALL_ARG_TYPE_MASK) {
+        case MVM_NATIVECALL_ARG_CALLBACK:
+        case MVM_NATIVECALL_ARG_CPPSTRUCT:
+            return 0;
+        default:
+            return 1;
+    }
+}
+
+/* Invokes a native call site through its JIT-compiled stub. The arguments are
+ * unmarshalled straight into registers, avoiding any per-call set up of the
+ * call VM. Sites without a stub go through the general path. */
+MVMObject * MVM_nativecall_invoke_jit(MVMThreadContext *tc, MVMObject *res_type,
+        MVMObject *site, MVMObject *args) {
+    MVMRegister  values[MVM_NATIVECALL_MAX_STUB_ARGS];
+    MVMRegister  ret;
+    MVMObject   *result = NULL;
+    MVMint16     i;
+
+    /* Read out all we need from the body, since allocating the result may
+     * move the site. */
+    MVMNativeCallBody    *body      = MVM_nativecall_get_nc_body(tc, site);
+    MVMJitNativeCallStub *stub      = body->jit_stub;
+    MVMint16              num_args  = body->num_args;
+    MVMint16             *arg_types = body->arg_types;
+    MVMint16              ret_type  = body->ret_type;
+
+    if (!stub)
+        return MVM_nativecall_invoke(tc, res_type, site, args);
+
+    /* Process arguments. */
+    for (i = 0; i < num_args; i++) {
+        MVMObject *value = MVM_repr_at_pos_o(tc, args, i);
+        MVMint16   type  = arg_types[i] & MVM_NATIVECALL_ARG_TYPE_MASK;
+        if (type != MVM_NATIVECALL_ARG_CSTRUCT && type != MVM_NATIVECALL_ARG_CARRAY
+                && type != MVM_NATIVECALL_ARG_CPOINTER && type != MVM_NATIVECALL_ARG_CUNION
+                && type != MVM_NATIVECALL_ARG_VMARRAY
+                && value && IS_CONCRETE(value) && STABLE(value)->container_spec) {
+            MVMRegister r;
+            STABLE(value)->container_spec->fetch(tc, value, &r);
+            value = r.o;
+        }
+        switch (type) {
+            case MVM_NATIVECALL_ARG_CHAR:
+                values[i].i64 = MVM_nativecall_unmarshal_char(tc, value);
+                break;
+            case MVM_NATIVECALL_ARG_SHORT:
+                values[i].i64 = MVM_nativecall_unmarshal_short(tc, value);
+                break;
+            case MVM_NATIVECALL_ARG_INT:
+                values[i].i64 = MVM_nativecall_unmarshal_int(tc, value);
+                break;
+            case MVM_NATIVECALL_ARG_LONG:
+                values[i].i64 = MVM_nativecall_unmarshal_long(tc, value);
+                break;
+            case MVM_NATIVECALL_ARG_LONGLONG:
+                values[i].i64 = MVM_nativecall_unmarshal_longlong(tc, value);
+                break;
+            case MVM_NATIVECALL_ARG_UCHAR:
+                values[i].i64 = MVM_nativecall_unmarshal_uchar(tc, value);
+                break;
+            case MVM_NATIVECALL_ARG_USHORT:
+                values[i].i64 = MVM_nativecall_unmarshal_ushort(tc, value);
+                break;
+            case MVM_NATIVECALL_ARG_UINT:
+                values[i].i64 = MVM_nativecall_unmarshal_uint(tc, value);
+                break;
+            case MVM_NATIVECALL_ARG_ULONG:
+                values[i].i64 = (MVMint64)MVM_nativecall_unmarshal_ulong(tc, value);
+                break;
+            case MVM_NATIVECALL_ARG_ULONGLONG:
+                values[i].i64 = (MVMint64)MVM_nativecall_unmarshal_ulonglong(tc, value);
+                break;
+            case MVM_NATIVECALL_ARG_FLOAT:
+                values[i].i64 = 0;
+                values[i].n32 = MVM_nativecall_unmarshal_float(tc, value);
+                break;
+            case MVM_NATIVECALL_ARG_DOUBLE:
+                values[i].n64 = MVM_nativecall_unmarshal_double(tc, value);
+                break;
+            case MVM_NATIVECALL_ARG_CSTRUCT:
+                values[i].i64 = (MVMint64)(uintptr_t)MVM_nativecall_unmarshal_cstruct(tc, value);
+                break;
+            case MVM_NATIVECALL_ARG_CARRAY:
+                values[i].i64 = (MVMint64)(uintptr_t)MVM_nativecall_unmarshal_carray(tc, value);
+                break;
+            case MVM_NATIVECALL_ARG_CPOINTER:
+                values[i].i64 = (MVMint64)(uintptr_t)MVM_nativecall_unmarshal_cpointer(tc, value);
+                break;
+            case MVM_NATIVECALL_ARG_CUNION:
+                values[i].i64 = (MVMint64)(uintptr_t)MVM_nativecall_unmarshal_cunion(tc, value);
+                break;
+            case MVM_NATIVECALL_ARG_VMARRAY:
+                values[i].i64 = (MVMint64)(uintptr_t)MVM_nativecall_unmarshal_vmarray(tc, value);
+                break;
+            default:
+                MVM_exception_throw_adhoc(tc, "Internal error: unhandled native call stub argument type");
+        }
+    }
+
+    /* Make the call, during which GC may run, and box the return value. The
+     * site is not used from here on. */
+    MVMROOT(tc, args, {
+    MVMROOT(tc, res_type, {
+        MVM_gc_mark_thread_blocked(tc);
+        stub->func_ptr(values, &ret);
+        MVM_gc_mark_thread_unblocked(tc);
+
+        switch (ret_type & MVM_NATIVECALL_ARG_TYPE_MASK) {
+            case MVM_NATIVECALL_ARG_VOID:
+                result = res_type;
+                break;
+            case MVM_NATIVECALL_ARG_CHAR:
+                result = MVM_nativecall_make_int(tc, res_type, (signed char)ret.i64);
+                break;
+            case MVM_NATIVECALL_ARG_SHORT:
+                result = MVM_nativecall_make_int(tc, res_type, (signed short)ret.i64);
+                break;
+            case MVM_NATIVECALL_ARG_INT:
+                result = MVM_nativecall_make_int(tc, res_type, (signed int)ret.i64);
+                break;
+            case MVM_NATIVECALL_ARG_LONG:
+                result = MVM_nativecall_make_int(tc, res_type, (signed long)ret.i64);
+                break;
+            case MVM_NATIVECALL_ARG_LONGLONG:
+                result = MVM_nativecall_make_int(tc, res_type, ret.i64);
+                break;
+            case MVM_NATIVECALL_ARG_UCHAR:
+                result = MVM_nativecall_make_uint(tc, res_type, (unsigned char)ret.i64);
+                break;
+            case MVM_NATIVECALL_ARG_USHORT:
+                result = MVM_nativecall_make_uint(tc, res_type, (unsigned short)ret.i64);
+                break;
+            case MVM_NATIVECALL_ARG_UINT:
+                result = MVM_nativecall_make_uint(tc, res_type, (unsigned int)ret.i64);
+                break;
+            case MVM_NATIVECALL_ARG_ULONG:
+                result = MVM_nativecall_make_uint(tc, res_type, (unsigned long)ret.i64);
+                break;
+            case MVM_NATIVECALL_ARG_ULONGLONG:
+                result = MVM_nativecall_make_uint(tc, res_type, (MVMuint64)ret.i64);
+                break;
+            case MVM_NATIVECALL_ARG_FLOAT:
+                result = MVM_nativecall_make_num(tc, res_type, ret.n32);
+                break;
+            case MVM_NATIVECALL_ARG_DOUBLE:
+                result = MVM_nativecall_make_num(tc, res_type, ret.n64);
+                break;
+            case MVM_NATIVECALL_ARG_ASCIISTR:
+            case MVM_NATIVECALL_ARG_UTF8STR:
+            case MVM_NATIVECALL_ARG_UTF16STR:
+                result = MVM_nativecall_make_str(tc, res_type, ret_type,
+                    (char *)(uintptr_t)ret.i64);
+                break;
+            case MVM_NATIVECALL_ARG_CSTRUCT:
+                result = MVM_nativecall_make_cstruct(tc, res_type, (void *)(uintptr_t)ret.i64);
+                break;
+            case MVM_NATIVECALL_ARG_CPOINTER:
+                result = MVM_nativecall_make_cpointer(tc, res_type, (void *)(uintptr_t)ret.i64);
+                break;
+            case MVM_NATIVECALL_ARG_CARRAY:
+                result = MVM_nativecall_make_carray(tc, res_type, (void *)(uintptr_t)ret.i64);
+                break;
+            case MVM_NATIVECALL_ARG_CUNION:
+                result = MVM_nativecall_make_cunion(tc, res_type, (void *)(uintptr_t)ret.i64);
+                break;
+            default:
+                MVM_exception_throw_adhoc(tc, "Internal error: unhandled native call stub return type");
+        }
+    });
+    });
+
+    /* Perform CArray/CStruct write barriers. */
+    MVMROOT(tc, result, {
+        for (i = 0; i < num_args; i++)
+            MVM_nativecall_refresh(tc, MVM_repr_at_pos_o(tc, args, i));
+    });
+
+    return result;
 }
 
 static MVMObject * nativecall_cast(MVMThreadContext *tc, MVMObject *target_spec, MVMObject *target_type, void *cpointer_body) {
@@ -32,6 +32,10 @@
 #define MVM_NATIVECALL_ARG_RW              256
 #define MVM_NATIVECALL_ARG_RW_MASK         256
 
+/* The most arguments a native call site can have and still be called through
+ * a JIT-compiled stub. */
+#define MVM_NATIVECALL_MAX_STUB_ARGS       16
+
 /* Native callback entry. Hung off MVMNativeCallbackCacheHead, which is
  * a hash owned by the ThreadContext. All MVMNativeCallbacks in a linked
  * list have the same cuid, which is the key to the CacheHead hash.
@@ -88,6 +92,9 @@ void MVM_nativecall_build(MVMThreadContext *tc, MVMObject *site, MVMString *lib,
     MVMString *sym, MVMString *conv, MVMObject *arg_spec, MVMObject *ret_spec);
 MVMObject * MVM_nativecall_invoke(MVMThreadContext *tc, MVMObject *res_type,
     MVMObject *site, MVMObject *args);
+MVMint32 MVM_nativecall_stub_supported(MVMThreadContext *tc, MVMNativeCallBody *body);
+MVMObject * MVM_nativecall_invoke_jit(MVMThreadContext *tc, MVMObject *res_type,
+    MVMObject *site, MVMObject *args);
 MVMObject * MVM_nativecall_global(MVMThreadContext *tc, MVMString *lib, MVMString *sym,
     MVMObject *target_spec, MVMObject *target_type);
 MVMObject * MVM_nativecall_cast(MVMThreadContext *tc, MVMObject *target_spec,
@@ -474,9 +474,14 @@ MVMObject * MVM_nativecall_invoke(MVMThreadContext *tc, MVMObject *res_type,
     MVMint16  ret_type    = body->ret_type;
     void     *entry_point = body->entry_point;
     void     *ptr         = NULL;
+    DCCallVM *vm;
+
+    /* Sites with a compiled stub don't need the call VM at all. */
+    if (body->jit_stub)
+        return MVM_nativecall_invoke_jit(tc, res_type, site, args);
 
     /* Create and set up call VM. */
-    DCCallVM *vm = dcNewCallVM(8192);
+    vm = dcNewCallVM(8192);
     dcMode(vm, body->convention);
     dcReset(vm);
 
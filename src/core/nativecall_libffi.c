@@ -474,10 +474,16 @@ MVMObject * MVM_nativecall_invoke(MVMThreadContext *tc, MVMObject *res_type,
     MVMint16 *arg_types   = body->arg_types;
     MVMint16  ret_type    = body->ret_type;
     void     *entry_point = body->entry_point;
-    void    **values      = MVM_malloc(sizeof(void *) * (num_args ? num_args : 1));
-
+    void    **values;
     ffi_cif cif;
-    ffi_status status  = ffi_prep_cif(&cif, body->convention, (unsigned int)num_args, body->ffi_ret_type, body->ffi_arg_types);
+    ffi_status status;
+
+    /* Sites with a compiled stub don't need a call interface at all. */
+    if (body->jit_stub)
+        return MVM_nativecall_invoke_jit(tc, res_type, site, args);
+
+    values = MVM_malloc(sizeof(void *) * (num_args ? num_args : 1));
+    status = ffi_prep_cif(&cif, body->convention, (unsigned int)num_args, body->ffi_ret_type, body->ffi_arg_types);
 
     /* Process arguments. */
     for (i = 0; i < num_args; i++) {
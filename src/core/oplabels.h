@@ -821,13 +821,13 @@ static const void * const LABELS[] = {
     &&OP_prof_exit,
     &&OP_prof_allocated,
     &&OP_ctw_check,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
-    NULL,
+    &&OP_queuedrain,
+    &&OP_submitwork,
+    &&OP_lockstats,
+    &&OP_gcstats,
+    &&OP_sbappend,
+    &&OP_sbchars,
+    &&OP_sbtake,
     NULL,
     NULL,
     NULL,
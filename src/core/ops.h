@@ -821,6 +821,13 @@
 #define MVM_OP_prof_exit 817
 #define MVM_OP_prof_allocated 818
 #define MVM_OP_ctw_check 819
+#define MVM_OP_queuedrain 820
+#define MVM_OP_submitwork 821
+#define MVM_OP_lockstats 822
+#define MVM_OP_gcstats 823
+#define MVM_OP_sbappend 824
+#define MVM_OP_sbchars 825
+#define MVM_OP_sbtake 826
 
 #define MVM_OP_EXT_BASE 1024
 #define MVM_OP_EXT_CU_LIMIT 1024
@@ -0,0 +1,287 @@
+#include "moar.h"
+#include <platform/threads.h>
+#include <platform/sys.h>
+
+/* Allocates deque storage of the specified size. */
+static MVMWorkerDequeArray * allocate_array(MVMThreadContext *tc, MVMint64 size) {
+    MVMWorkerDequeArray *a = MVM_fixed_size_alloc(tc, tc->instance->fsa,
+        sizeof(MVMWorkerDequeArray) + (size - 1) * sizeof(MVMObject *));
+    a->size = size;
+    return a;
+}
+
+/* Replaces a worker's full deque storage with one twice the size. Thieves
+ * may still be reading the old one, so it is freed at the next safepoint. */
+static MVMWorkerDequeArray * grow_deque(MVMThreadContext *tc, MVMWorker *worker,
+        MVMWorkerDequeArray *old, MVMint64 top, MVMint64 bottom) {
+    MVMWorkerDequeArray *new_array = allocate_array(tc, old->size * 2);
+    MVMint64 i;
+    for (i = top; i < bottom; i++)
+        new_array->items[i & (new_array->size - 1)] = old->items[i & (old->size - 1)];
+    MVM_store(&worker->array, new_array);
+    MVM_fixed_size_free_at_safepoint(tc, tc->instance->fsa,
+        sizeof(MVMWorkerDequeArray) + (old->size - 1) * sizeof(MVMObject *), old);
+    return new_array;
+}
+
+/* Pushes an item onto the bottom of a worker's deque. Must only be called
+ * by the worker that owns the deque. */
+static void deque_push(MVMThreadContext *tc, MVMWorker *worker, MVMObject *item) {
+    MVMint64 bottom = (MVMint64)MVM_load(&worker->bottom);
+    MVMint64 top    = (MVMint64)MVM_load(&worker->top);
+    MVMWorkerDequeArray *a = worker->array;
+    if (bottom - top >= a->size)
+        a = grow_deque(tc, worker, a, top, bottom);
+    a->items[bottom & (a->size - 1)] = item;
+    MVM_store(&worker->bottom, bottom + 1);
+}
+
+/* Pops an item from the bottom of a worker's deque, returning NULL if it is
+ * empty. Must only be called by the worker that owns the deque. */
+static MVMObject * deque_pop(MVMThreadContext *tc, MVMWorker *worker) {
+    MVMWorkerDequeArray *a = worker->array;
+    MVMint64 bottom = (MVMint64)MVM_load(&worker->bottom) - 1;
+    MVMint64 top;
+    MVMObject *item = NULL;
+
+    /* Claim the bottom item before looking at top, so a thief can't take
+     * it from under us unless it's the last one. */
+    MVM_store(&worker->bottom, bottom);
+    top = (MVMint64)MVM_load(&worker->top);
+    if (top <= bottom) {
+        item = a->items[bottom & (a->size - 1)];
+        if (top == bottom) {
+            /* Last item; race thieves for it. */
+            if (!MVM_trycas(&worker->top, top, top + 1))
+                item = NULL;
+            MVM_store(&worker->bottom, bottom + 1);
+        }
+    }
+    else {
+        MVM_store(&worker->bottom, bottom + 1);
+    }
+    return item;
+}
+
+/* Tries to steal an item from the top of another worker's deque. Returns
+ * NULL if it is empty or we lost a race for the item. */
+static MVMObject * deque_steal(MVMThreadContext *tc, MVMWorker *victim) {
+    MVMint64 top    = (MVMint64)MVM_load(&victim->top);
+    MVMint64 bottom = (MVMint64)MVM_load(&victim->bottom);
+    if (top < bottom) {
+        MVMWorkerDequeArray *a = (MVMWorkerDequeArray *)MVM_load(&victim->array);
+        MVMObject *item = a->items[top & (a->size - 1)];
+        if (MVM_trycas(&victim->top, top, top + 1))
+            return item;
+    }
+    return NULL;
+}
+
+/* Looks for work: first in our own deque, then in the injection queue, and
+ * then by stealing from other workers. Returns NULL if none was found. */
+static MVMObject * find_work(MVMThreadContext *tc, MVMWorker *worker) {
+    MVMWorkerPool *pool = worker->pool;
+    MVMObject *item;
+    MVMuint32 i;
+
+    if ((item = deque_pop(tc, worker)))
+        return item;
+
+    item = MVM_conclockfreequeue_poll(tc, (MVMConcLockFreeQueue *)pool->inject_queue);
+    if (!MVM_is_null(tc, item))
+        return item;
+
+    for (i = 1; i < pool->num_workers; i++) {
+        MVMWorker *victim = &(pool->workers[(worker->index + i) % pool->num_workers]);
+        if ((item = deque_steal(tc, victim)))
+            return item;
+    }
+
+    return NULL;
+}
+
+/* Waits until there's some work for a worker to do, and takes it. */
+static MVMObject * wait_for_work(MVMThreadContext *tc, MVMWorker *worker) {
+    MVMWorkerPool *pool = worker->pool;
+    MVMuint32 spins = 0;
+    while (1) {
+        MVMObject *item = find_work(tc, worker);
+        if (item) {
+            MVM_decr(&pool->pending);
+            return item;
+        }
+
+        /* Nothing; spin a little, since more work often arrives shortly. */
+        if (spins++ < MVM_WORKER_SPIN_LIMIT) {
+            GC_SYNC_POINT(tc);
+            MVM_platform_thread_yield();
+            continue;
+        }
+
+        /* Park until there's work pending somewhere. We register as parked
+         * before checking, and submitters bump pending before checking for
+         * parked workers, so a wake-up can't be lost. */
+        MVM_gc_mark_thread_blocked(tc);
+        uv_mutex_lock(&pool->park_lock);
+        MVM_incr(&pool->num_parked);
+        while (MVM_load(&pool->pending) == 0)
+            uv_cond_wait(&pool->park_cond, &pool->park_lock);
+        MVM_decr(&pool->num_parked);
+        uv_mutex_unlock(&pool->park_lock);
+        MVM_gc_mark_thread_unblocked(tc);
+        spins = 0;
+    }
+}
+
+/* Sets up the invocation of a task as the entry frame of an interpreter
+ * run, so the run ends when the task returns. */
+static void task_initial_invoke(MVMThreadContext *tc, void *data) {
+    MVMObject *invokee = MVM_frame_find_invokee(tc, *((MVMObject **)data), NULL);
+    STABLE(invokee)->invoke(tc, invokee, MVM_callsite_get_common(tc, MVM_CALLSITE_ID_NULL_ARGS), NULL);
+    tc->thread_entry_frame = tc->cur_frame;
+}
+
+/* The body of a worker thread; takes work and runs it, forever. */
+static void worker_main(MVMThreadContext *tc, MVMCallsite *callsite, MVMRegister *args) {
+    MVMWorker *worker = tc->worker;
+    while (1) {
+        MVMObject *task = wait_for_work(tc, worker);
+        if (REPR(task)->ID == MVM_REPR_ID_MVMCFunction) {
+            ((MVMCFunction *)task)->body.func(tc,
+                MVM_callsite_get_common(tc, MVM_CALLSITE_ID_NULL_ARGS), NULL);
+        }
+        else {
+            /* Pop back to the roots we had before, in case the task left
+             * any behind, but not past them. */
+            MVMuint32 num_temproots = tc->num_temproots;
+            MVM_gc_root_temp_push(tc, (MVMCollectable **)&task);
+            MVM_interp_run(tc, task_initial_invoke, &task);
+            if (tc->num_temproots > num_temproots)
+                MVM_gc_root_temp_pop_n(tc, tc->num_temproots - num_temproots);
+        }
+    }
+}
+
+/* Works out how many workers to have; the MVM_WORKER_THREADS environment
+ * variable overrides the default of one per CPU core. */
+static MVMuint32 worker_count(void) {
+    char *env = getenv("MVM_WORKER_THREADS");
+    MVMint64 count = env ? atoll(env) : 0;
+    if (count < 1)
+        count = MVM_platform_cpu_count();
+    return count < 1 ? 1 : (MVMuint32)count;
+}
+
+/* Gets the worker pool, creating it and starting its threads if needed. */
+static MVMWorkerPool * get_or_vivify_pool(MVMThreadContext *tc) {
+    MVMInstance *instance = tc->instance;
+    MVMWorkerPool *pool = (MVMWorkerPool *)MVM_load(&instance->worker_pool);
+    if (pool)
+        return pool;
+
+    /* Grab starting mutex and ensure we didn't lose the race. */
+    MVM_gc_mark_thread_blocked(tc);
+    uv_mutex_lock(&instance->mutex_worker_pool_start);
+    MVM_gc_mark_thread_unblocked(tc);
+    pool = (MVMWorkerPool *)MVM_load(&instance->worker_pool);
+    if (!pool) {
+        MVMObject *queue_type;
+        MVMuint32 i;
+        int init_stat;
+
+        pool = MVM_calloc(1, sizeof(MVMWorkerPool));
+        if ((init_stat = uv_mutex_init(&pool->park_lock)) < 0 ||
+                (init_stat = uv_cond_init(&pool->park_cond)) < 0) {
+            uv_mutex_unlock(&instance->mutex_worker_pool_start);
+            MVM_exception_throw_adhoc(tc, "Failed to initialize worker pool: %s",
+                uv_strerror(init_stat));
+        }
+
+        /* The pool isn't visible to the GC until we publish it, so keep the
+         * injection queue rooted while we allocate the worker threads. */
+        MVM_gc_root_temp_push(tc, (MVMCollectable **)&pool->inject_queue);
+        queue_type = MVM_repr_get_by_id(tc, MVM_REPR_ID_ConcLockFreeQueue)->type_object_for(tc, NULL);
+        pool->inject_queue = MVM_repr_alloc_init(tc, queue_type);
+
+        pool->num_workers = worker_count();
+        pool->workers = MVM_calloc(pool->num_workers, sizeof(MVMWorker));
+        for (i = 0; i < pool->num_workers; i++) {
+            MVMWorker *worker = &(pool->workers[i]);
+            MVMObject *runner, *thread;
+            worker->pool  = pool;
+            worker->index = i;
+            worker->array = allocate_array(tc, MVM_WORKER_DEQUE_INITIAL_SIZE);
+            runner = MVM_repr_alloc_init(tc, instance->boot_types.BOOTCCode);
+            ((MVMCFunction *)runner)->body.func = worker_main;
+            thread = MVM_thread_new(tc, runner, 1);
+            worker->tc = ((MVMThread *)thread)->body.tc;
+            worker->tc->worker = worker;
+            MVMROOT(tc, thread, {
+                MVM_thread_run(tc, thread);
+            });
+        }
+
+        MVM_store(&instance->worker_pool, pool);
+        MVM_gc_root_temp_pop(tc);
+    }
+    uv_mutex_unlock(&instance->mutex_worker_pool_start);
+
+    return pool;
+}
+
+/* Submits an invokable to be run, with no arguments, on a worker thread.
+ * Work submitted by a worker goes on its own deque, so related work tends
+ * to stay on one thread unless others are idle; anything else goes via the
+ * injection queue. */
+void MVM_scheduler_submit(MVMThreadContext *tc, MVMObject *invokee) {
+    MVMWorkerPool *pool;
+
+    if (!IS_CONCRETE(invokee) || !STABLE(invokee)->invoke)
+        MVM_exception_throw_adhoc(tc, "submitwork requires an invokable object");
+
+    MVMROOT(tc, invokee, {
+        pool = get_or_vivify_pool(tc);
+    });
+
+    /* Count it as pending first, so a worker that finds it can't make the
+     * count go below zero. */
+    MVM_incr(&pool->pending);
+    if (tc->worker && tc->worker->pool == pool)
+        deque_push(tc, tc->worker, invokee);
+    else
+        MVM_repr_push_o(tc, pool->inject_queue, invokee);
+
+    /* Wake a parked worker, if there is one. */
+    if (MVM_load(&pool->num_parked)) {
+        MVM_gc_mark_thread_blocked(tc);
+        uv_mutex_lock(&pool->park_lock);
+        MVM_gc_mark_thread_unblocked(tc);
+        uv_cond_signal(&pool->park_cond);
+        uv_mutex_unlock(&pool->park_lock);
+    }
+}
+
+/* Marks the work held in the pool's deques and its injection queue. Called
+ * with the world stopped. */
+void MVM_scheduler_gc_mark(MVMThreadContext *tc, MVMWorkerPool *pool, MVMGCWorklist *worklist,
+        MVMHeapSnapshotState *snapshot) {
+    MVMuint32 i;
+    if (worklist)
+        MVM_gc_worklist_add(tc, worklist, &(pool->inject_queue));
+    else
+        MVM_profile_heap_add_collectable_rel_const_cstr(tc, snapshot,
+            (MVMCollectable *)pool->inject_queue, "Worker pool injection queue");
+    for (i = 0; i < pool->num_workers; i++) {
+        MVMWorker           *worker = &(pool->workers[i]);
+        MVMWorkerDequeArray *a      = worker->array;
+        MVMint64             bottom = (MVMint64)worker->bottom;
+        MVMint64             j;
+        for (j = (MVMint64)worker->top; j < bottom; j++) {
+            if (worklist)
+                MVM_gc_worklist_add(tc, worklist, &(a->items[j & (a->size - 1)]));
+            else
+                MVM_profile_heap_add_collectable_rel_const_cstr(tc, snapshot,
+                    (MVMCollectable *)a->items[j & (a->size - 1)], "Worker deque entry");
+        }
+    }
+}
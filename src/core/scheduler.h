@@ -0,0 +1,65 @@
+/* The VM's work-stealing scheduler runs invokables submitted to it on a pool
+ * of worker threads. Each worker has its own Chase-Lev deque: the owner
+ * pushes and pops at the bottom without any atomic read-modify-write in the
+ * common case, while idle workers steal from the top. Work submitted from a
+ * thread that is not a worker goes into a shared lock-free injection queue.
+ * Workers with nothing to do spin briefly and then park, marked as blocked
+ * so they do not hold up GC. */
+
+/* Initial number of slots in a worker's deque; must be a power of 2. */
+#define MVM_WORKER_DEQUE_INITIAL_SIZE 64
+
+/* How many rounds of looking for work we do before parking. */
+#define MVM_WORKER_SPIN_LIMIT 64
+
+/* The storage of a worker deque; replaced by a bigger one when full. */
+struct MVMWorkerDequeArray {
+    /* Number of slots; always a power of 2. */
+    MVMint64 size;
+
+    /* The slots themselves. */
+    MVMObject *items[1];
+};
+
+/* A worker thread in the pool. */
+struct MVMWorker {
+    /* The pool the worker belongs to, and its index in it. */
+    MVMWorkerPool *pool;
+    MVMuint32 index;
+
+    /* The thread context of the worker. */
+    MVMThreadContext *tc;
+
+    /* Deque indexes. Thieves take from top, the owner works at bottom. Kept
+     * apart to avoid false sharing. Treated as signed values. */
+    AO_t top;
+    char pad_top[64 - sizeof(AO_t)];
+    AO_t bottom;
+    char pad_bottom[64 - sizeof(AO_t)];
+
+    /* The deque storage. Only the owner replaces it. */
+    MVMWorkerDequeArray *array;
+};
+
+/* The pool of workers. */
+struct MVMWorkerPool {
+    /* The workers. */
+    MVMWorker *workers;
+    MVMuint32  num_workers;
+
+    /* Queue (a ConcLockFreeQueue) of work submitted from threads that are
+     * not workers. */
+    MVMObject *inject_queue;
+
+    /* Number of submitted tasks that have not yet been taken by a worker. */
+    AO_t pending;
+
+    /* Parking for idle workers. */
+    AO_t       num_parked;
+    uv_mutex_t park_lock;
+    uv_cond_t  park_cond;
+};
+
+void MVM_scheduler_submit(MVMThreadContext *tc, MVMObject *invokee);
+void MVM_scheduler_gc_mark(MVMThreadContext *tc, MVMWorkerPool *pool, MVMGCWorklist *worklist,
+    MVMHeapSnapshotState *snapshot);
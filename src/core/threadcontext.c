@@ -58,6 +58,9 @@ void MVM_tc_destroy(MVMThreadContext *tc) {
     /* We run once again (non-blocking) to eventually close filehandles. */
     uv_run(tc->loop, UV_RUN_NOWAIT);
 
+    /* Stop the sampling profiler from flagging us. */
+    MVM_profile_sampling_thread_gone(tc);
+
     /* Free the nursery and finalization queue. */
     MVM_free(tc->nursery_fromspace);
     MVM_free(tc->nursery_tospace);
@@ -83,6 +86,9 @@ void MVM_tc_destroy(MVMThreadContext *tc) {
     MVM_free(tc->nfa_longlit);
     MVM_free(tc->multi_dim_indices);
 
+    /* Free the NFG synthetics cache. */
+    MVM_free(tc->nfg_cache);
+
     /* Free per-thread lexotic cache. */
     MVM_free(tc->lexotic_cache);
 
@@ -44,6 +44,10 @@ struct MVMThreadContext {
     /* This thread's GC status. */
     AO_t gc_status;
 
+    /* Set by the sampling profiler when it wants this thread to record its
+     * call stack at the next sync point. */
+    AO_t sample_pending;
+
     /* Non-zero is we should allocate in gen2; incremented/decremented as we
      * enter/leave a region wanting gen2 allocation. */
     MVMuint32 allocate_in_gen2;
@@ -74,6 +78,13 @@ struct MVMThreadContext {
     /* Current call stack region, which the next frame will be allocated in. */
     MVMCallStackRegion *stack_current;
 
+    /* Bytes of call stack regions currently allocated and the most there have
+     * been at once, along with how many regions were allocated and freed. */
+    MVMuint64 stack_reserved;
+    MVMuint64 stack_max_reserved;
+    MVMuint64 stack_regions_allocated;
+    MVMuint64 stack_regions_freed;
+
     /* The frame we're currently executing. */
     MVMFrame *cur_frame;
 
@@ -83,6 +94,9 @@ struct MVMThreadContext {
     /* libuv event loop */
     uv_loop_t *loop;
 
+    /* If this thread is a scheduler worker, its worker record. */
+    MVMWorker *worker;
+
     /* The usecapture op can, without allocating, have a way to talk about the
      * arguments of the current call. This is the (pre-thread) object that is
      * used by that op. */
@@ -120,6 +134,9 @@ struct MVMThreadContext {
     /* Number of bytes promoted to gen2 in current GC run. */
     MVMuint32 gc_promoted_bytes;
 
+    /* GC telemetry for this thread. */
+    MVMGCStats gc_stats;
+
     /* Memory buffer pointing to the last thing we serialized, intended to go
      * into the next compilation unit we write. Also the serialized string
      * heap, which will be used to seed the compilation unit string heap. */
@@ -207,12 +224,18 @@ struct MVMThreadContext {
     MVMint64 *multi_dim_indices;
     MVMint64  num_multi_dim_indices;
 
+    /* Cache of recently looked up NFG synthetics; see nfg.c. */
+    MVMNFGCacheEntry *nfg_cache;
+
     /* The number of locks the thread is holding. */
     MVMint64 num_locks;
 
     /* Profiling data collected for this thread, if profiling is on. */
     MVMProfileThreadData *prof_data;
 
+    /* Buffer for samples taken by the sampling profiler, if it is on. */
+    MVMProfileSampleBuffer *sample_buffer;
+
     /* Frame sequence numbers in order to cheaply identify the place of a frame
      * in the call stack */
     MVMint32 current_frame_nr;
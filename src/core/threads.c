@@ -73,6 +73,9 @@ static void start_thread(void *data) {
     MVM_gc_mark_thread_unblocked(tc);
     tc->thread_obj->body.stage = MVM_thread_stage_started;
 
+    /* Get sampled, if the sampling profiler is on. */
+    MVM_profile_sampling_thread_start(tc);
+
     /* Enter the interpreter, to run code. */
     MVM_interp_run(tc, thread_initial_invoke, ts);
 
@@ -119,11 +122,15 @@ void MVM_thread_run(MVMThreadContext *tc, MVMObject *thread_obj) {
         MVM_gc_mark_thread_blocked(child_tc);
 
         /* Push to starting threads list */
+        MVM_gc_mark_thread_blocked(tc);
+        uv_mutex_lock(&tc->instance->mutex_threads);
+        MVM_gc_mark_thread_unblocked(tc);
         threads = &tc->instance->threads;
         do {
             MVMThread *curr = *threads;
             MVM_ASSIGN_REF(tc, &(child->common.header), child->body.next, curr);
         } while (MVM_casptr(threads, child->body.next, child) != child->body.next);
+        uv_mutex_unlock(&tc->instance->mutex_threads);
 
         /* Do the actual thread creation. */
         status = uv_thread_create(&child->body.thread, start_thread, ts);
@@ -610,6 +610,14 @@ void MVM_gc_collect_free_gen2_unmarked(MVMThreadContext *tc, MVMint32 global_des
     MVMGen2Allocator *gen2 = tc->gen2;
     MVMuint32 bin, obj_size, page, i;
     char ***freelist_insert_pos;
+
+    /* If we're gathering string storage statistics, start counting afresh. */
+    MVMint32 count_strings = tc->instance->gc_string_stats && !global_destruction;
+    if (count_strings) {
+        memset(tc->gc_stats.string_storage_counts, 0, sizeof(tc->gc_stats.string_storage_counts));
+        memset(tc->gc_stats.string_storage_bytes, 0, sizeof(tc->gc_stats.string_storage_bytes));
+    }
+
     for (bin = 0; bin < MVM_GEN2_BINS; bin++) {
         /* If we've nothing allocated in this size class, skip it. */
         if (gen2->size_classes[bin].pages == NULL)
@@ -645,6 +653,11 @@ void MVM_gc_collect_free_gen2_unmarked(MVMThreadContext *tc, MVMint32 global_des
                 else if (col->flags & MVM_CF_GEN2_LIVE) {
                     /* Yes; clear the mark. */
                     col->flags &= ~MVM_CF_GEN2_LIVE;
+
+                    /* Count it if it's a string and we're gathering stats. */
+                    if (count_strings && !(col->flags & (MVM_CF_TYPE_OBJECT | MVM_CF_STABLE | MVM_CF_FRAME))
+                            && REPR((MVMObject *)col)->ID == MVM_REPR_ID_MVMString)
+                        MVM_gc_stats_count_string(tc, (MVMString *)col);
                 }
                 else {
                     GCDEBUG_LOG(tc, MVM_GC_DEBUG_COLLECT, "Thread %d run %d : collecting an object %p in the gen2\n", col);
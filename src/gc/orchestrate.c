@@ -156,8 +156,9 @@ static void finish_gc(MVMThreadContext *tc, MVMuint8 gen, MVMuint8 is_coordinato
      * that needs adding to the finalize queue. It then will make another
      * iteration over in-trays to handle cross-thread references to objects
      * needing finalization. For full collections, collected objects are then
-     * cleaned from all inter-generational sets, and finally any objects to
-     * be freed at the fixed size allocator's next safepoint are freed. */
+     * cleaned from all inter-generational sets and the string intern table,
+     * and finally any objects to be freed at the fixed size allocator's next
+     * safepoint are freed. */
     if (is_coordinator) {
         GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE,
             "Thread %d run %d : Co-ordinator handling in-tray clearing completion\n");
@@ -177,6 +178,10 @@ static void finish_gc(MVMThreadContext *tc, MVMuint8 gen, MVMuint8 is_coordinato
                     MVM_gc_root_gen2_cleanup(cur_thread->body.tc);
                 cur_thread = cur_thread->body.next;
             }
+
+            GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE,
+                "Thread %d run %d : Co-ordinator handling string intern table cleanup\n");
+            MVM_string_intern_gc_cleanup(tc);
         }
 
         GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE,
@@ -345,6 +350,8 @@ static void run_gc(MVMThreadContext *tc, MVMuint8 what_to_do) {
 
         /* Contribute this thread's promoted bytes. */
         MVM_add(&tc->instance->gc_promoted_bytes_since_last_full, other->gc_promoted_bytes);
+        MVM_add(&tc->instance->gc_stats.promoted_bytes, other->gc_promoted_bytes);
+        other->gc_stats.promoted_bytes += other->gc_promoted_bytes;
 
         /* Collect nursery and gen2 as needed. */
         GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE,
@@ -371,6 +378,8 @@ void MVM_gc_enter_from_allocator(MVMThreadContext *tc) {
     if (MVM_trycas(&tc->instance->gc_start, 0, 1)) {
         MVMThread *last_starter = NULL;
         MVMuint32 num_threads = 0;
+        MVMuint64 start_time = uv_hrtime();
+        MVMuint64 pause;
 
         /* Need to wait for other threads to reset their gc_status. */
         while (MVM_load(&tc->instance->gc_ack)) {
@@ -462,6 +471,11 @@ void MVM_gc_enter_from_allocator(MVMThreadContext *tc) {
         GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE, "Thread %d run %d : coordinator entering run_gc\n");
         run_gc(tc, MVMGCWhatToDo_All);
 
+        /* Record the pause, both for ourselves and for the run as a whole. */
+        pause = uv_hrtime() - start_time;
+        MVM_gc_stats_record_pause(tc, &tc->gc_stats, pause, tc->instance->gc_full_collect);
+        MVM_gc_stats_record_pause(tc, &tc->instance->gc_stats, pause, tc->instance->gc_full_collect);
+
         /* If profiling, record that GC is over. */
         if (tc->instance->profiling)
             MVM_profiler_log_gc_end(tc);
@@ -481,6 +495,7 @@ void MVM_gc_enter_from_allocator(MVMThreadContext *tc) {
  * try and do that, just enlist in the run. */
 void MVM_gc_enter_from_interrupt(MVMThreadContext *tc) {
     AO_t curr;
+    MVMuint64 start_time = uv_hrtime();
 
     GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE, "Thread %d run %d : Entered from interrupt\n");
 
@@ -511,6 +526,10 @@ void MVM_gc_enter_from_interrupt(MVMThreadContext *tc) {
     run_gc(tc, MVMGCWhatToDo_NoInstance);
     GCDEBUG_LOG(tc, MVM_GC_DEBUG_ORCHESTRATE, "Thread %d run %d : GC complete\n");
 
+    /* Record how long we were paused for. */
+    MVM_gc_stats_record_pause(tc, &tc->gc_stats, uv_hrtime() - start_time,
+        tc->instance->gc_full_collect);
+
     /* If profiling, record that GC is over. */
     if (tc->instance->profiling)
         MVM_profiler_log_gc_end(tc);
@@ -69,7 +69,8 @@ void MVM_gc_root_add_instance_roots_to_worklist(MVMThreadContext *tc, MVMGCWorkl
     MVMLoadedCompUnitName       *current_lcun, *tmp_lcun;
     unsigned                     bucket_tmp;
     MVMString                  **int_to_str_cache;
-    MVMuint32                    i;
+    MVMIntConstCache            *int_const_cache;
+    MVMuint32                    i, j;
 
     add_collectable(tc, worklist, snapshot, tc->instance->threads, "Thread list");
     add_collectable(tc, worklist, snapshot, tc->instance->compiler_registry, "Compiler registry");
@@ -78,12 +79,27 @@ void MVM_gc_root_add_instance_roots_to_worklist(MVMThreadContext *tc, MVMGCWorkl
     add_collectable(tc, worklist, snapshot, tc->instance->event_loop_todo_queue, "Event loop todo queue");
     add_collectable(tc, worklist, snapshot, tc->instance->event_loop_cancel_queue, "Event loop cancel queue");
     add_collectable(tc, worklist, snapshot, tc->instance->event_loop_active, "Event loop active");
+    if (tc->instance->worker_pool)
+        MVM_scheduler_gc_mark(tc, tc->instance->worker_pool, worklist, snapshot);
+    if (worklist)
+        MVM_profile_sampling_mark_data(tc, worklist);
 
     int_to_str_cache = tc->instance->int_to_str_cache;
     for (i = 0; i < MVM_INT_TO_STR_CACHE_SIZE; i++)
         add_collectable(tc, worklist, snapshot, int_to_str_cache[i],
             "Integer to string cache entry");
 
+    int_const_cache = tc->instance->int_const_cache;
+    for (i = 0; i < MVM_INTCACHE_TYPES; i++) {
+        if (int_const_cache->cache[i]) {
+            add_collectable(tc, worklist, snapshot, int_const_cache->types[i],
+                "Boxed integer cache type");
+            for (j = 0; j < MVM_INTCACHE_SIZE; j++)
+                add_collectable(tc, worklist, snapshot, int_const_cache->cache[i][j],
+                    "Boxed integer cache entry");
+        }
+    }
+
     /* okay, so this makes the weak hash slightly less weak.. for certain
      * keys of it anyway... */
     HASH_ITER(hash_handle, tc->instance->sc_weakhash, current, tmp, bucket_tmp) {
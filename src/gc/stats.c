@@ -0,0 +1,201 @@
+#include "moar.h"
+
+/* Records a GC pause of the given length in nanoseconds. */
+void MVM_gc_stats_record_pause(MVMThreadContext *tc, MVMGCStats *stats, MVMuint64 pause,
+                               MVMuint32 full) {
+    MVMuint64 us     = pause / 1000;
+    MVMuint32 bucket = 0;
+    while (us && bucket < MVM_GC_STATS_PAUSE_BUCKETS - 1) {
+        us >>= 1;
+        bucket++;
+    }
+    if (full)
+        stats->full_collections++;
+    else
+        stats->nursery_collections++;
+    stats->pause_total += pause;
+    if (pause > stats->pause_max)
+        stats->pause_max = pause;
+    stats->pause_histogram[bucket]++;
+}
+
+/* Counts a live string by its storage type; called during the gen2 sweep
+ * when MVM_GC_STRING_STATS is set. */
+void MVM_gc_stats_count_string(MVMThreadContext *tc, MVMString *s) {
+    MVMuint16 type = s->body.storage_type;
+    MVMuint64 bytes;
+    if (type >= MVM_GC_STATS_STRING_STORAGE_TYPES)
+        return;
+    switch (type) {
+    case MVM_STRING_GRAPHEME_32:
+        bytes = (MVMuint64)s->body.num_graphs * sizeof(MVMGrapheme32);
+        break;
+    case MVM_STRING_STRAND:
+        bytes = (MVMuint64)s->body.num_strands * sizeof(MVMStringStrand);
+        break;
+    default:
+        bytes = (MVMuint64)s->body.num_graphs * sizeof(MVMGrapheme8);
+        break;
+    }
+    tc->gc_stats.string_storage_counts[type]++;
+    tc->gc_stats.string_storage_bytes[type] += bytes;
+}
+
+/* A copy of the figures for a thread or the instance, taken before we start
+ * allocating the result. */
+typedef struct {
+    MVMuint32  thread_id;
+    MVMGCStats stats;
+    MVMuint64  gen2_bytes[MVM_GEN2_BINS];
+    MVMuint64  gen2_overflows;
+    MVMuint64  finalize_queue;
+    MVMuint64  finalizing;
+    MVMuint64  heap_promotions;
+    MVMuint64  frames_promoted;
+    MVMuint64  stack_reserved;
+    MVMuint64  stack_max_reserved;
+    MVMuint64  stack_regions_allocated;
+    MVMuint64  stack_regions_freed;
+    MVMuint64  string_storage_counts[MVM_GC_STATS_STRING_STORAGE_TYPES];
+    MVMuint64  string_storage_bytes[MVM_GC_STATS_STRING_STORAGE_TYPES];
+} StatsCopy;
+
+/* Adds a thread's figures to a copy. */
+static void copy_thread(MVMThreadContext *tc, MVMThreadContext *thread_tc, StatsCopy *copy) {
+    MVMuint32 i;
+    for (i = 0; i < MVM_GEN2_BINS; i++)
+        copy->gen2_bytes[i] += (MVMuint64)thread_tc->gen2->size_classes[i].num_pages *
+            MVM_GEN2_PAGE_ITEMS * ((i + 1) << MVM_GEN2_BIN_BITS);
+    copy->gen2_overflows += thread_tc->gen2->num_overflows;
+    copy->finalize_queue += thread_tc->num_finalize;
+    copy->finalizing     += thread_tc->num_finalizing;
+    copy->heap_promotions += thread_tc->gc_stats.heap_promotions;
+    copy->frames_promoted += thread_tc->gc_stats.frames_promoted;
+    copy->stack_reserved          += thread_tc->stack_reserved;
+    copy->stack_max_reserved      += thread_tc->stack_max_reserved;
+    copy->stack_regions_allocated += thread_tc->stack_regions_allocated;
+    copy->stack_regions_freed     += thread_tc->stack_regions_freed;
+    for (i = 0; i < MVM_GC_STATS_STRING_STORAGE_TYPES; i++) {
+        copy->string_storage_counts[i] += thread_tc->gc_stats.string_storage_counts[i];
+        copy->string_storage_bytes[i]  += thread_tc->gc_stats.string_storage_bytes[i];
+    }
+}
+
+/* Helpers for building the result; they keep the hash rooted. */
+static void add_obj(MVMThreadContext *tc, MVMObject *hash, const char *name, MVMObject *value) {
+    MVMROOT(tc, hash, {
+        MVMROOT(tc, value, {
+            MVMString *key = MVM_string_ascii_decode_nt(tc, tc->instance->VMString, name);
+            MVM_repr_bind_key_o(tc, hash, key, value);
+        });
+    });
+}
+static void add_int(MVMThreadContext *tc, MVMObject *hash, const char *name, MVMuint64 value) {
+    MVMObject *boxed;
+    MVMROOT(tc, hash, {
+        boxed = MVM_repr_box_int(tc, tc->instance->boot_types.BOOTInt, (MVMint64)value);
+    });
+    add_obj(tc, hash, name, boxed);
+}
+static void add_int_array(MVMThreadContext *tc, MVMObject *hash, const char *name,
+                          MVMuint64 *values, MVMuint32 num_values) {
+    MVMObject *arr;
+    MVMuint32  i;
+    MVMROOT(tc, hash, {
+        arr = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTIntArray);
+    });
+    for (i = 0; i < num_values; i++)
+        MVM_repr_push_i(tc, arr, (MVMint64)values[i]);
+    add_obj(tc, hash, name, arr);
+}
+static MVMObject * copy_to_hash(MVMThreadContext *tc, StatsCopy *copy, MVMint32 is_thread) {
+    MVMObject *hash = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTHash);
+    if (is_thread)
+        add_int(tc, hash, "thread_id", copy->thread_id);
+    add_int(tc, hash, "nursery_collections", copy->stats.nursery_collections);
+    add_int(tc, hash, "full_collections", copy->stats.full_collections);
+    add_int(tc, hash, "pause_total_ns", copy->stats.pause_total);
+    add_int(tc, hash, "pause_max_ns", copy->stats.pause_max);
+    add_int_array(tc, hash, "pause_histogram", copy->stats.pause_histogram,
+        MVM_GC_STATS_PAUSE_BUCKETS);
+    add_int(tc, hash, "promoted_bytes", copy->stats.promoted_bytes);
+    add_int_array(tc, hash, "gen2_bytes", copy->gen2_bytes, MVM_GEN2_BINS);
+    add_int(tc, hash, "gen2_overflows", copy->gen2_overflows);
+    add_int(tc, hash, "finalize_queue", copy->finalize_queue);
+    add_int(tc, hash, "finalizing", copy->finalizing);
+    add_int(tc, hash, "heap_promotions", copy->heap_promotions);
+    add_int(tc, hash, "frames_promoted", copy->frames_promoted);
+    add_int(tc, hash, "callstack_bytes", copy->stack_reserved);
+    add_int(tc, hash, "callstack_max_bytes", copy->stack_max_reserved);
+    add_int(tc, hash, "callstack_regions_allocated", copy->stack_regions_allocated);
+    add_int(tc, hash, "callstack_regions_freed", copy->stack_regions_freed);
+    if (tc->instance->gc_string_stats) {
+        add_int_array(tc, hash, "string_storage_counts", copy->string_storage_counts,
+            MVM_GC_STATS_STRING_STORAGE_TYPES);
+        add_int_array(tc, hash, "string_storage_bytes", copy->string_storage_bytes,
+            MVM_GC_STATS_STRING_STORAGE_TYPES);
+    }
+    return hash;
+}
+
+/* Gets a hash of the GC statistics of the instance, with an array of hashes
+ * of the statistics of each of its threads under the "threads" key. The gen2
+ * sizes are the space in pages allocated per size class, whether in use or
+ * not. The frame promotion counts and call stack figures of the instance are
+ * the sums over its threads; for the most call stack memory, that is the sum
+ * of each thread's most rather than the most at any one time. If the
+ * MVM_GC_STRING_STATS environment variable is set, there are also counts and
+ * storage sizes of the strings in gen2 that were live at the last full
+ * collection, indexed by storage type (32-bit, ASCII, 8-bit, strands);
+ * strings still in the nursery are not counted. */
+MVMObject * MVM_gc_stats(MVMThreadContext *tc) {
+    StatsCopy  instance_copy;
+    StatsCopy *thread_copies;
+    MVMuint32  num_threads = 0;
+    MVMuint32  i;
+    MVMThread *cur_thread;
+    MVMObject *result;
+    MVMObject *threads;
+
+    /* Take copies of everything first; we must not allocate while walking
+     * the threads, since a GC run could free thread contexts. */
+    cur_thread = (MVMThread *)MVM_load(&tc->instance->threads);
+    while (cur_thread) {
+        if (cur_thread->body.tc)
+            num_threads++;
+        cur_thread = cur_thread->body.next;
+    }
+    thread_copies = MVM_calloc(num_threads ? num_threads : 1, sizeof(StatsCopy));
+    memset(&instance_copy, 0, sizeof(StatsCopy));
+    instance_copy.stats = tc->instance->gc_stats;
+    i = 0;
+    cur_thread = (MVMThread *)MVM_load(&tc->instance->threads);
+    while (cur_thread && i < num_threads) {
+        MVMThreadContext *thread_tc = cur_thread->body.tc;
+        if (thread_tc) {
+            thread_copies[i].thread_id = thread_tc->thread_id;
+            thread_copies[i].stats     = thread_tc->gc_stats;
+            copy_thread(tc, thread_tc, &(thread_copies[i]));
+            copy_thread(tc, thread_tc, &instance_copy);
+            i++;
+        }
+        cur_thread = cur_thread->body.next;
+    }
+    num_threads = i;
+
+    /* Now build the result. */
+    result = copy_to_hash(tc, &instance_copy, 0);
+    MVMROOT(tc, result, {
+        threads = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTArray);
+        MVMROOT(tc, threads, {
+            for (i = 0; i < num_threads; i++) {
+                MVMObject *thread_hash = copy_to_hash(tc, &(thread_copies[i]), 1);
+                MVM_repr_push_o(tc, threads, thread_hash);
+            }
+        });
+    });
+    add_obj(tc, result, "threads", threads);
+    MVM_free(thread_copies);
+
+    return result;
+}
@@ -0,0 +1,47 @@
+/* Always-on GC telemetry. Each thread keeps counters of the collections it
+ * took part in and how long it was paused for, and the instance keeps the
+ * same for whole GC runs as seen by the coordinator. Updating them costs a
+ * couple of clock reads per GC run, so they are kept unconditionally. */
+
+/* Number of buckets in the pause time histogram. Bucket 0 counts pauses of
+ * under a microsecond, bucket n pauses of at least 2^(n-1) and under 2^n
+ * microseconds, and the last bucket everything longer than that. */
+#define MVM_GC_STATS_PAUSE_BUCKETS  24
+
+/* Number of string storage types counted when MVM_GC_STRING_STATS is set;
+ * they are indexed by the MVM_STRING_* storage type constants. */
+#define MVM_GC_STATS_STRING_STORAGE_TYPES  4
+
+/* GC counters for a thread or the whole instance. */
+struct MVMGCStats {
+    /* Number of nursery-only and full collections. */
+    MVMuint64 nursery_collections;
+    MVMuint64 full_collections;
+
+    /* Total and longest pause, in nanoseconds. */
+    MVMuint64 pause_total;
+    MVMuint64 pause_max;
+
+    /* Histogram of pause times; see MVM_GC_STATS_PAUSE_BUCKETS. */
+    MVMuint64 pause_histogram[MVM_GC_STATS_PAUSE_BUCKETS];
+
+    /* Total bytes promoted from the nursery to gen2. Threads doing GC work
+     * for others add to the instance total concurrently, so it's atomic. */
+    AO_t promoted_bytes;
+
+    /* Number of times frames were moved from the call stack to the heap, and
+     * the total number of frames moved. Only kept per thread. */
+    MVMuint64 heap_promotions;
+    MVMuint64 frames_promoted;
+
+    /* Number of live strings in gen2 and the bytes of storage they point to,
+     * by storage type, as of the last full collection. Only gathered when
+     * MVM_GC_STRING_STATS is set, and only kept per thread. */
+    MVMuint64 string_storage_counts[MVM_GC_STATS_STRING_STORAGE_TYPES];
+    MVMuint64 string_storage_bytes[MVM_GC_STATS_STRING_STORAGE_TYPES];
+};
+
+void MVM_gc_stats_record_pause(MVMThreadContext *tc, MVMGCStats *stats, MVMuint64 pause,
+    MVMuint32 full);
+void MVM_gc_stats_count_string(MVMThreadContext *tc, MVMString *s);
+MVMObject * MVM_gc_stats(MVMThreadContext *tc);
@@ -130,8 +130,12 @@ void MVM_cross_thread_write_instrument(MVMThreadContext *tc, MVMStaticFrame *sf)
 
         /* Throw away any specializations; we'll need to reproduce them as
          * instrumented versions. */
-        sf->body.num_spesh_candidates = 0;
-        sf->body.spesh_candidates     = NULL;
+        sf->body.num_spesh_candidates         = 0;
+        sf->body.num_retired_spesh_candidates = 0;
+        sf->body.last_spesh_candidate         = 0;
+        sf->body.spesh_candidates             = NULL;
+        sf->body.replaced_spesh_candidates    = NULL;
+        memset(sf->body.spesh_dispatch, 0, sizeof(sf->body.spesh_dispatch));
     }
 }
 
@@ -143,7 +147,8 @@ static MVMint64 filtered_out(MVMThreadContext *tc, MVMObject *written) {
         return 1;
 
     /* Operations on a concurrent queue are fine 'cus it's concurrent. */
-    if (REPR(written)->ID == MVM_REPR_ID_ConcBlockingQueue)
+    if (REPR(written)->ID == MVM_REPR_ID_ConcBlockingQueue ||
+            REPR(written)->ID == MVM_REPR_ID_ConcLockFreeQueue)
         return 1;
 
     /* Write on object from event loop thread is usually shift of invokable. */
@@ -125,6 +125,49 @@ void MVM_jit_destroy_code(MVMThreadContext *tc, MVMJitCode *code) {
     MVM_free(code);
 }
 
+/* Compiles a stub calling the native function of a native call site, so that
+ * invoking it needs no generic argument marshalling. Returns NULL if the
+ * signature is not one the emitter can handle. */
+MVMJitNativeCallStub * MVM_jit_compile_nativecall_stub(MVMThreadContext *tc, MVMNativeCallBody *body) {
+    dasm_State *state;
+    char * memory;
+    size_t codesize;
+    MVMint32  num_globals;
+    void   ** dasm_globals;
+    MVMJitNativeCallStub *stub = NULL;
+
+    if (!MVM_jit_support())
+        return NULL;
+
+    num_globals  = MVM_jit_num_globals();
+    dasm_globals = MVM_malloc(num_globals * sizeof(void*));
+    dasm_init(&state, 2);
+    dasm_setupglobal(&state, dasm_globals, num_globals);
+    dasm_setup(&state, MVM_jit_actions());
+
+    if (MVM_jit_emit_nativecall_stub(tc, body, &state)) {
+        dasm_link(&state, &codesize);
+        memory = MVM_platform_alloc_pages(codesize, MVM_PAGE_READ|MVM_PAGE_WRITE);
+        dasm_encode(&state, memory);
+        MVM_platform_set_page_mode(memory, codesize, MVM_PAGE_READ|MVM_PAGE_EXEC);
+
+        stub = MVM_malloc(sizeof(MVMJitNativeCallStub));
+        stub->func_ptr = (MVMJitNativeCallFunc)memory;
+        stub->size     = codesize;
+        MVM_jit_log(tc, "Native call stub for '%s' size: %"MVM_PRSz"\n",
+            body->sym_name ? body->sym_name : "<anon>", codesize);
+    }
+
+    dasm_free(&state);
+    MVM_free(dasm_globals);
+    return stub;
+}
+
+void MVM_jit_destroy_nativecall_stub(MVMThreadContext *tc, MVMJitNativeCallStub *stub) {
+    MVM_platform_free_pages(stub->func_ptr, stub->size);
+    MVM_free(stub);
+}
+
 /* Returns 1 if we should return from the frame, the function, 0 otherwise */
 MVMint32 MVM_jit_enter_code(MVMThreadContext *tc, MVMCompUnit *cu,
                             MVMJitCode *code) {
@@ -29,8 +29,20 @@ struct MVMJitCode {
     MVMint32       seq_nr;
 };
 
+/* A stub that calls a native function directly. It reads the native
+ * arguments from consecutive registers of args and stores the native return
+ * value in result. */
+typedef void (*MVMJitNativeCallFunc)(MVMRegister *args, MVMRegister *result);
+
+struct MVMJitNativeCallStub {
+    MVMJitNativeCallFunc func_ptr;
+    size_t               size;
+};
+
 MVMJitCode* MVM_jit_compile_graph(MVMThreadContext *tc, MVMJitGraph *graph);
 void MVM_jit_destroy_code(MVMThreadContext *tc, MVMJitCode *code);
+MVMJitNativeCallStub * MVM_jit_compile_nativecall_stub(MVMThreadContext *tc, MVMNativeCallBody *body);
+void MVM_jit_destroy_nativecall_stub(MVMThreadContext *tc, MVMJitNativeCallStub *stub);
 MVMint32 MVM_jit_enter_code(MVMThreadContext *tc, MVMCompUnit *cu,
                             MVMJitCode * code);
 
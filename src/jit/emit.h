@@ -23,3 +23,5 @@ void MVM_jit_emit_control(MVMThreadContext *tc, MVMJitGraph *jg,
                           MVMJitControl *ctrl, dasm_State **Dst);
 void MVM_jit_emit_data(MVMThreadContext *tc, MVMJitGraph *jg,
                        MVMJitData *data, dasm_State **Dst);
+MVMint32 MVM_jit_emit_nativecall_stub(MVMThreadContext *tc, MVMNativeCallBody *body,
+                                      dasm_State **Dst);
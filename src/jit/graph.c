@@ -421,6 +421,13 @@ static void jgb_append_guard(MVMThreadContext *tc, JitGraphBuilder *jgb,
     jgb_append_node(jgb, node);
 }
 
+/* Records in the spesh event log that we gave up on an instruction. */
+static void log_bail(MVMThreadContext *tc, JitGraphBuilder *jgb, MVMSpeshIns *ins) {
+    if (tc->instance->spesh_event_log)
+        MVM_spesh_event_string(tc, MVM_SPESH_EVENT_JIT_BAIL, 0, jgb->sg->sf,
+            ins ? ins->info->name : "<none>");
+}
+
 static MVMint32 jgb_consume_invoke(MVMThreadContext *tc, JitGraphBuilder *jgb,
                                    MVMSpeshIns *ins) {
     MVMCompUnit       *cu = jgb->sg->sf->body.cu;
@@ -521,6 +528,7 @@ static MVMint32 jgb_consume_invoke(MVMThreadContext *tc, JitGraphBuilder *jgb,
         default:
             MVM_jit_log(tc, "Unexpected opcode in invoke sequence: <%s>\n",
                         ins->info->name);
+            log_bail(tc, jgb, ins);
             return 0;
         }
     }
@@ -529,6 +537,7 @@ static MVMint32 jgb_consume_invoke(MVMThreadContext *tc, JitGraphBuilder *jgb,
         MVM_jit_log(tc, "Could not find invoke opcode or enough arguments\n"
                     "BAIL: op <%s>, expected args: %d, num of args: %d\n",
                     ins? ins->info->name : "NULL", i, cs->arg_count);
+        log_bail(tc, jgb, ins);
         return 0;
     }
     MVM_jit_log(tc, "Invoke instruction: <%s>\n", ins->info->name);
@@ -1978,6 +1987,7 @@ static MVMint32 jgb_consume_ins(MVMThreadContext *tc, JitGraphBuilder *jgb,
     case MVM_OP_elems:
         if (!jgb_consume_reprop(tc, jgb, bb, ins)) {
             MVM_jit_log(tc, "BAIL: op <%s> (devirt attempted)\n", ins->info->name);
+            log_bail(tc, jgb, ins);
             return 0;
         }
         break;
@@ -2582,7 +2592,16 @@ static MVMint32 jgb_consume_ins(MVMThreadContext *tc, JitGraphBuilder *jgb,
                                  { MVM_JIT_REG_VAL, { restype } },
                                  { MVM_JIT_REG_VAL, { site } },
                                  { MVM_JIT_REG_VAL, { cargs } } };
-        jgb_append_call_c(tc, jgb, op_to_func(tc, op), 4, args,
+        /* If we know the call site and it has a compiled stub, call that
+         * directly rather than doing generic argument marshalling. */
+        MVMSpeshFacts *site_facts = MVM_spesh_get_facts(tc, jgb->sg, ins->operands[2]);
+        void *function = op_to_func(tc, op);
+        if (site_facts->flags & MVM_SPESH_FACT_KNOWN_VALUE && site_facts->value.o
+                && IS_CONCRETE(site_facts->value.o)
+                && REPR(site_facts->value.o)->ID == MVM_REPR_ID_MVMNativeCall
+                && ((MVMNativeCall *)site_facts->value.o)->body.jit_stub)
+            function = MVM_nativecall_invoke_jit;
+        jgb_append_call_c(tc, jgb, function, 4, args,
                           MVM_JIT_RV_PTR, dst);
         break;
     }
@@ -2775,6 +2794,7 @@ static MVMint32 jgb_consume_ins(MVMThreadContext *tc, JitGraphBuilder *jgb,
         }
         if (!emitted_extop) {
             MVM_jit_log(tc, "BAIL: op <%s>\n", ins->info->name);
+            log_bail(tc, jgb, ins);
             return 0;
         }
     }
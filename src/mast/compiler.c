@@ -77,11 +77,23 @@ typedef struct {
     MVMuint32  *resolve;
 } LabelInfo;
 
-/* Describes the state for the frame we're currently compiling. */
+/* The bytecode and annotations compiled for a frame. Each frame is compiled
+ * into buffers of its own, which only refer to the shared string heap and
+ * callsites by index, and they are laid out one after the other when forming
+ * the output. */
 typedef struct {
-    /* Position of start of bytecode. */
-    unsigned int bytecode_start;
+    char         *bytecode;
+    unsigned int  bytecode_size;
+    char         *annotations;
+    unsigned int  annotations_size;
+
+    /* Position of the frame's entry in the frame segment, where the offsets
+     * of its bytecode and annotations are filled in. */
+    unsigned int  frame_start;
+} FrameOutput;
 
+/* Describes the state for the frame we're currently compiling. */
+typedef struct {
     /* Position of start of frame entry. */
     unsigned int frame_start;
 
@@ -117,9 +129,16 @@ typedef struct {
     FrameState   *cur_frame;
     unsigned int  num_frames;
 
-    /* String heap and seen hash mapping known strings to indexes. */
-    MASTNode *strings;
-    MASTNode *seen_strings;
+    /* String heap, along with a hash table mapping known strings to their
+     * indexes in it. The table uses open addressing, keyed on the hash code
+     * of the string, and each slot holds the heap index plus 1, so that 0
+     * means empty. The strings are not rooted; we compile with allocation
+     * going straight to gen2, so nothing will move or be collected. */
+    MVMString   **strings;
+    unsigned int  num_strings;
+    unsigned int  alloc_strings;
+    unsigned int *seen_strings;
+    unsigned int  seen_mask;
 
     /* The SC dependencies segment; we know the size up front. */
     char         *scdep_seg;
@@ -141,16 +160,19 @@ typedef struct {
     unsigned int  callsite_alloc;
     unsigned int  num_callsites;
 
-    /* The bytecode segment. */
+    /* The bytecode of the frame we're currently compiling. */
     char         *bytecode_seg;
     unsigned int  bytecode_pos;
     unsigned int  bytecode_alloc;
 
-    /* The annotation segment. */
+    /* The annotations of the frame we're currently compiling. */
     char         *annotation_seg;
     unsigned int  annotation_pos;
     unsigned int  annotation_alloc;
 
+    /* The output of each frame compiled so far. */
+    FrameOutput  *frame_outputs;
+
     /* Current instruction info */
     const MVMOpInfo    *current_op_info;
 
@@ -265,6 +287,7 @@ static void cleanup_frame(VM, FrameState *fs) {
 static void cleanup_all(VM, WriterState *ws) {
     CallsiteReuseEntry *current, *tmp;
     unsigned bucket_tmp;
+    unsigned int i;
     if (ws->cur_frame)
         cleanup_frame(vm, ws->cur_frame);
     if (ws->scdep_seg)
@@ -279,6 +302,13 @@ static void cleanup_all(VM, WriterState *ws) {
         MVM_free(ws->bytecode_seg);
     if (ws->annotation_seg)
         MVM_free(ws->annotation_seg);
+    for (i = 0; i < ws->num_frames; i++) {
+        MVM_free(ws->frame_outputs[i].bytecode);
+        MVM_free(ws->frame_outputs[i].annotations);
+    }
+    MVM_free(ws->frame_outputs);
+    MVM_free(ws->strings);
+    MVM_free(ws->seen_strings);
     HASH_ITER(hash_handle, ws->callsite_reuse_head, current, tmp, bucket_tmp) {
         MVM_free(current->identifier);
     }
@@ -286,22 +316,56 @@ static void cleanup_all(VM, WriterState *ws) {
     MVM_free(ws);
 }
 
+/* Doubles the size of the seen strings hash table, re-inserting all of the
+ * strings in the heap. */
+static void grow_seen_strings(VM, WriterState *ws) {
+    unsigned int mask = ws->seen_mask * 2 + 1;
+    unsigned int i;
+    MVM_free(ws->seen_strings);
+    ws->seen_strings      = (unsigned int *)MVM_calloc(mask + 1, sizeof(unsigned int));
+    ws->seen_mask = mask;
+    for (i = 0; i < ws->num_strings; i++) {
+        unsigned int slot = (unsigned int)ws->strings[i]->body.cached_hash_code & mask;
+        while (ws->seen_strings[slot])
+            slot = (slot + 1) & mask;
+        ws->seen_strings[slot] = i + 1;
+    }
+}
+
 /* Gets the index of a string already in the string heap, or
  * adds it to the heap if it's not already there. */
 static unsigned int get_string_heap_index(VM, WriterState *ws, VMSTR *strval) {
-    if (EXISTSKEY(vm, ws->seen_strings, strval)) {
-        return (unsigned int)ATKEY_I(vm, ws->seen_strings, strval);
+    unsigned int slot, index;
+    if (!strval->body.cached_hash_code)
+        MVM_string_compute_hash_code(vm, strval);
+
+    /* Look for it in the hash table. */
+    slot = (unsigned int)strval->body.cached_hash_code & ws->seen_mask;
+    while ((index = ws->seen_strings[slot])) {
+        MVMString *seen = ws->strings[index - 1];
+        if (seen == strval || (seen->body.cached_hash_code == strval->body.cached_hash_code
+                && MVM_string_equal(vm, seen, strval)))
+            return index - 1;
+        slot = (slot + 1) & ws->seen_mask;
     }
-    else {
-        unsigned int index = (unsigned int)ELEMS(vm, ws->strings);
-        if (index >= 0x7FFFFFFF) {
-            cleanup_all(vm, ws);
-            DIE(vm, "Too many strings in compilation unit");
-        }
-        BINDPOS_S(vm, ws->strings, index, strval);
-        BINDKEY_I(vm, ws->seen_strings, strval, index);
-        return index;
+
+    /* Not there, so add it to the heap and the table. */
+    index = ws->num_strings;
+    if (index >= 0x7FFFFFFF) {
+        cleanup_all(vm, ws);
+        DIE(vm, "Too many strings in compilation unit");
     }
+    if (index == ws->alloc_strings) {
+        ws->alloc_strings *= 2;
+        ws->strings = (MVMString **)MVM_realloc(ws->strings,
+            ws->alloc_strings * sizeof(MVMString *));
+    }
+    ws->strings[index] = strval;
+    ws->num_strings++;
+    ws->seen_strings[slot] = index + 1;
+    if (ws->num_strings * 4 > ws->seen_mask * 3)
+        grow_seen_strings(vm, ws);
+    return index;
 }
 
 /* Locates the index of a frame. */
@@ -452,7 +516,7 @@ static void write_label_or_add_fixup(VM, WriterState *ws, MAST_Label *l) {
  * seen already, resolves its fixups. */
 static void add_label_and_resolve_fixups(VM, WriterState *ws, MAST_Label *l) {
     FrameState *fs     = ws->cur_frame;
-    MVMuint32   offset = ws->bytecode_pos - ws->cur_frame->bytecode_start;
+    MVMuint32   offset = ws->bytecode_pos;
     MVMuint32   i, j;
 
     /* See if it has an existing entry. */
@@ -989,7 +1053,7 @@ static void compile_instruction(VM, WriterState *ws, MASTNode *node) {
         MAST_Annotated *a = GET_Annotated(node);
         unsigned int i;
         unsigned int num_ins = ELEMS(vm, a->instructions);
-        unsigned int offset = ws->bytecode_pos - ws->cur_frame->bytecode_start;
+        unsigned int offset = ws->bytecode_pos;
 
         ws->last_annotated = a;
         ensure_space(vm, &ws->annotation_seg, &ws->annotation_alloc, ws->annotation_pos, 12);
@@ -1006,12 +1070,12 @@ static void compile_instruction(VM, WriterState *ws, MASTNode *node) {
         MAST_HandlerScope *hs = GET_HandlerScope(node);
         unsigned int i;
         unsigned int num_ins = ELEMS(vm, hs->instructions);
-        unsigned int start   = ws->bytecode_pos - ws->cur_frame->bytecode_start;
+        unsigned int start   = ws->bytecode_pos;
         unsigned int end;
 
         for (i = 0; i < num_ins; i++)
             compile_instruction(vm, ws, ATPOS(vm, hs->instructions, i));
-        end = ws->bytecode_pos - ws->cur_frame->bytecode_start;
+        end = ws->bytecode_pos;
 
         ws->cur_frame->num_handlers++;
         if (ws->cur_frame->handlers)
@@ -1100,7 +1164,7 @@ static void compile_instruction(VM, WriterState *ws, MASTNode *node) {
 static void compile_frame(VM, WriterState *ws, MASTNode *node, unsigned short idx) {
     MAST_Frame  *f;
     FrameState  *fs;
-    unsigned int i, num_ins, instructions_start;
+    unsigned int i, num_ins;
     MASTNode *last_inst = NULL;
     MVMuint16 num_slvs;
 
@@ -1113,7 +1177,6 @@ static void compile_frame(VM, WriterState *ws, MASTNode *node, unsigned short id
 
     /* Allocate frame state. */
     fs = ws->cur_frame    = (FrameState *)MVM_malloc(sizeof(FrameState));
-    fs->bytecode_start    = ws->bytecode_pos;
     fs->frame_start       = ws->frame_pos;
     fs->labels            = NULL;
     fs->num_labels        = 0;
@@ -1137,16 +1200,25 @@ static void compile_frame(VM, WriterState *ws, MASTNode *node, unsigned short id
     /* initialize number of annotation */
     fs->num_annotations = 0;
 
+    /* Start buffers for the frame's bytecode and annotations; positions and
+     * label offsets in them are relative to the start of the frame. */
+    ws->bytecode_pos     = 0;
+    ws->bytecode_alloc   = 128;
+    ws->bytecode_seg     = (char *)MVM_malloc(ws->bytecode_alloc);
+    ws->annotation_pos   = 0;
+    ws->annotation_alloc = 64;
+    ws->annotation_seg   = (char *)MVM_malloc(ws->annotation_alloc);
+
     /* initialize number of handlers and handlers pointer */
     fs->num_handlers = 0;
     fs->handlers = NULL;
 
     /* Ensure space is available to write frame entry, and write the
-     * header, apart from the bytecode length, which we'll fill in
-     * later. */
+     * header, apart from the bytecode length and the offsets of the
+     * bytecode and annotations, which we'll fill in later. */
     ensure_space(vm, &ws->frame_seg, &ws->frame_alloc, ws->frame_pos,
         FRAME_HEADER_SIZE + fs->num_locals * 2 + fs->num_lexicals * 6);
-    write_int32(ws->frame_seg, ws->frame_pos, fs->bytecode_start);
+    write_int32(ws->frame_seg, ws->frame_pos, 0); /* Filled in later. */
     write_int32(ws->frame_seg, ws->frame_pos + 4, 0); /* Filled in later. */
     write_int32(ws->frame_seg, ws->frame_pos + 8, fs->num_locals);
     write_int32(ws->frame_seg, ws->frame_pos + 12, fs->num_lexicals);
@@ -1183,7 +1255,7 @@ static void compile_frame(VM, WriterState *ws, MASTNode *node, unsigned short id
         write_int16(ws->frame_seg, ws->frame_pos + 24, idx);
     }
 
-    write_int32(ws->frame_seg, ws->frame_pos + 26, ws->annotation_pos);
+    write_int32(ws->frame_seg, ws->frame_pos + 26, 0); /* Filled in later. */
     write_int32(ws->frame_seg, ws->frame_pos + 30, 0); /* number of annotation; fill in later */
     write_int32(ws->frame_seg, ws->frame_pos + 34, 0); /* number of handlers; fill in later */
     write_int16(ws->frame_seg, ws->frame_pos + 38, (MVMint16)f->flags);
@@ -1224,9 +1296,6 @@ static void compile_frame(VM, WriterState *ws, MASTNode *node, unsigned short id
         ws->frame_pos += 4;
     }
 
-    /* Save the location of the start of instructions */
-    instructions_start = ws->bytecode_pos;
-
     /* Compile the instructions. */
     ws->current_ins_idx = 0;
     num_ins = ELEMS(vm, f->instructions);
@@ -1249,7 +1318,7 @@ static void compile_frame(VM, WriterState *ws, MASTNode *node, unsigned short id
     }
 
     /* Fill in bytecode length. */
-    write_int32(ws->frame_seg, fs->frame_start + 4, ws->bytecode_pos - instructions_start);
+    write_int32(ws->frame_seg, fs->frame_start + 4, ws->bytecode_pos);
 
     /* Fill in number of annotations. */
     write_int32(ws->frame_seg, fs->frame_start + 30, fs->num_annotations);
@@ -1306,6 +1375,15 @@ static void compile_frame(VM, WriterState *ws, MASTNode *node, unsigned short id
         DIE(vm, "Frame has %u unresolved labels", fs->unresolved_labels);
     }
 
+    /* Keep the frame's bytecode and annotations for forming the output. */
+    ws->frame_outputs[idx].bytecode         = ws->bytecode_seg;
+    ws->frame_outputs[idx].bytecode_size    = ws->bytecode_pos;
+    ws->frame_outputs[idx].annotations      = ws->annotation_seg;
+    ws->frame_outputs[idx].annotations_size = ws->annotation_pos;
+    ws->frame_outputs[idx].frame_start      = fs->frame_start;
+    ws->bytecode_seg   = NULL;
+    ws->annotation_seg = NULL;
+
     /* Free the frame state. */
     cleanup_frame(vm, fs);
     ws->cur_frame = NULL;
@@ -1321,7 +1399,7 @@ static char * form_string_heap(VM, WriterState *ws, unsigned int *string_heap_si
     unsigned int  i, num_strings, heap_size, heap_alloc;
 
     /* If we've nothing to do, just return immediately. */
-    num_strings = ELEMS(vm, ws->strings);
+    num_strings = ws->num_strings;
     if (num_strings == 0) {
         *string_heap_size = 0;
         return NULL;
@@ -1344,7 +1422,7 @@ static char * form_string_heap(VM, WriterState *ws, unsigned int *string_heap_si
          * string already being in NFG. Latin-1 is except \r, which we also
          * check for here. */
         MVMint32   need_utf8 = 0;
-        MVMString *str       = ATPOS_S(vm, ws->strings, i);
+        MVMString *str       = ws->strings[i];
         MVM_string_gi_init(tc, &gi, str);
         while (MVM_string_gi_has_more(tc, &gi)) {
             MVMGrapheme32 g = MVM_string_gi_get_grapheme(tc, &gi);
@@ -1393,6 +1471,23 @@ static char * form_string_heap(VM, WriterState *ws, unsigned int *string_heap_si
     return heap;
 }
 
+/* Lays out the bytecode and annotations of the frames one after the other,
+ * filling in their offsets in each frame entry, and works out the total
+ * sizes. */
+static void layout_frame_outputs(VM, WriterState *ws, unsigned int *bytecode_size,
+                                 unsigned int *annotations_size) {
+    unsigned int i;
+    *bytecode_size    = 0;
+    *annotations_size = 0;
+    for (i = 0; i < ws->num_frames; i++) {
+        FrameOutput *fo = &ws->frame_outputs[i];
+        write_int32(ws->frame_seg, fo->frame_start, *bytecode_size);
+        write_int32(ws->frame_seg, fo->frame_start + 26, *annotations_size);
+        *bytecode_size    += fo->bytecode_size;
+        *annotations_size += fo->annotations_size;
+    }
+}
+
 /* Takes all the pieces and forms the bytecode output. */
 static char * form_bytecode_output(VM, WriterState *ws, unsigned int *bytecode_size) {
     MVMuint32     size    = 0;
@@ -1401,6 +1496,9 @@ static char * form_bytecode_output(VM, WriterState *ws, unsigned int *bytecode_s
     unsigned int  string_heap_size;
     char         *string_heap;
     unsigned int  hll_str_idx;
+    unsigned int  frames_bytecode_size;
+    unsigned int  frames_annotations_size;
+    unsigned int  i;
 
     /* Store HLL name string, if any. */
     if (!VM_STRING_IS_NULL(ws->cu->hll))
@@ -1411,6 +1509,9 @@ static char * form_bytecode_output(VM, WriterState *ws, unsigned int *bytecode_s
     /* Build string heap. */
     string_heap = form_string_heap(vm, ws, &string_heap_size);
 
+    /* Place the frames' bytecode and annotations. */
+    layout_frame_outputs(vm, ws, &frames_bytecode_size, &frames_annotations_size);
+
     /* Work out total size. */
     size += MVM_ALIGN_SECTION(HEADER_SIZE);
     size += MVM_ALIGN_SECTION(string_heap_size);
@@ -1418,8 +1519,8 @@ static char * form_bytecode_output(VM, WriterState *ws, unsigned int *bytecode_s
     size += MVM_ALIGN_SECTION(ws->extops_bytes);
     size += MVM_ALIGN_SECTION(ws->frame_pos);
     size += MVM_ALIGN_SECTION(ws->callsite_pos);
-    size += MVM_ALIGN_SECTION(ws->bytecode_pos);
-    size += MVM_ALIGN_SECTION(ws->annotation_pos);
+    size += MVM_ALIGN_SECTION(frames_bytecode_size);
+    size += MVM_ALIGN_SECTION(frames_annotations_size);
     if (vm->serialized)
         size += MVM_ALIGN_SECTION(vm->serialized_size);
 
@@ -1457,7 +1558,7 @@ static char * form_bytecode_output(VM, WriterState *ws, unsigned int *bytecode_s
 
     /* Add strings heap section and its header entries. */
     write_int32(output, STRING_HEADER_OFFSET, pos);
-    write_int32(output, STRING_HEADER_OFFSET + 4, ELEMS(vm, ws->strings));
+    write_int32(output, STRING_HEADER_OFFSET + 4, ws->num_strings);
     memcpy(output + pos, string_heap, string_heap_size);
     pos += MVM_ALIGN_SECTION(string_heap_size);
     if (string_heap) {
@@ -1478,15 +1579,23 @@ static char * form_bytecode_output(VM, WriterState *ws, unsigned int *bytecode_s
 
     /* Add bytecode section and its header entries (offset, length). */
     write_int32(output, BYTECODE_HEADER_OFFSET, pos);
-    write_int32(output, BYTECODE_HEADER_OFFSET + 4, ws->bytecode_pos);
-    memcpy(output + pos, ws->bytecode_seg, ws->bytecode_pos);
-    pos += MVM_ALIGN_SECTION(ws->bytecode_pos);
+    write_int32(output, BYTECODE_HEADER_OFFSET + 4, frames_bytecode_size);
+    for (i = 0; i < ws->num_frames; i++) {
+        FrameOutput *fo = &ws->frame_outputs[i];
+        memcpy(output + pos, fo->bytecode, fo->bytecode_size);
+        pos += fo->bytecode_size;
+    }
+    pos += MVM_ALIGN_SECTION(frames_bytecode_size) - frames_bytecode_size;
 
     /* Add annotation section and its header entries (offset, length). */
     write_int32(output, ANNOTATION_HEADER_OFFSET, pos);
-    write_int32(output, ANNOTATION_HEADER_OFFSET + 4, ws->annotation_pos);
-    memcpy(output + pos, ws->annotation_seg, ws->annotation_pos);
-    pos += MVM_ALIGN_SECTION(ws->annotation_pos);
+    write_int32(output, ANNOTATION_HEADER_OFFSET + 4, frames_annotations_size);
+    for (i = 0; i < ws->num_frames; i++) {
+        FrameOutput *fo = &ws->frame_outputs[i];
+        memcpy(output + pos, fo->annotations, fo->annotations_size);
+        pos += fo->annotations_size;
+    }
+    pos += MVM_ALIGN_SECTION(frames_annotations_size) - frames_annotations_size;
 
     /* Add HLL and special frame indexes. */
     write_int32(output, HLL_NAME_HEADER_OFFSET, hll_str_idx);
@@ -1527,8 +1636,11 @@ char * MVM_mast_compile(VM, MASTNode *node, MASTNodeTypes *types, unsigned int *
     /* Initialize the writer state structure. */
     ws = (WriterState *)MVM_malloc(sizeof(WriterState));
     ws->types            = types;
-    ws->strings          = NEWLIST_S(vm);
-    ws->seen_strings     = NEWHASH(vm);
+    ws->num_strings      = 0;
+    ws->alloc_strings    = 256;
+    ws->strings          = (MVMString **)MVM_malloc(ws->alloc_strings * sizeof(MVMString *));
+    ws->seen_mask        = 511;
+    ws->seen_strings     = (unsigned int *)MVM_calloc(ws->seen_mask + 1, sizeof(unsigned int));
     ws->cur_frame        = NULL;
     ws->scdep_bytes      = ELEMS(vm, cu->sc_handles) * SC_DEP_SIZE;
     ws->scdep_seg        = ws->scdep_bytes ? (char *)MVM_malloc(ws->scdep_bytes) : NULL;
@@ -1543,12 +1655,9 @@ char * MVM_mast_compile(VM, MASTNode *node, MASTNodeTypes *types, unsigned int *
     ws->callsite_alloc   = 4096;
     ws->callsite_seg     = (char *)MVM_malloc(ws->callsite_alloc);
     ws->num_callsites    = 0;
-    ws->bytecode_pos     = 0;
-    ws->bytecode_alloc   = 128 * ELEMS(vm, cu->frames);
-    ws->bytecode_seg     = (char *)MVM_malloc(ws->bytecode_alloc);
-    ws->annotation_pos   = 0;
-    ws->annotation_alloc = 64 * ELEMS(vm, cu->frames);
-    ws->annotation_seg   = (char *)MVM_malloc(ws->annotation_alloc);
+    ws->bytecode_seg     = NULL;
+    ws->annotation_seg   = NULL;
+    ws->frame_outputs    = (FrameOutput *)MVM_calloc(ELEMS(vm, cu->frames) + 1, sizeof(FrameOutput));
     ws->cu               = cu;
     ws->current_frame_idx= 0;
 
@@ -5,32 +5,63 @@
     #define MAX(x,y) ((x)>(y)?(x):(y))
 #endif
 
-/* Taken from mp_set_long, but portably accepts a 64-bit number. */
+/* Like mp_set_long, but portably accepts a 64-bit number. Rather than
+ * shifting the value in a few bits at a time, it is split straight into
+ * digits. */
 int MVM_bigint_mp_set_uint64(mp_int * a, MVMuint64 b) {
-  int     x, res;
+  int x = 0, res;
 
-  mp_zero (a);
-
-  /* set four bits at a time */
-  for (x = 0; x < sizeof(MVMuint64) * 2; x++) {
-    /* shift the number up four bits */
-    if ((res = mp_mul_2d (a, 4, a)) != MP_OKAY) {
-      return res;
-    }
-
-    /* OR in the top four bits of the source */
-    a->dp[0] |= (b >> ((sizeof(MVMuint64)) * 8 - 4)) & 15;
-
-    /* shift the source up to the next four bits */
-    b <<= 4;
-
-    /* ensure that digits are not clamped off */
-    a->used += 1;
+  if ((res = mp_grow(a, (64 + DIGIT_BIT - 1) / DIGIT_BIT)) != MP_OKAY) {
+    return res;
+  }
+  mp_zero(a);
+  while (b) {
+    a->dp[x++] = (mp_digit)(b & MP_MASK);
+    b >>= DIGIT_BIT;
   }
-  mp_clamp(a);
+  a->used = x;
   return MP_OKAY;
 }
 
+/* Overflow checked 64-bit arithmetic, returning non-zero if the result did
+ * not fit. Uses the compiler builtins where we have them. */
+#if defined(__has_builtin)
+#  if __has_builtin(__builtin_add_overflow)
+#    define MVM_HAS_OVERFLOW_BUILTINS 1
+#  endif
+#endif
+#if !defined(MVM_HAS_OVERFLOW_BUILTINS) && defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 5
+#  define MVM_HAS_OVERFLOW_BUILTINS 1
+#endif
+#ifdef MVM_HAS_OVERFLOW_BUILTINS
+#define add_overflows(a, b, r) __builtin_add_overflow(a, b, r)
+#define sub_overflows(a, b, r) __builtin_sub_overflow(a, b, r)
+#define mul_overflows(a, b, r) __builtin_mul_overflow(a, b, r)
+#else
+static int add_overflows(MVMint64 a, MVMint64 b, MVMint64 *r) {
+    if ((b > 0 && a > INT64_MAX - b) || (b < 0 && a < INT64_MIN - b))
+        return 1;
+    *r = a + b;
+    return 0;
+}
+static int sub_overflows(MVMint64 a, MVMint64 b, MVMint64 *r) {
+    if ((b < 0 && a > INT64_MAX + b) || (b > 0 && a < INT64_MIN + b))
+        return 1;
+    *r = a - b;
+    return 0;
+}
+static int mul_overflows(MVMint64 a, MVMint64 b, MVMint64 *r) {
+    /* Conservative by one at the very bottom of the range, which is fine as
+     * we'll just fall back to libtommath. */
+    MVMuint64 ua = a < 0 ? (MVMuint64)0 - (MVMuint64)a : (MVMuint64)a;
+    MVMuint64 ub = b < 0 ? (MVMuint64)0 - (MVMuint64)b : (MVMuint64)b;
+    if (ub && ua > (MVMuint64)INT64_MAX / ub)
+        return 1;
+    *r = a * b;
+    return 0;
+}
+#endif
+
 static MVMnum64 mp_get_double(mp_int *a) {
     MVMnum64 d    = 0.0;
     MVMnum64 sign = SIGN(a) == MP_NEG ? -1.0 : 1.0;
@@ -106,6 +137,387 @@ static void from_num(MVMnum64 d, mp_int *a) {
     mp_shrink(a);
 }
 
+/* Radix conversion of large numbers is done by divide and conquer: the number
+ * is split in two by dividing by (or, when parsing, the halves are combined by
+ * multiplying by) a power of the radix, so that libtommath's fast
+ * multiplication does most of the work. Below these sizes, in mp_digits when
+ * printing and in characters when parsing, a chunked quadratic conversion is
+ * used, handling as many characters as fit into an mp_digit at a time. */
+#define MVM_BIGINT_TO_RADIX_CUTOFF      32
+#define MVM_BIGINT_FROM_RADIX_CUTOFF    512
+
+/* Divisors of at least this many mp_digits are divided by with Barrett
+ * reduction rather than mp_div's schoolbook division. Reciprocals of numbers
+ * up to the second size are found by division rather than Newton iteration. */
+#define MVM_BIGINT_BARRETT_CUTOFF       400
+#define MVM_BIGINT_RECIPROCAL_CUTOFF    32
+
+/* Multiplies a and b, like mp_mul. libtommath's Karatsuba and Toom-Cook
+ * multiplication split both operands at a point based on the smaller one, so
+ * when they differ in size the imbalance grows at each level of recursion,
+ * and much of the work ends up in the quadratic base case. Here the bigger
+ * one is instead cut into pieces the size of the smaller one, which are
+ * multiplied separately. */
+static void mul_balanced(mp_int *a, mp_int *b, mp_int *c) {
+    mp_int *big   = a->used >= b->used ? a : b;
+    mp_int  small = *(big == a ? b : a);
+    mp_int  acc, piece, prod;
+    int     m = small.used, i;
+    if (m < KARATSUBA_MUL_CUTOFF || big->used == m) {
+        mp_mul(a, b, c);
+        return;
+    }
+    small.sign = MP_ZPOS;
+    mp_init(&acc);
+    mp_init_size(&piece, m);
+    mp_init(&prod);
+    for (i = 0; i < big->used; i += m) {
+        int n = big->used - i < m ? big->used - i : m;
+        memcpy(piece.dp, big->dp + i, n * sizeof(mp_digit));
+        piece.used = n;
+        mp_clamp(&piece);
+        mul_balanced(&piece, &small, &prod);
+        mp_lshd(&prod, i);
+        mp_add(&acc, &prod, &acc);
+    }
+    if (a->sign != b->sign && !mp_iszero(&acc))
+        acc.sign = MP_NEG;
+    mp_exch(&acc, c);
+    mp_clear(&acc);
+    mp_clear(&piece);
+    mp_clear(&prod);
+}
+
+/* Sets mu to floor(B ** (2 * k) / p), where B is the mp_digit base and k the
+ * number of digits in p. Rather than a quadratic division, this takes the
+ * reciprocal of the top half of p and does one step of Newton iteration at
+ * full precision, followed by a correction of a few units. */
+static void reciprocal(mp_int *p, mp_int *mu) {
+    int    k = p->used;
+    int    h = (k + 1) / 2 + 2;
+    mp_int e, t;
+    mp_init(&e);
+    mp_init(&t);
+    if (k <= MVM_BIGINT_RECIPROCAL_CUTOFF || h >= k) {
+        mp_set(&t, 1);
+        mp_lshd(&t, 2 * k);
+        mp_div(&t, p, mu, NULL);
+    }
+    else {
+        /* Reciprocal of the top h digits, scaled up to k digits. */
+        mp_copy(p, &t);
+        mp_rshd(&t, k - h);
+        reciprocal(&t, mu);
+        mp_lshd(mu, k - h);
+
+        /* Newton step: mu += mu * (B ** 2k - p * mu) / B ** 2k. */
+        mul_balanced(p, mu, &t);
+        mp_set(&e, 1);
+        mp_lshd(&e, 2 * k);
+        mp_sub(&e, &t, &e);
+        mul_balanced(mu, &e, &t);
+        mp_rshd(&t, 2 * k);
+        mp_add(mu, &t, mu);
+    }
+
+    /* Correct it, so that 0 <= B ** 2k - p * mu < p. */
+    mul_balanced(p, mu, &t);
+    mp_set(&e, 1);
+    mp_lshd(&e, 2 * k);
+    mp_sub(&e, &t, &e);
+    while (SIGN(&e) == MP_NEG) {
+        mp_sub_d(mu, 1, mu);
+        mp_add(&e, p, &e);
+    }
+    while (mp_cmp(&e, p) != MP_LT) {
+        mp_add_d(mu, 1, mu);
+        mp_sub(&e, p, &e);
+    }
+    mp_clear(&e);
+    mp_clear(&t);
+}
+
+/* Divides x by p using Barrett reduction, where x < p ** 2 and mu is the
+ * reciprocal of p. */
+static void barrett_divmod(mp_int *x, mp_int *p, mp_int *mu, mp_int *q, mp_int *r) {
+    int    k = p->used;
+    mp_int t;
+    mp_init_copy(&t, x);
+    mp_rshd(&t, k - 1);
+    mul_balanced(&t, mu, q);
+    mp_rshd(q, k + 1);
+    mul_balanced(q, p, &t);
+    mp_sub(x, &t, r);
+    while (mp_cmp(r, p) != MP_LT) {
+        mp_sub(r, p, r);
+        mp_add_d(q, 1, q);
+    }
+    mp_clear(&t);
+}
+
+/* Like mp_div, but uses Barrett reduction when the divisor is big enough for
+ * that to be faster. */
+static int divmod(mp_int *a, mp_int *b, mp_int *q, mp_int *r) {
+    mp_int a_abs, b_abs, mu, tq, tr;
+    int    k = b->used;
+    if (k < MVM_BIGINT_BARRETT_CUTOFF)
+        return mp_div(a, b, q, r);
+
+    /* Divide the magnitudes, then give the results the signs that mp_div
+     * would. */
+    a_abs = *a;
+    b_abs = *b;
+    a_abs.sign = MP_ZPOS;
+    b_abs.sign = MP_ZPOS;
+    mp_init(&mu);
+    mp_init(&tq);
+    mp_init(&tr);
+    reciprocal(&b_abs, &mu);
+    if (a->used < 2 * k - 1) {
+        barrett_divmod(&a_abs, &b_abs, &mu, &tq, &tr);
+    }
+    else {
+        /* Long division, bringing down k - 1 digits at a time, so that each
+         * partial dividend is less than the square of the divisor. */
+        int    step = k - 1;
+        int    i    = ((a->used - 1) / step) * step;
+        int    n    = a->used - i;
+        mp_int x, qi;
+        mp_init(&x);
+        mp_init(&qi);
+        for (; i >= 0; i -= step, n = step) {
+            mp_copy(&tr, &x);
+            mp_grow(&x, x.used + n);
+            mp_lshd(&x, n);
+            memcpy(x.dp, a->dp + i, n * sizeof(mp_digit));
+            if (x.used < n)
+                x.used = n;
+            mp_clamp(&x);
+            barrett_divmod(&x, &b_abs, &mu, &qi, &tr);
+            mp_lshd(&tq, n);
+            mp_add(&tq, &qi, &tq);
+        }
+        mp_clear(&x);
+        mp_clear(&qi);
+    }
+    if (a->sign != b->sign && !mp_iszero(&tq))
+        tq.sign = MP_NEG;
+    if (a->sign == MP_NEG && !mp_iszero(&tr))
+        tr.sign = MP_NEG;
+    if (q)
+        mp_exch(&tq, q);
+    if (r)
+        mp_exch(&tr, r);
+    mp_clear(&mu);
+    mp_clear(&tq);
+    mp_clear(&tr);
+    return MP_OKAY;
+}
+
+/* Powers of the radix used to split and combine numbers. Level 0 is the
+ * largest power that fits in an mp_digit; each further level squares the one
+ * before it. They are computed lazily. */
+#define MVM_BIGINT_RADIX_LEVELS 32
+typedef struct {
+    int       radix;
+    int       chunk;
+    mp_digit  chunk_power;
+    int       num_powers;
+    mp_int    powers[MVM_BIGINT_RADIX_LEVELS];
+    int       num_reciprocals;
+    mp_int    reciprocals[MVM_BIGINT_RADIX_LEVELS];
+} RadixPowers;
+
+static void radix_powers_init(RadixPowers *rp, int radix) {
+    mp_digit power = radix;
+    int      chunk = 1;
+    while (power <= MP_MASK / radix) {
+        power *= radix;
+        chunk++;
+    }
+    rp->radix       = radix;
+    rp->chunk       = chunk;
+    rp->chunk_power = power;
+    rp->num_powers  = 0;
+    rp->num_reciprocals = 0;
+}
+
+/* Gets radix ** (chunk * 2 ** level). */
+static mp_int * radix_power(RadixPowers *rp, int level) {
+    while (rp->num_powers <= level) {
+        mp_int *p = &rp->powers[rp->num_powers];
+        mp_init(p);
+        if (rp->num_powers == 0)
+            MVM_bigint_mp_set_uint64(p, rp->chunk_power);
+        else
+            mp_sqr(&rp->powers[rp->num_powers - 1], p);
+        rp->num_powers++;
+    }
+    return &rp->powers[level];
+}
+
+/* Gets the reciprocal of radix_power(rp, level), for Barrett reduction. */
+static mp_int * radix_reciprocal(RadixPowers *rp, int level) {
+    while (rp->num_reciprocals <= level) {
+        mp_int *mu = &rp->reciprocals[rp->num_reciprocals];
+        mp_init(mu);
+        reciprocal(radix_power(rp, rp->num_reciprocals), mu);
+        rp->num_reciprocals++;
+    }
+    return &rp->reciprocals[level];
+}
+
+static void radix_powers_clear(RadixPowers *rp) {
+    int i;
+    for (i = 0; i < rp->num_powers; i++)
+        mp_clear(&rp->powers[i]);
+    for (i = 0; i < rp->num_reciprocals; i++)
+        mp_clear(&rp->reciprocals[i]);
+}
+
+/* Finds the level of the smallest power with at least half of len digits,
+ * returning -1 if it would have len digits or more, in which case there is
+ * nothing to split. */
+static int radix_split_level(RadixPowers *rp, int len) {
+    int level = 0;
+    while (level + 1 < MVM_BIGINT_RADIX_LEVELS && ((long long)rp->chunk << level) * 2 < len)
+        level++;
+    return ((long long)rp->chunk << level) < len ? level : -1;
+}
+
+/* Writes exactly len characters for the non-negative a, which must be less
+ * than radix ** len, padding with leading zeros. Clobbers a. */
+static void to_radix_rec(RadixPowers *rp, mp_int *a, char *out, int len) {
+    int level;
+    if (a->used <= MVM_BIGINT_TO_RADIX_CUTOFF || (level = radix_split_level(rp, len)) < 0) {
+        char *pos = out + len;
+        while (pos > out && !mp_iszero(a)) {
+            mp_digit d;
+            int      i;
+            mp_div_d(a, rp->chunk_power, a, &d);
+            for (i = 0; i < rp->chunk && pos > out; i++) {
+                *--pos = mp_s_rmap[d % rp->radix];
+                d /= rp->radix;
+            }
+        }
+        memset(out, '0', pos - out);
+    }
+    else {
+        int    split = rp->chunk << level;
+        mp_int q, r;
+        mp_init(&q);
+        mp_init(&r);
+        barrett_divmod(a, radix_power(rp, level), radix_reciprocal(rp, level), &q, &r);
+        to_radix_rec(rp, &q, out, len - split);
+        to_radix_rec(rp, &r, out + len - split, split);
+        mp_clear(&q);
+        mp_clear(&r);
+    }
+}
+
+/* Like mp_toradix, but subquadratic for large numbers. Returns a string that
+ * should be freed after use, and its length (not counting the terminating
+ * NUL) in *len. Radixes from 2 to 64 are supported. */
+char * MVM_bigint_mp_to_radix(mp_int *a, int radix, int *len) {
+    RadixPowers  rp;
+    mp_int       t;
+    char        *buf, *digits;
+    int          max_len, skip;
+
+    /* Find an upper bound on the number of characters needed. */
+    max_len = (int)(mp_count_bits(a) / (log((double)radix) / log(2.0))) + 2;
+    buf     = (char *)MVM_malloc(max_len + 2);
+    digits  = buf;
+    if (SIGN(a) == MP_NEG)
+        *digits++ = '-';
+
+    /* Convert, then drop the leading zeros. */
+    radix_powers_init(&rp, radix);
+    mp_init_copy(&t, a);
+    t.sign = MP_ZPOS;
+    to_radix_rec(&rp, &t, digits, max_len);
+    mp_clear(&t);
+    radix_powers_clear(&rp);
+    for (skip = 0; skip < max_len - 1 && digits[skip] == '0'; skip++)
+        ;
+    memmove(digits, digits + skip, max_len - skip);
+    digits[max_len - skip] = '\0';
+    *len = (int)(digits - buf) + max_len - skip;
+    return buf;
+}
+
+/* Sets a to the value of the n digits (each less than the radix) passed. */
+static void from_radix_rec(RadixPowers *rp, mp_int *a, const unsigned char *digits, int n) {
+    int level;
+    if (n <= MVM_BIGINT_FROM_RADIX_CUTOFF || (level = radix_split_level(rp, n)) < 0) {
+        int i = 0;
+        mp_zero(a);
+        while (i < n) {
+            mp_digit value = 0, power = 1;
+            int      end   = i + rp->chunk < n ? i + rp->chunk : n;
+            for (; i < end; i++) {
+                value = value * rp->radix + digits[i];
+                power *= rp->radix;
+            }
+            mp_mul_d(a, power, a);
+            mp_add_d(a, value, a);
+        }
+    }
+    else {
+        int    split = rp->chunk << level;
+        mp_int lo;
+        mp_init(&lo);
+        from_radix_rec(rp, a, digits, n - split);
+        from_radix_rec(rp, &lo, digits + n - split, split);
+        mul_balanced(a, radix_power(rp, level), a);
+        mp_add(a, &lo, a);
+        mp_clear(&lo);
+    }
+}
+
+/* Sets a to the number made of the n digits passed, which must each be less
+ * than the radix, most significant first. Subquadratic for large numbers. */
+void MVM_bigint_mp_from_digits(mp_int *a, const unsigned char *digits, int n, int radix) {
+    RadixPowers rp;
+    if (radix < 2) {
+        /* Only zeros are possible. */
+        mp_zero(a);
+        return;
+    }
+    radix_powers_init(&rp, radix);
+    from_radix_rec(&rp, a, digits, n);
+    radix_powers_clear(&rp);
+}
+
+/* Like mp_read_radix, but subquadratic for large numbers; reads an optional
+ * leading -, then digits up to the first character that is not one. Radixes
+ * are limited to 2 to 36. */
+void MVM_bigint_mp_read_radix(mp_int *a, const char *str, int radix) {
+    size_t         len = strlen(str), n = 0;
+    int            neg = 0;
+    unsigned char *digits;
+    if (*str == '-') {
+        neg = 1;
+        str++;
+        len--;
+    }
+    digits = (unsigned char *)MVM_malloc(len ? len : 1);
+    for (; n < len; n++) {
+        char ch = str[n];
+        int  d  = ch >= '0' && ch <= '9' ? ch - '0'
+                : ch >= 'a' && ch <= 'z' ? ch - 'a' + 10
+                : ch >= 'A' && ch <= 'Z' ? ch - 'A' + 10
+                : 99;
+        if (d >= radix)
+            break;
+        digits[n] = (unsigned char)d;
+    }
+    MVM_bigint_mp_from_digits(a, digits, (int)n, radix);
+    MVM_free(digits);
+    if (neg && !mp_iszero(a))
+        a->sign = MP_NEG;
+}
+
 /* Returns the body of a P6bigint, containing the bigint/smallint union, for
  * operations that want to explicitly handle the two. */
 static MVMP6bigintBody * get_bigint_body(MVMThreadContext *tc, MVMObject *obj) {
@@ -124,6 +536,27 @@ static int can_be_smallint(const mp_int *i) {
     return MVM_IS_32BIT_INT(DIGIT(i, 0));
 }
 
+/* Gets the value of a bigint as a 64-bit integer if it fits in one, returning
+ * non-zero if so. This lets values that have outgrown a smallint still avoid
+ * libtommath arithmetic. */
+static int get_int64(const MVMP6bigintBody *body, MVMint64 *result) {
+    if (!MVM_BIGINT_IS_BIG(body)) {
+        *result = body->u.smallint.value;
+        return 1;
+    }
+    else {
+        mp_int    *i = body->u.bigint;
+        MVMuint64  value = 0;
+        int        d;
+        if (mp_count_bits(i) > 63)
+            return 0;
+        for (d = USED(i) - 1; d >= 0; d--)
+            value = (value << DIGIT_BIT) | DIGIT(i, d);
+        *result = SIGN(i) == MP_NEG ? -(MVMint64)value : (MVMint64)value;
+        return 1;
+    }
+}
+
 /* Forces a bigint, even if we only have a smallint. Takes a parameter that
  * indicates where to allocate a temporary mp_int if needed. */
 static mp_int * force_bigint(const MVMP6bigintBody *body, mp_int **tmp) {
@@ -172,7 +605,7 @@ static void store_int64_result(MVMP6bigintBody *body, MVMint64 result) {
             MVM_bigint_mp_set_uint64(i, (MVMuint64)result);
         }
         else {
-            MVM_bigint_mp_set_uint64(i, (MVMuint64)-result);
+            MVM_bigint_mp_set_uint64(i, (MVMuint64)0 - (MVMuint64)result);
             mp_neg(i, i);
         }
         body->u.bigint = i;
@@ -335,13 +768,17 @@ MVMObject * MVM_bigint_##opname(MVMThreadContext *tc, MVMObject *result_type, MV
     return result; \
 }
 
-#define MVM_BIGINT_BINARY_OP_SIMPLE(opname, SMALLINT_OP) \
+/* Binary ops with a fast path for when both operands, and the result, fit in
+ * 64 bits; CHECKED_OP is one of the overflow checked arithmetic functions,
+ * and MP_OP the libtommath function used otherwise. */
+#define MVM_BIGINT_BINARY_OP_SIMPLE(opname, CHECKED_OP, MP_OP) \
 MVMObject * MVM_bigint_##opname(MVMThreadContext *tc, MVMObject *result_type, MVMObject *a, MVMObject *b) { \
     MVMP6bigintBody *ba, *bb, *bc; \
     MVMObject *result; \
+    MVMint64 sa, sb, sc; \
     ba = get_bigint_body(tc, a); \
     bb = get_bigint_body(tc, b); \
-    if (MVM_BIGINT_IS_BIG(ba) || MVM_BIGINT_IS_BIG(bb)) { \
+    if (!get_int64(ba, &sa) || !get_int64(bb, &sb) || CHECKED_OP(sa, sb, &sc)) { \
         mp_int *tmp[2] = { NULL, NULL }; \
         mp_int *ia, *ib, *ic; \
         MVMROOT(tc, a, { \
@@ -356,15 +793,11 @@ MVMObject * MVM_bigint_##opname(MVMThreadContext *tc, MVMObject *result_type, MV
         ib = force_bigint(bb, tmp); \
         ic = MVM_malloc(sizeof(mp_int)); \
         mp_init(ic); \
-        mp_##opname(ia, ib, ic); \
+        MP_OP(ia, ib, ic); \
         store_bigint_result(bc, ic); \
         clear_temp_bigints(tmp, 2); \
     } \
     else { \
-        MVMint64 sc; \
-        MVMint64 sa = ba->u.smallint.value; \
-        MVMint64 sb = bb->u.smallint.value; \
-        SMALLINT_OP; \
         result = MVM_intcache_get(tc, result_type, sc); \
         if (result) \
             return result; \
@@ -413,9 +846,9 @@ MVM_BIGINT_UNARY_OP(neg, { sb = -sa; })
 /* unused */
 /* MVM_BIGINT_UNARY_OP(sqrt) */
 
-MVM_BIGINT_BINARY_OP_SIMPLE(add, { sc = sa + sb; })
-MVM_BIGINT_BINARY_OP_SIMPLE(sub, { sc = sa - sb; })
-MVM_BIGINT_BINARY_OP_SIMPLE(mul, { sc = sa * sb; })
+MVM_BIGINT_BINARY_OP_SIMPLE(add, add_overflows, mp_add)
+MVM_BIGINT_BINARY_OP_SIMPLE(sub, sub_overflows, mp_sub)
+MVM_BIGINT_BINARY_OP_SIMPLE(mul, mul_overflows, mul_balanced)
 MVM_BIGINT_BINARY_OP(lcm)
 
 MVMObject *MVM_bigint_gcd(MVMThreadContext *tc, MVMObject *result_type, MVMObject *a, MVMObject *b) {
@@ -465,7 +898,11 @@ MVM_BIGINT_BINARY_OP_2(and, { sc = sa & sb; })
 MVMint64 MVM_bigint_cmp(MVMThreadContext *tc, MVMObject *a, MVMObject *b) {
     MVMP6bigintBody *ba = get_bigint_body(tc, a);
     MVMP6bigintBody *bb = get_bigint_body(tc, b);
-    if (MVM_BIGINT_IS_BIG(ba) || MVM_BIGINT_IS_BIG(bb)) {
+    MVMint64 sa, sb;
+    if (get_int64(ba, &sa) && get_int64(bb, &sb)) {
+        return sa == sb ? 0 : sa <  sb ? -1 : 1;
+    }
+    else {
         mp_int *tmp[2] = { NULL, NULL };
         mp_int *ia = force_bigint(ba, tmp);
         mp_int *ib = force_bigint(bb, tmp);
@@ -473,11 +910,6 @@ MVMint64 MVM_bigint_cmp(MVMThreadContext *tc, MVMObject *a, MVMObject *b) {
         clear_temp_bigints(tmp, 2);
         return r;
     }
-    else {
-        MVMint64 sa = ba->u.smallint.value;
-        MVMint64 sb = bb->u.smallint.value;
-        return sa == sb ? 0 : sa <  sb ? -1 : 1;
-    }
 }
 
 MVMObject * MVM_bigint_mod(MVMThreadContext *tc, MVMObject *result_type, MVMObject *a, MVMObject *b) {
@@ -495,10 +927,7 @@ MVMObject * MVM_bigint_mod(MVMThreadContext *tc, MVMObject *result_type, MVMObje
 
     bc = get_bigint_body(tc, result);
 
-    /* XXX the behavior of C's mod operator is not correct
-     * for our purposes. So we rely on mp_mod for all our modulus
-     * calculations for now. */
-    if (1 || MVM_BIGINT_IS_BIG(ba) || MVM_BIGINT_IS_BIG(bb)) {
+    if (MVM_BIGINT_IS_BIG(ba) || MVM_BIGINT_IS_BIG(bb)) {
         mp_int *tmp[2] = { NULL, NULL };
         mp_int *ia = force_bigint(ba, tmp);
         mp_int *ib = force_bigint(bb, tmp);
@@ -507,7 +936,10 @@ MVMObject * MVM_bigint_mod(MVMThreadContext *tc, MVMObject *result_type, MVMObje
 
         mp_init(ic);
 
-        mp_result = mp_mod(ia, ib, ic);
+        /* Like mp_mod, the result takes the sign of the divisor. */
+        mp_result = divmod(ia, ib, NULL, ic);
+        if (mp_result == MP_OKAY && !mp_iszero(ic) && SIGN(ic) != SIGN(ib))
+            mp_add(ic, ib, ic);
         clear_temp_bigints(tmp, 2);
 
         if (mp_result == MP_VAL) {
@@ -515,7 +947,17 @@ MVMObject * MVM_bigint_mod(MVMThreadContext *tc, MVMObject *result_type, MVMObje
         }
         store_bigint_result(bc, ic);
     } else {
-        store_int64_result(bc, ba->u.smallint.value % bb->u.smallint.value);
+        /* C's % truncates towards zero, but we want the result to take the
+         * sign of the divisor, like mp_mod does. */
+        MVMint64 num   = ba->u.smallint.value;
+        MVMint64 denom = bb->u.smallint.value;
+        MVMint64 value;
+        if (denom == 0)
+            MVM_exception_throw_adhoc(tc, "Division by zero");
+        value = num % denom;
+        if (value != 0 && (value < 0) != (denom < 0))
+            value += denom;
+        store_int64_result(bc, value);
     }
 
     return result;
@@ -568,7 +1010,7 @@ MVMObject *MVM_bigint_div(MVMThreadContext *tc, MVMObject *result_type, MVMObjec
         if ((cmp_a == MP_LT) ^ (cmp_b == MP_LT)) {
             mp_init(&remainder);
             mp_init(&intermediate);
-            mp_result = mp_div(ia, ib, &intermediate, &remainder);
+            mp_result = divmod(ia, ib, &intermediate, &remainder);
             if (mp_result == MP_VAL) {
                 mp_clear(&remainder);
                 mp_clear(&intermediate);
@@ -583,7 +1025,7 @@ MVMObject *MVM_bigint_div(MVMThreadContext *tc, MVMObject *result_type, MVMObjec
             mp_clear(&remainder);
             mp_clear(&intermediate);
         } else {
-            mp_result = mp_div(ia, ib, ic, NULL);
+            mp_result = divmod(ia, ib, ic, NULL);
             if (mp_result == MP_VAL) {
                 clear_temp_bigints(tmp, 2);
                 MVM_exception_throw_adhoc(tc, "Division by zero");
@@ -592,13 +1034,13 @@ MVMObject *MVM_bigint_div(MVMThreadContext *tc, MVMObject *result_type, MVMObjec
         store_bigint_result(bc, ic);
         clear_temp_bigints(tmp, 2);
     } else {
-        MVMint32 num   = ba->u.smallint.value;
-        MVMint32 denom = bb->u.smallint.value;
-        MVMint32 value;
+        MVMint64 num   = ba->u.smallint.value;
+        MVMint64 denom = bb->u.smallint.value;
+        MVMint64 value;
+        if (denom == 0) {
+            MVM_exception_throw_adhoc(tc, "Division by zero");
+        }
         if ((cmp_a == MP_LT) ^ (cmp_b == MP_LT)) {
-            if (denom == 0) {
-                MVM_exception_throw_adhoc(tc, "Division by zero");
-            }
             if ((num % denom) != 0) {
                 value = num / denom - 1;
             } else {
@@ -776,7 +1218,7 @@ void MVM_bigint_from_str(MVMThreadContext *tc, MVMObject *a, const char *buf) {
     MVMP6bigintBody *body = get_bigint_body(tc, a);
     mp_int *i = MVM_malloc(sizeof(mp_int));
     mp_init(i);
-    mp_read_radix(i, buf, 10);
+    MVM_bigint_mp_read_radix(i, buf, 10);
     if (can_be_smallint(i)) {
         body->u.smallint.flag = MVM_BIGINT_32_FLAG;
         body->u.smallint.value = SIGN(i) == MP_NEG ? -DIGIT(i, 0) : DIGIT(i, 0);
@@ -790,15 +1232,16 @@ void MVM_bigint_from_str(MVMThreadContext *tc, MVMObject *a, const char *buf) {
 
 MVMString * MVM_bigint_to_str(MVMThreadContext *tc, MVMObject *a, int base) {
     MVMP6bigintBody *body = get_bigint_body(tc, a);
+    if (base < 2 || base > 64) {
+        MVM_exception_throw_adhoc(tc, "Cannot convert to base %d (must be 2 to 64)", base);
+    }
     if (MVM_BIGINT_IS_BIG(body)) {
         mp_int *i = body->u.bigint;
         int len;
         char *buf;
         MVMString *result;
-        mp_radix_size(i, base, &len);
-        buf = (char *) MVM_malloc(len);
-        mp_toradix_n(i, buf, base, len);
-        result = MVM_string_ascii_decode(tc, tc->instance->VMString, buf, len - 1);
+        buf = MVM_bigint_mp_to_radix(i, base, &len);
+        result = MVM_string_ascii_decode(tc, tc->instance->VMString, buf, len);
         MVM_free(buf);
         return result;
     }
@@ -947,8 +1390,10 @@ MVMObject * MVM_bigint_radix(MVMThreadContext *tc, MVMint64 radix, MVMString *st
     MVMuint16  neg  = 0;
     MVMint64   ch;
 
-    mp_int zvalue;
-    mp_int zbase;
+    /* The digits found, and how many of them to include in the value. */
+    MVMuint8  *digits;
+    MVMint64   num_digits = 0;
+    MVMint64   keep       = 0;
 
     MVMObject *value_obj;
     mp_int *value;
@@ -972,10 +1417,6 @@ MVMObject * MVM_bigint_radix(MVMThreadContext *tc, MVMint64 radix, MVMString *st
     result = MVM_repr_alloc_init(tc, MVM_hll_current(tc)->slurpy_array_type);
     MVM_gc_root_temp_push(tc, (MVMCollectable **)&result);
 
-    mp_init(&zvalue);
-    mp_init(&zbase);
-    mp_set_int(&zbase, 1);
-
     value_obj = MVM_repr_alloc_init(tc, type);
     MVM_repr_push_o(tc, result, value_obj);
     MVM_gc_root_temp_push(tc, (MVMCollectable **)&value_obj);
@@ -986,14 +1427,6 @@ MVMObject * MVM_bigint_radix(MVMThreadContext *tc, MVMint64 radix, MVMString *st
     bvalue = get_bigint_body(tc, value_obj);
     bbase  = get_bigint_body(tc, base_obj);
 
-    value = MVM_malloc(sizeof(mp_int));
-    base  = MVM_malloc(sizeof(mp_int));
-
-    mp_init(value);
-    mp_init(base);
-
-    mp_set_int(base, 1);
-
     ch = (offset < chars) ? MVM_string_get_grapheme_at_nocheck(tc, str, offset) : 0;
     if ((flag & 0x02) && (ch == '+' || ch == '-')) {
         neg = (ch == '-');
@@ -1001,6 +1434,9 @@ MVMObject * MVM_bigint_radix(MVMThreadContext *tc, MVMint64 radix, MVMString *st
         ch = (offset < chars) ? MVM_string_get_grapheme_at_nocheck(tc, str, offset) : 0;
     }
 
+    /* Collect the digits; they are converted to a number all at once after,
+     * which is much faster than accumulating them one at a time. */
+    digits = MVM_malloc(offset < chars ? chars - offset : 1);
     while (offset < chars) {
         if (ch >= '0' && ch <= '9') ch = ch - '0'; /* fast-path for ASCII 0..9 */
         else if (ch >= 'a' && ch <= 'z') ch = ch - 'a' + 10;
@@ -1022,11 +1458,9 @@ MVMObject * MVM_bigint_radix(MVMThreadContext *tc, MVMint64 radix, MVMString *st
         }
         else break;
         if (ch >= radix) break;
-        mp_mul_d(&zvalue, radix, &zvalue);
-        mp_add_d(&zvalue, ch, &zvalue);
-        mp_mul_d(&zbase, radix, &zbase);
+        digits[num_digits++] = (MVMuint8)ch;
         offset++; pos = offset;
-        if (ch != 0 || !(flag & 0x04)) { mp_copy(&zvalue, value); mp_copy(&zbase, base); }
+        if (ch != 0 || !(flag & 0x04)) keep = num_digits;
         if (offset >= chars) break;
         ch = MVM_string_get_grapheme_at_nocheck(tc, str, offset);
         if (ch != '_') continue;
@@ -1035,8 +1469,21 @@ MVMObject * MVM_bigint_radix(MVMThreadContext *tc, MVMint64 radix, MVMString *st
         ch = MVM_string_get_grapheme_at_nocheck(tc, str, offset);
     }
 
-    mp_clear(&zvalue);
-    mp_clear(&zbase);
+    /* The value is made of the digits we're keeping, and the base is the
+     * radix raised to the number of them. */
+    value = MVM_malloc(sizeof(mp_int));
+    base  = MVM_malloc(sizeof(mp_int));
+    mp_init(value);
+    mp_init(base);
+    MVM_bigint_mp_from_digits(value, digits, (int)keep, (int)radix);
+    MVM_free(digits);
+    if (keep) {
+        mp_set_int(base, (unsigned long)radix);
+        mp_expt_d(base, (mp_digit)keep, base);
+    }
+    else {
+        mp_set_int(base, 1);
+    }
 
     if (neg || flag & 0x01) {
         mp_neg(value, value);
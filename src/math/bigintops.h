@@ -1,4 +1,7 @@
 int MVM_bigint_mp_set_uint64(mp_int * a, MVMuint64 b);
+char * MVM_bigint_mp_to_radix(mp_int *a, int radix, int *len);
+void MVM_bigint_mp_from_digits(mp_int *a, const unsigned char *digits, int n, int radix);
+void MVM_bigint_mp_read_radix(mp_int *a, const char *str, int radix);
 
 void MVM_bigint_abs(MVMThreadContext *tc, MVMObject *result, MVMObject *a);
 void MVM_bigint_neg(MVMThreadContext *tc, MVMObject *result, MVMObject *a);
@@ -67,7 +67,7 @@ static FILE *fopen_perhaps_with_pid(char *path, const char *mode) {
 MVMInstance * MVM_vm_create_instance(void) {
     MVMInstance *instance;
     char *spesh_log, *spesh_nodelay, *spesh_disable, *spesh_inline_disable,
-         *spesh_osr_disable, *spesh_limit;
+         *spesh_osr_disable, *spesh_limit, *spesh_event_log;
     char *jit_log, *jit_disable, *jit_bytecode_dir;
     char *dynvar_log;
     int init_stat;
@@ -119,6 +119,9 @@ MVMInstance * MVM_vm_create_instance(void) {
     /* Set up persistent object ID hash mutex. */
     init_mutex(instance->mutex_object_ids, "object ID hash");
 
+    /* Set up threads list mutex. */
+    init_mutex(instance->mutex_threads, "threads list");
+
     /* Allocate all things during following setup steps directly in gen2, as
      * they will have program lifetime. */
     MVM_gc_allocate_gen2_default_set(instance->main_thread);
@@ -138,6 +141,9 @@ MVMInstance * MVM_vm_create_instance(void) {
     /* Initialize event loop thread starting mutex. */
     init_mutex(instance->mutex_event_loop_start, "event loop thread start");
 
+    /* Initialize worker pool starting mutex. */
+    init_mutex(instance->mutex_worker_pool_start, "worker pool start");
+
     /* Create main thread object, and also make it the start of the all threads
      * linked list. */
     MVM_store(&instance->threads,
@@ -175,8 +181,9 @@ MVMInstance * MVM_vm_create_instance(void) {
      * them, so that spesh may end up optimizing more "internal" stuff. */
     MVM_callsite_initialize_common(instance->main_thread);
 
-    /* Multi-cache additions mutex. */
-    init_mutex(instance->mutex_multi_cache_add, "multi-cache addition");
+    /* Create string intern table. */
+    MVM_string_intern_init(instance);
+    init_mutex(instance->mutex_string_interns, "string interns");
 
     /* Current instrumentation level starts at 1; used to trigger all frames
      * to be verified before their first run. */
@@ -188,6 +195,12 @@ MVMInstance * MVM_vm_create_instance(void) {
     spesh_log = getenv("MVM_SPESH_LOG");
     if (spesh_log && strlen(spesh_log))
         instance->spesh_log_fh = fopen_perhaps_with_pid(spesh_log, "w");
+    spesh_event_log = getenv("MVM_SPESH_EVENT_LOG");
+    if (spesh_event_log && strlen(spesh_event_log)) {
+        FILE *fh = fopen_perhaps_with_pid(spesh_event_log, "wb");
+        if (fh)
+            MVM_spesh_event_log_open(instance, fh);
+    }
     spesh_disable = getenv("MVM_SPESH_DISABLE");
     if (!spesh_disable || strlen(spesh_disable) == 0) {
         instance->spesh_enabled = 1;
@@ -240,6 +253,7 @@ MVMInstance * MVM_vm_create_instance(void) {
     else
         instance->dynvar_log_fh = NULL;
     instance->nfa_debug_enabled = getenv("MVM_NFA_DEB") ? 1 : 0;
+    instance->gc_string_stats = getenv("MVM_GC_STRING_STATS") ? 1 : 0;
     if (getenv("MVM_CROSS_THREAD_WRITE_LOG")) {
         instance->cross_thread_write_logging = 1;
         instance->cross_thread_write_logging_include_locked =
@@ -400,6 +414,9 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
     MVM_HASH_DESTROY(hash_handle, MVMReprRegistry, instance->repr_hash);
     MVM_free(instance->repr_list);
 
+    /* Clean up threads list mutex. */
+    uv_mutex_destroy(&instance->mutex_threads);
+
     /* Clean up GC permanent roots related resources. */
     uv_mutex_destroy(&instance->mutex_permroots);
     MVM_free(instance->permroots);
@@ -441,13 +458,14 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
     /* Clean up Hash of hashes of symbol tables per hll. */
     uv_mutex_destroy(&instance->mutex_hll_syms);
 
-    /* Clean up multi cache addition mutex. */
-    uv_mutex_destroy(&instance->mutex_multi_cache_add);
-
     /* Clean up interned callsites */
     uv_mutex_destroy(&instance->mutex_callsite_interns);
     cleanup_callsite_interns(instance);
 
+    /* Clean up interned strings */
+    uv_mutex_destroy(&instance->mutex_string_interns);
+    MVM_string_intern_destroy(instance);
+
     /* Release this interpreter's hold on Unicode database */
     MVM_unicode_release(instance->main_thread);
 
@@ -455,6 +473,7 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
     uv_mutex_destroy(&instance->mutex_spesh_install);
     if (instance->spesh_log_fh)
         fclose(instance->spesh_log_fh);
+    MVM_spesh_event_log_close(instance);
     if (instance->jit_log_fh)
         fclose(instance->jit_log_fh);
     if (instance->dynvar_log_fh)
@@ -472,12 +491,18 @@ void MVM_vm_destroy_instance(MVMInstance *instance) {
 
     /* Clean up integer constant and string cache. */
     uv_mutex_destroy(&instance->mutex_int_const_cache);
-    MVM_free(instance->int_const_cache);
+    MVM_intcache_destroy(instance->main_thread);
     MVM_free(instance->int_to_str_cache);
 
     /* Clean up event loop starting mutex. */
     uv_mutex_destroy(&instance->mutex_event_loop_start);
 
+    /* Clean up worker pool starting mutex. */
+    uv_mutex_destroy(&instance->mutex_worker_pool_start);
+
+    /* Clean up the sampling profiler. */
+    MVM_profile_sampling_destroy(instance);
+
     /* Destroy main thread contexts. */
     MVM_tc_destroy(instance->main_thread);
 
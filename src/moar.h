@@ -94,6 +94,7 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "gc/collect.h"
 #include "gc/debug.h"
 #include "gc/wb.h"
+#include "gc/stats.h"
 #include "core/threadcontext.h"
 #include "core/instance.h"
 #include "core/interp.h"
@@ -108,6 +109,7 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "core/bytecodedump.h"
 #include "core/ops.h"
 #include "core/threads.h"
+#include "core/scheduler.h"
 #include "core/hll.h"
 #include "core/loadbytecode.h"
 #include "math/num.h"
@@ -150,6 +152,7 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "spesh/threshold.h"
 #include "spesh/inline.h"
 #include "spesh/osr.h"
+#include "spesh/events.h"
 #include "spesh/lookup.h"
 #include "strings/normalize.h"
 #include "strings/decode_stream.h"
@@ -160,6 +163,7 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "strings/nfg.h"
 #include "strings/iter.h"
 #include "strings/ops.h"
+#include "strings/intern.h"
 #include "strings/unicode_gen.h"
 #include "strings/unicode.h"
 #include "strings/latin1.h"
@@ -189,6 +193,7 @@ MVM_PUBLIC const MVMint32 MVM_jit_support(void);
 #include "profiler/log.h"
 #include "profiler/profile.h"
 #include "profiler/heapsnapshot.h"
+#include "profiler/sampling.h"
 #include "instrument/crossthreadwrite.h"
 
 MVMObject *MVM_backend_config(MVMThreadContext *tc);
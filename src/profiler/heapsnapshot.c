@@ -5,9 +5,39 @@ MVMint32 MVM_profile_heap_profiling(MVMThreadContext *tc) {
     return tc->instance->heap_snapshots != NULL;
 }
 
-/* Start heap profiling. */
+/* Writes an unsigned LEB128 varint to the snapshot stream. */
+static void write_varint(FILE *fh, MVMuint64 value) {
+    while (value >= 0x80) {
+        putc((int)((value & 0x7F) | 0x80), fh);
+        value >>= 7;
+    }
+    putc((int)value, fh);
+}
+
+/* Start heap profiling. If the configuration includes a path, the snapshots
+ * are streamed to it in a compact binary format as they are taken. */
 void MVM_profile_heap_start(MVMThreadContext *tc, MVMObject *config) {
-    tc->instance->heap_snapshots = MVM_calloc(1, sizeof(MVMHeapSnapshotCollection));
+    MVMHeapSnapshotCollection *col;
+    char *path = NULL;
+    FILE *fh   = NULL;
+
+    if (MVM_repr_exists_key(tc, config, tc->instance->str_consts.path)) {
+        path = MVM_string_utf8_c8_encode_C_string(tc, MVM_repr_get_str(tc,
+            MVM_repr_at_key_o(tc, config, tc->instance->str_consts.path)));
+        fh = fopen(path, "wb");
+        if (!fh) {
+            char *waste[] = { path, NULL };
+            MVM_exception_throw_adhoc_free(tc, waste,
+                "Could not open heap snapshot output file '%s': %s", path, strerror(errno));
+        }
+        fwrite(MVM_HEAP_SNAPSHOT_MAGIC, 1, strlen(MVM_HEAP_SNAPSHOT_MAGIC), fh);
+        write_varint(fh, MVM_HEAP_SNAPSHOT_VERSION);
+    }
+
+    col = MVM_calloc(1, sizeof(MVMHeapSnapshotCollection));
+    col->path = path;
+    col->fh   = fh;
+    tc->instance->heap_snapshots = col;
 }
 
 /* Grows storage if it's full, zeroing the extension. Assumes it's only being
@@ -27,16 +57,15 @@ static void grow_storage(void *store_ptr, MVMuint64 *num, MVMuint64 *alloc, size
 #define STR_MODE_DUP    2
 static MVMuint64 get_string_index(MVMThreadContext *tc, MVMHeapSnapshotState *ss,
                                    char *str, char str_mode) {
-     MVMuint64 i;
+    MVMHeapSnapshotCollection  *col = ss->col;
+    MVMHeapSnapshotStringEntry *entry;
+    size_t len = strlen(str);
 
-     /* Add a lookup hash here if it gets to be a hotspot. */
-     MVMHeapSnapshotCollection *col = ss->col;
-     for (i = 0; i < col->num_strings; i++) {
-        if (strcmp(col->strings[i], str) == 0) {
-            if (str_mode == STR_MODE_OWN)
-                MVM_free(str);
-            return i;
-        }
+    HASH_FIND(hash_handle, col->string_lookup, str, len, entry);
+    if (entry) {
+        if (str_mode == STR_MODE_OWN)
+            MVM_free(str);
+        return entry->idx;
     }
 
     grow_storage((void **)&(col->strings), &(col->num_strings),
@@ -46,8 +75,35 @@ static MVMuint64 get_string_index(MVMThreadContext *tc, MVMHeapSnapshotState *ss
     col->strings_free[col->num_strings_free] = str_mode != STR_MODE_CONST;
     col->num_strings_free++;
     col->strings[col->num_strings] = str_mode == STR_MODE_DUP ? strdup(str) : str;
+
+    entry = MVM_malloc(sizeof(MVMHeapSnapshotStringEntry));
+    entry->str = col->strings[col->num_strings];
+    entry->idx = col->num_strings;
+    HASH_ADD_KEYPTR(hash_handle, col->string_lookup, entry->str, len, entry);
     return col->num_strings++;
- }
+}
+
+/* Looks up an entry in a type or static frame table lookup hash. Returns 1
+ * and sets the index if it is found, and 0 otherwise. */
+static MVMuint32 find_table_entry(MVMThreadContext *tc, MVMHeapSnapshotTableEntry *lookup,
+                                  MVMuint64 *key, MVMuint64 *idx) {
+    MVMHeapSnapshotTableEntry *entry;
+    HASH_FIND(hash_handle, lookup, (char *)key, 4 * sizeof(MVMuint64), entry);
+    if (entry) {
+        *idx = entry->idx;
+        return 1;
+    }
+    return 0;
+}
+
+/* Adds an entry to a type or static frame table lookup hash. */
+static void add_table_entry(MVMThreadContext *tc, MVMHeapSnapshotTableEntry **lookup,
+                            MVMuint64 *key, MVMuint64 idx) {
+    MVMHeapSnapshotTableEntry *entry = MVM_malloc(sizeof(MVMHeapSnapshotTableEntry));
+    memcpy(entry->key, key, 4 * sizeof(MVMuint64));
+    entry->idx = idx;
+    HASH_ADD_KEYPTR(hash_handle, *lookup, (char *)entry->key, 4 * sizeof(MVMuint64), entry);
+}
 
 /* Gets a string index in the string heap for a VM string. */
 static MVMuint64 get_vm_string_index(MVMThreadContext *tc, MVMHeapSnapshotState *ss, MVMString *str) {
@@ -204,14 +260,12 @@ static void set_type_index(MVMThreadContext *tc, MVMHeapSnapshotState *ss,
         ? get_string_index(tc, ss, st->debug_name, STR_MODE_DUP)
         : get_string_index(tc, ss, "<anon>", STR_MODE_CONST);
 
+    MVMuint64 key[4] = { repr_idx, type_idx, 0, 0 };
     MVMuint64 i;
     MVMHeapSnapshotType *t;
-    for (i = 0; i < ss->col->num_types; i++) {
-        t = &(ss->col->types[i]);
-        if (t->repr_name == repr_idx && t->type_name == type_idx) {
-            col->type_or_frame_index = i;
-            return;
-        }
+    if (find_table_entry(tc, ss->col->type_lookup, key, &i)) {
+        col->type_or_frame_index = i;
+        return;
     }
 
     grow_storage(&(ss->col->types), &(ss->col->num_types),
@@ -219,6 +273,7 @@ static void set_type_index(MVMThreadContext *tc, MVMHeapSnapshotState *ss,
     t = &(ss->col->types[ss->col->num_types]);
     t->repr_name = repr_idx;
     t->type_name = type_idx;
+    add_table_entry(tc, &(ss->col->type_lookup), key, ss->col->num_types);
     col->type_or_frame_index = ss->col->num_types;
     ss->col->num_types++;
 }
@@ -237,19 +292,17 @@ static void set_static_frame_index(MVMThreadContext *tc, MVMHeapSnapshotState *s
         ? get_vm_string_index(tc, ss, MVM_cu_string(tc, cu, ann->filename_string_heap_index))
         : get_vm_string_index(tc, ss, cu->body.filename);
 
+    MVMuint64 key[4] = { name_idx, cuid_idx, line, file_idx };
     MVMuint64 i;
     MVMHeapSnapshotStaticFrame *s;
-    for (i = 0; i < ss->col->num_static_frames; i++) {
-        s = &(ss->col->static_frames[i]);
-        if (s->name == name_idx && s->cuid == cuid_idx && s->line == line && s->file == file_idx) {
-            col->type_or_frame_index = i;
-            MVM_free(ann);
-            return;
-        }
-    }
 
     MVM_free(ann);
 
+    if (find_table_entry(tc, ss->col->static_frame_lookup, key, &i)) {
+        col->type_or_frame_index = i;
+        return;
+    }
+
     grow_storage(&(ss->col->static_frames), &(ss->col->num_static_frames),
         &(ss->col->alloc_static_frames), sizeof(MVMHeapSnapshotStaticFrame));
     s = &(ss->col->static_frames[ss->col->num_static_frames]);
@@ -257,6 +310,7 @@ static void set_static_frame_index(MVMThreadContext *tc, MVMHeapSnapshotState *s
     s->cuid = cuid_idx;
     s->line = line;
     s->file = file_idx;
+    add_table_entry(tc, &(ss->col->static_frame_lookup), key, ss->col->num_static_frames);
     col->type_or_frame_index = ss->col->num_static_frames;
     ss->col->num_static_frames++;
 }
@@ -276,7 +330,7 @@ static void process_gc_worklist(MVMThreadContext *tc, MVMHeapSnapshotState *ss,
     MVMuint16 ref_kind = desc
         ? MVM_SNAPSHOT_REF_KIND_STRING
         : MVM_SNAPSHOT_REF_KIND_UNKNOWN;
-    MVMuint16 ref_index = desc
+    MVMuint64 ref_index = desc
         ? get_string_index(tc, ss, desc, STR_MODE_CONST)
         : 0;
     while (c_ptr = MVM_gc_worklist_get(tc, ss->gcwl)) {
@@ -599,15 +653,96 @@ static void record_snapshot(MVMThreadContext *tc, MVMHeapSnapshotCollection *col
     MVM_gc_worklist_destroy(tc, ss.gcwl);
 }
 
+/* Writes the string, type, and static frame table entries added since they
+ * were last written to the snapshot stream. */
+static void write_new_table_entries(MVMThreadContext *tc, MVMHeapSnapshotCollection *col) {
+    FILE *fh = col->fh;
+    MVMuint64 i;
+
+    if (col->strings_written < col->num_strings) {
+        putc(MVM_HEAP_SNAPSHOT_CHUNK_STRINGS, fh);
+        write_varint(fh, col->num_strings - col->strings_written);
+        for (i = col->strings_written; i < col->num_strings; i++) {
+            size_t len = strlen(col->strings[i]);
+            write_varint(fh, len);
+            fwrite(col->strings[i], 1, len, fh);
+        }
+        col->strings_written = col->num_strings;
+    }
+
+    if (col->types_written < col->num_types) {
+        putc(MVM_HEAP_SNAPSHOT_CHUNK_TYPES, fh);
+        write_varint(fh, col->num_types - col->types_written);
+        for (i = col->types_written; i < col->num_types; i++) {
+            write_varint(fh, col->types[i].repr_name);
+            write_varint(fh, col->types[i].type_name);
+        }
+        col->types_written = col->num_types;
+    }
+
+    if (col->static_frames_written < col->num_static_frames) {
+        putc(MVM_HEAP_SNAPSHOT_CHUNK_STATIC_FRAMES, fh);
+        write_varint(fh, col->num_static_frames - col->static_frames_written);
+        for (i = col->static_frames_written; i < col->num_static_frames; i++) {
+            write_varint(fh, col->static_frames[i].name);
+            write_varint(fh, col->static_frames[i].cuid);
+            write_varint(fh, col->static_frames[i].line);
+            write_varint(fh, col->static_frames[i].file);
+        }
+        col->static_frames_written = col->num_static_frames;
+    }
+}
+
+/* Writes a snapshot to the snapshot stream. Collectables are written in index
+ * order, each followed by its references. References mostly point at nearby
+ * collectables, so the target is written relative to the referencing one. */
+static void write_snapshot(MVMThreadContext *tc, MVMHeapSnapshotCollection *col, MVMHeapSnapshot *hs) {
+    FILE *fh = col->fh;
+    MVMuint64 i, j;
+
+    write_new_table_entries(tc, col);
+
+    putc(MVM_HEAP_SNAPSHOT_CHUNK_SNAPSHOT, fh);
+    write_varint(fh, hs->num_collectables);
+    write_varint(fh, hs->num_references);
+    for (i = 0; i < hs->num_collectables; i++) {
+        MVMHeapSnapshotCollectable *c = &(hs->collectables[i]);
+        write_varint(fh, c->kind);
+        write_varint(fh, c->type_or_frame_index);
+        write_varint(fh, c->collectable_size);
+        write_varint(fh, c->unmanaged_size);
+        write_varint(fh, c->num_refs);
+        for (j = 0; j < c->num_refs; j++) {
+            MVMHeapSnapshotReference *ref = &(hs->references[c->refs_start + j]);
+            MVMint64 delta = (MVMint64)(ref->collectable_index - i);
+            write_varint(fh, ref->description);
+            write_varint(fh, ((MVMuint64)delta << 1) ^ (MVMuint64)(delta >> 63));
+        }
+    }
+    fflush(fh);
+}
+
 /* Takes a snapshot of the heap, adding it to the current heap snapshot
- * collection. */
+ * collection. When streaming, it is written out and discarded instead, so
+ * only the shared tables are kept in memory. */
 void MVM_profile_heap_take_snapshot(MVMThreadContext *tc) {
     if (MVM_profile_heap_profiling(tc)) {
         MVMHeapSnapshotCollection *col = tc->instance->heap_snapshots;
-        grow_storage(&(col->snapshots), &(col->num_snapshots), &(col->alloc_snapshots),
-            sizeof(MVMHeapSnapshot));
-        record_snapshot(tc, col, &(col->snapshots[col->num_snapshots]));
-        col->num_snapshots++;
+        if (col->fh) {
+            MVMHeapSnapshot hs;
+            memset(&hs, 0, sizeof(MVMHeapSnapshot));
+            record_snapshot(tc, col, &hs);
+            write_snapshot(tc, col, &hs);
+            MVM_free(hs.collectables);
+            MVM_free(hs.references);
+            col->num_streamed++;
+        }
+        else {
+            grow_storage(&(col->snapshots), &(col->num_snapshots), &(col->alloc_snapshots),
+                sizeof(MVMHeapSnapshot));
+            record_snapshot(tc, col, &(col->snapshots[col->num_snapshots]));
+            col->num_snapshots++;
+        }
     }
 }
 
@@ -628,9 +763,16 @@ static void destroy_heap_snapshot_collection(MVMThreadContext *tc) {
             MVM_free(col->strings[i]);
     MVM_free(col->strings);
     MVM_free(col->strings_free);
+    MVM_HASH_DESTROY(hash_handle, MVMHeapSnapshotStringEntry, col->string_lookup);
 
     MVM_free(col->types);
+    MVM_HASH_DESTROY(hash_handle, MVMHeapSnapshotTableEntry, col->type_lookup);
     MVM_free(col->static_frames);
+    MVM_HASH_DESTROY(hash_handle, MVMHeapSnapshotTableEntry, col->static_frame_lookup);
+
+    if (col->fh)
+        fclose(col->fh);
+    MVM_free(col->path);
 
     MVM_free(col);
     tc->instance->heap_snapshots = NULL;
@@ -827,15 +969,52 @@ MVMObject * collection_to_mvm_objects(MVMThreadContext *tc, MVMHeapSnapshotColle
     return results;
 }
 
+/* Finishes a snapshot stream, returning a hash with the path and number of
+ * snapshots written to it. */
+static MVMObject * finish_stream(MVMThreadContext *tc, MVMHeapSnapshotCollection *col) {
+    MVMObject *results;
+    char      *path = col->path;
+    FILE      *fh   = col->fh;
+    MVMint32   failed;
+
+    putc(MVM_HEAP_SNAPSHOT_CHUNK_END, fh);
+    write_varint(fh, col->num_streamed);
+    failed   = ferror(fh);
+    failed  |= fclose(fh) != 0;
+    col->fh   = NULL;
+    col->path = NULL;
+    if (failed) {
+        char *waste[] = { path, NULL };
+        destroy_heap_snapshot_collection(tc);
+        MVM_exception_throw_adhoc_free(tc, waste,
+            "Failed to write heap snapshot output file '%s'", path);
+    }
+
+    MVM_gc_allocate_gen2_default_set(tc);
+    results = MVM_repr_alloc_init(tc, MVM_hll_current(tc)->slurpy_hash_type);
+    MVM_repr_bind_key_o(tc, results, vmstr(tc, "path"),
+        box_s(tc, vmstr(tc, path)));
+    MVM_repr_bind_key_o(tc, results, vmstr(tc, "snapshots"),
+        MVM_repr_box_int(tc, MVM_hll_current(tc)->int_box_type, col->num_streamed));
+    MVM_gc_allocate_gen2_default_clear(tc);
+
+    MVM_free(path);
+    return results;
+}
+
 /* Finishes heap profiling, getting the data. */
 MVMObject * MVM_profile_heap_end(MVMThreadContext *tc) {
+    MVMHeapSnapshotCollection *col;
     MVMObject *dataset;
 
     /* Trigger a GC run, to ensure we get at least one heap snapshot. */
     MVM_gc_enter_from_allocator(tc);
 
     /* Process and return the data. */
-    dataset = collection_to_mvm_objects(tc, tc->instance->heap_snapshots);
+    col = tc->instance->heap_snapshots;
+    dataset = col->fh
+        ? finish_stream(tc, col)
+        : collection_to_mvm_objects(tc, col);
     destroy_heap_snapshot_collection(tc);
     return dataset;
 }
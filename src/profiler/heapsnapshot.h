@@ -8,25 +8,38 @@ struct MVMHeapSnapshotCollection {
     MVMuint64 num_snapshots;
     MVMuint64 alloc_snapshots;
 
-    /* Known types/REPRs. Just a list for now, but we might like to look at a
-     * hash or trie if this ends up making taking a snapshot wicked slow. */
+    /* Known types/REPRs, with a hash to look them up by their names. */
     MVMHeapSnapshotType *types;
     MVMuint64 num_types;
     MVMuint64 alloc_types;
+    MVMHeapSnapshotTableEntry *type_lookup;
 
-    /* Known static frames. Same applies to searching this as to the above. */
+    /* Known static frames, with a hash to look them up likewise. */
     MVMHeapSnapshotStaticFrame *static_frames;
     MVMuint64 num_static_frames;
     MVMuint64 alloc_static_frames;
+    MVMHeapSnapshotTableEntry *static_frame_lookup;
 
     /* Strings, referenced by index from various places. Also a "should we
-     * free it" flag for each one. */
+     * free it" flag for each one, and a hash to find a string's index. */
     char **strings;
     MVMuint64 num_strings;
     MVMuint64 alloc_strings;
     char *strings_free;
     MVMuint64 num_strings_free;
     MVMuint64 alloc_strings_free;
+    MVMHeapSnapshotStringEntry *string_lookup;
+
+    /* If we were given a path, snapshots are streamed to this file as they
+     * are taken rather than being kept in memory. We track how much of each
+     * of the tables has been written so far, since they are shared by all of
+     * the snapshots and only new entries are written after each one. */
+    char *path;
+    FILE *fh;
+    MVMuint64 num_streamed;
+    MVMuint64 strings_written;
+    MVMuint64 types_written;
+    MVMuint64 static_frames_written;
 };
 
 /* An individual heap snapshot. */
@@ -126,6 +139,55 @@ struct MVMHeapSnapshotReference {
     MVMuint64 collectable_index;
 };
 
+/* Lookup hash entry for the string table. */
+struct MVMHeapSnapshotStringEntry {
+    /* The string, as stored in the table. */
+    char *str;
+
+    /* Its index in the table. */
+    MVMuint64 idx;
+
+    /* Hash handle. */
+    UT_hash_handle hash_handle;
+};
+
+/* Lookup hash entry for the type and static frame tables, keyed on the
+ * fields of the entry (unused ones being zero). */
+struct MVMHeapSnapshotTableEntry {
+    /* The key. */
+    MVMuint64 key[4];
+
+    /* Index of the entry in its table. */
+    MVMuint64 idx;
+
+    /* Hash handle. */
+    UT_hash_handle hash_handle;
+};
+
+/* The streamed snapshot file format. It starts with the magic string and a
+ * format version, followed by a sequence of chunks, each starting with one of
+ * the tag bytes below. All integers are unsigned LEB128 varints.
+ *
+ *   strings        count, then for each string its length and bytes
+ *   types          count, then repr_name,type_name for each
+ *   static frames  count, then name,cuid,line,file for each
+ *   snapshot       number of collectables and references, then for each
+ *                  collectable kind,type_or_frame_index,collectable_size,
+ *                  unmanaged_size,num_refs followed by its references, each
+ *                  written as the description and the zig-zag encoded
+ *                  difference between the target's index and its own
+ *   end            the number of snapshots written
+ *
+ * The table chunks only hold entries added since the previous snapshot, and
+ * entries are numbered in the order they appear across the file. */
+#define MVM_HEAP_SNAPSHOT_MAGIC                 "MOARHEAP"
+#define MVM_HEAP_SNAPSHOT_VERSION               1
+#define MVM_HEAP_SNAPSHOT_CHUNK_STRINGS         's'
+#define MVM_HEAP_SNAPSHOT_CHUNK_TYPES           't'
+#define MVM_HEAP_SNAPSHOT_CHUNK_STATIC_FRAMES   'f'
+#define MVM_HEAP_SNAPSHOT_CHUNK_SNAPSHOT        'h'
+#define MVM_HEAP_SNAPSHOT_CHUNK_END             'e'
+
 /* Current state object whlie taking a heap snapshot. */
 struct MVMHeapSnapshotState {
     /* The heap snapshot collection and current working snapshot. */
@@ -204,8 +204,12 @@ void MVM_profile_instrument(MVMThreadContext *tc, MVMStaticFrame *sf) {
 
         /* Throw away any specializations; we'll need to reproduce them as
          * instrumented versions. */
-        sf->body.num_spesh_candidates = 0;
-        sf->body.spesh_candidates     = NULL;
+        sf->body.num_spesh_candidates         = 0;
+        sf->body.num_retired_spesh_candidates = 0;
+        sf->body.last_spesh_candidate         = 0;
+        sf->body.spesh_candidates             = NULL;
+        sf->body.replaced_spesh_candidates    = NULL;
+        memset(sf->body.spesh_dispatch, 0, sizeof(sf->body.spesh_dispatch));
     }
 }
 
@@ -218,8 +222,12 @@ void MVM_profile_ensure_uninstrumented(MVMThreadContext *tc, MVMStaticFrame *sf)
         sf->body.bytecode_size = sf->body.instrumentation->uninstrumented_bytecode_size;
 
         /* Throw away specializations, which may also be instrumented. */
-        sf->body.num_spesh_candidates = 0;
-        sf->body.spesh_candidates     = NULL;
+        sf->body.num_spesh_candidates         = 0;
+        sf->body.num_retired_spesh_candidates = 0;
+        sf->body.last_spesh_candidate         = 0;
+        sf->body.spesh_candidates             = NULL;
+        sf->body.replaced_spesh_candidates    = NULL;
+        memset(sf->body.spesh_dispatch, 0, sizeof(sf->body.spesh_dispatch));
 
         /* XXX For now, due to bugs, disable spesh here. */
         tc->instance->spesh_enabled = 0;
@@ -0,0 +1,407 @@
+#include "moar.h"
+#include "platform/time.h"
+
+/* A growable C string, for building up collapsed stacks. */
+typedef struct {
+    char   *data;
+    size_t  len;
+    size_t  alloc;
+} SampleText;
+
+static void text_append(SampleText *text, const char *str, size_t len) {
+    if (text->len + len + 1 > text->alloc) {
+        text->alloc = (text->len + len + 1) * 2;
+        text->data  = MVM_realloc(text->data, text->alloc);
+    }
+    memcpy(text->data + text->len, str, len);
+    text->len += len;
+    text->data[text->len] = '\0';
+}
+
+/* Appends a name to a stack, replacing characters that have a meaning in the
+ * collapsed stack format. */
+static void text_append_name(SampleText *text, const char *name) {
+    size_t start = text->len;
+    size_t i;
+    text_append(text, name, strlen(name));
+    for (i = start; i < text->len; i++)
+        if (text->data[i] == ';')
+            text->data[i] = ':';
+        else if (text->data[i] == '\n' || text->data[i] == '\r')
+            text->data[i] = ' ';
+}
+
+/* Appends the description of a sampled frame to a stack. Line numbers are
+ * only resolved for interpreted frames, since the offsets of specialized
+ * frames do not refer to the original bytecode. */
+static void append_frame(MVMThreadContext *tc, SampleText *text, MVMProfileSampleFrame *record) {
+    MVMStaticFrameBody *sfb = &(record->sf->body);
+    MVMString *filename     = sfb->cu->body.filename;
+    char      *name_c       = sfb->name && MVM_string_graphs(tc, sfb->name)
+        ? MVM_string_utf8_encode_C_string(tc, sfb->name)
+        : NULL;
+    char      *filename_c   = filename
+        ? MVM_string_utf8_encode_C_string(tc, filename)
+        : NULL;
+    char       location[32];
+
+    text_append_name(text, name_c ? name_c : "<anon>");
+    text_append(text, " (", 2);
+    text_append_name(text, filename_c ? filename_c : "<ephemeral file>");
+    if (record->kind == MVM_PROFILE_SAMPLE_INTERP) {
+        MVMBytecodeAnnotation *annot = MVM_bytecode_resolve_annotation(tc, sfb,
+            record->offset > 0 ? record->offset - 1 : 0);
+        if (annot) {
+            snprintf(location, sizeof(location), ":%u", annot->line_number);
+            text_append(text, location, strlen(location));
+            MVM_free(annot);
+        }
+    }
+    text_append(text, ")", 1);
+
+    /* Mark up JIT-compiled and specialized frames, the former in the way
+     * that flame graph tools know to colour. */
+    if (record->kind == MVM_PROFILE_SAMPLE_JIT)
+        text_append(text, "_[j]", 4);
+    else if (record->kind == MVM_PROFILE_SAMPLE_SPESH)
+        text_append(text, "_[s]", 4);
+
+    MVM_free(name_c);
+    MVM_free(filename_c);
+}
+
+/* Folds the samples in a buffer into the table of distinct stacks, and empties
+ * it. Must be called with the sampler lock held. */
+static void fold_buffer(MVMThreadContext *tc, MVMProfileSampler *sampler,
+                        MVMProfileSampleBuffer *buffer) {
+    MVMuint32 i = 0;
+    while (i < buffer->used) {
+        MVMuint32              depth = buffer->frames[i].offset;
+        MVMProfileSampleStack *entry = NULL;
+        SampleText             text  = { NULL, 0, 0 };
+        char                   root[32];
+        MVMuint32              j;
+
+        /* Build the stack from the outermost frame inwards. */
+        snprintf(root, sizeof(root), "thread-%u", buffer->thread_id);
+        text_append(&text, root, strlen(root));
+        for (j = depth; j > 0; j--) {
+            text_append(&text, ";", 1);
+            append_frame(tc, &text, &(buffer->frames[i + j]));
+        }
+
+        HASH_FIND(hash_handle, sampler->stacks, text.data, text.len, entry);
+        if (entry) {
+            entry->count++;
+            MVM_free(text.data);
+        }
+        else {
+            entry        = MVM_malloc(sizeof(MVMProfileSampleStack));
+            entry->stack = text.data;
+            entry->count = 1;
+            HASH_ADD_KEYPTR(hash_handle, sampler->stacks, entry->stack, text.len, entry);
+        }
+        sampler->num_samples++;
+
+        i += depth + 1;
+    }
+    buffer->used = 0;
+}
+
+/* Gives a thread a sample buffer, if it doesn't already have one. Must be
+ * called with the sampler lock held. */
+static void register_thread(MVMProfileSampler *sampler, MVMThreadContext *thread_tc) {
+    MVMProfileSampleBuffer *buffer;
+    if (thread_tc->sample_buffer)
+        return;
+    buffer            = MVM_calloc(1, sizeof(MVMProfileSampleBuffer));
+    buffer->tc        = thread_tc;
+    buffer->thread_id = thread_tc->thread_id;
+    buffer->frames    = MVM_malloc(MVM_PROFILE_SAMPLE_BUFFER_SIZE * sizeof(MVMProfileSampleFrame));
+    buffer->next      = sampler->buffers;
+    sampler->buffers  = buffer;
+    thread_tc->sample_buffer = buffer;
+}
+
+/* The sampler thread. Each interval, it flags all registered threads as having
+ * a sample pending. */
+static void sampler_thread(void *data) {
+    MVMProfileSampler *sampler = (MVMProfileSampler *)data;
+    while (MVM_load(&sampler->active)) {
+        MVMProfileSampleBuffer *buffer;
+        MVM_platform_sleep(sampler->interval / 1e6);
+        uv_mutex_lock(&sampler->lock);
+        for (buffer = sampler->buffers; buffer; buffer = buffer->next)
+            if (buffer->tc)
+                MVM_store(&(buffer->tc->sample_pending), 1);
+        uv_mutex_unlock(&sampler->lock);
+    }
+}
+
+/* Starts sampling profiling. The config hash may specify the interval between
+ * samples in microseconds, and a path to write the collapsed stacks to. */
+void MVM_profile_sampling_start(MVMThreadContext *tc, MVMObject *config) {
+    MVMInstance       *instance = tc->instance;
+    MVMProfileSampler *sampler;
+    MVMThread         *thread;
+    MVMuint64          interval = MVM_PROFILE_SAMPLE_INTERVAL;
+    char              *path     = NULL;
+
+    if (MVM_repr_exists_key(tc, config, instance->str_consts.interval)) {
+        MVMint64 value = MVM_repr_get_int(tc,
+            MVM_repr_at_key_o(tc, config, instance->str_consts.interval));
+        if (value <= 0)
+            MVM_exception_throw_adhoc(tc, "Sampling interval must be positive");
+        interval = (MVMuint64)value;
+    }
+    if (MVM_repr_exists_key(tc, config, instance->str_consts.path))
+        path = MVM_string_utf8_c8_encode_C_string(tc, MVM_repr_get_str(tc,
+            MVM_repr_at_key_o(tc, config, instance->str_consts.path)));
+
+    if (!instance->sampler) {
+        sampler = MVM_calloc(1, sizeof(MVMProfileSampler));
+        uv_mutex_init(&sampler->lock);
+        instance->sampler = sampler;
+    }
+    sampler = instance->sampler;
+
+    /* Turn sampling on and register the threads that are already running;
+     * threads started from now on register themselves. The threads list
+     * lock is taken first, so nothing is added to it while we walk it. */
+    MVM_gc_mark_thread_blocked(tc);
+    uv_mutex_lock(&instance->mutex_threads);
+    MVM_gc_mark_thread_unblocked(tc);
+    uv_mutex_lock(&sampler->lock);
+    sampler->interval = interval;
+    sampler->path     = path;
+    MVM_store(&sampler->active, 1);
+    register_thread(sampler, tc);
+    thread = instance->threads;
+    while (thread) {
+        AO_t stage = MVM_load(&thread->body.stage);
+        if (thread->body.tc && (stage == MVM_thread_stage_starting ||
+                stage == MVM_thread_stage_waiting || stage == MVM_thread_stage_started))
+            register_thread(sampler, thread->body.tc);
+        thread = thread->body.next;
+    }
+    uv_mutex_unlock(&sampler->lock);
+    uv_mutex_unlock(&instance->mutex_threads);
+
+    if (uv_thread_create(&sampler->thread, sampler_thread, sampler) != 0) {
+        MVM_store(&sampler->active, 0);
+        MVM_exception_throw_adhoc(tc, "Could not start sampling profiler thread");
+    }
+}
+
+/* Checks if sampling profiling is turned on. */
+MVMint32 MVM_profile_sampling_active(MVMThreadContext *tc) {
+    MVMProfileSampler *sampler = tc->instance->sampler;
+    return sampler && MVM_load(&sampler->active);
+}
+
+/* Records the current call stack of the thread into its sample buffer. This
+ * makes no GC allocations, since it is called from GC sync points. */
+void MVM_profile_sampling_take(MVMThreadContext *tc) {
+    MVMProfileSampler      *sampler = tc->instance->sampler;
+    MVMProfileSampleBuffer *buffer;
+
+    MVM_store(&(tc->sample_pending), 0);
+    if (!sampler)
+        return;
+
+    uv_mutex_lock(&sampler->lock);
+    buffer = tc->sample_buffer;
+    if (buffer && MVM_load(&sampler->active)) {
+        MVMFrame  *frame = tc->cur_frame;
+        MVMuint32  depth = 0;
+        MVMuint32  header;
+
+        if (buffer->used + MVM_PROFILE_SAMPLE_MAX_DEPTH + 1 > MVM_PROFILE_SAMPLE_BUFFER_SIZE)
+            fold_buffer(tc, sampler, buffer);
+
+        header = buffer->used++;
+        while (frame && depth < MVM_PROFILE_SAMPLE_MAX_DEPTH) {
+            MVMProfileSampleFrame *record = &(buffer->frames[buffer->used++]);
+            MVMuint8              *cur_op = frame != tc->cur_frame
+                ? frame->return_address
+                : tc->interp_cur_op ? *(tc->interp_cur_op) : NULL;
+
+            record->sf   = frame->static_info;
+            record->kind = !frame->spesh_cand
+                ? MVM_PROFILE_SAMPLE_INTERP
+                : frame->spesh_cand->jitcode
+                    ? MVM_PROFILE_SAMPLE_JIT
+                    : MVM_PROFILE_SAMPLE_SPESH;
+            record->offset = cur_op && frame->effective_bytecode && cur_op >= frame->effective_bytecode
+                ? (MVMuint32)(cur_op - frame->effective_bytecode)
+                : 0;
+
+            depth++;
+            frame = frame->caller;
+        }
+
+        buffer->frames[header].sf     = NULL;
+        buffer->frames[header].offset = depth;
+        buffer->frames[header].kind   = 0;
+    }
+    uv_mutex_unlock(&sampler->lock);
+}
+
+/* Registers a newly started thread, if sampling is on. */
+void MVM_profile_sampling_thread_start(MVMThreadContext *tc) {
+    MVMProfileSampler *sampler = tc->instance->sampler;
+    if (!sampler)
+        return;
+    uv_mutex_lock(&sampler->lock);
+    if (MVM_load(&sampler->active))
+        register_thread(sampler, tc);
+    uv_mutex_unlock(&sampler->lock);
+}
+
+/* Called when a thread context is being destroyed; its buffer stays around
+ * until profiling ends, but is no longer flagged. */
+void MVM_profile_sampling_thread_gone(MVMThreadContext *tc) {
+    MVMProfileSampler *sampler = tc->instance->sampler;
+    if (!sampler)
+        return;
+    uv_mutex_lock(&sampler->lock);
+    if (tc->sample_buffer) {
+        tc->sample_buffer->tc = NULL;
+        tc->sample_buffer     = NULL;
+    }
+    uv_mutex_unlock(&sampler->lock);
+}
+
+/* Adds a value to the result hash under the given key. */
+static void bind_result(MVMThreadContext *tc, MVMObject *hash, const char *name, MVMObject *value) {
+    MVMROOT(tc, hash, {
+    MVMROOT(tc, value, {
+        MVMString *key = MVM_string_ascii_decode_nt(tc, tc->instance->VMString, name);
+        MVM_repr_bind_key_o(tc, hash, key, value);
+    });
+    });
+}
+
+/* Ends sampling profiling. Returns a hash with the total number of samples
+ * and the collapsed stacks, one "frame;frame;frame count" line per distinct
+ * stack, which are also written to the configured path, if any. */
+MVMObject * MVM_profile_sampling_end(MVMThreadContext *tc) {
+    MVMProfileSampler      *sampler = tc->instance->sampler;
+    MVMProfileSampleBuffer *buffer;
+    MVMProfileSampleStack  *entry, *tmp;
+    unsigned                bucket_tmp;
+    SampleText              text = { NULL, 0, 0 };
+    MVMuint64               num_samples;
+    char                   *path;
+    MVMObject              *result;
+    MVMObject              *boxed;
+    MVMString              *collapsed;
+
+    /* Stop the sampler thread. */
+    MVM_store(&sampler->active, 0);
+    MVM_gc_mark_thread_blocked(tc);
+    uv_thread_join(&sampler->thread);
+    MVM_gc_mark_thread_unblocked(tc);
+
+    /* Fold and free all of the buffers, then turn the stacks table into the
+     * output. */
+    uv_mutex_lock(&sampler->lock);
+    buffer = sampler->buffers;
+    while (buffer) {
+        MVMProfileSampleBuffer *next = buffer->next;
+        fold_buffer(tc, sampler, buffer);
+        if (buffer->tc)
+            buffer->tc->sample_buffer = NULL;
+        MVM_free(buffer->frames);
+        MVM_free(buffer);
+        buffer = next;
+    }
+    sampler->buffers = NULL;
+    text_append(&text, "", 0);
+    HASH_ITER(hash_handle, sampler->stacks, entry, tmp, bucket_tmp) {
+        char count[32];
+        snprintf(count, sizeof(count), " %"PRIu64"\n", entry->count);
+        text_append(&text, entry->stack, strlen(entry->stack));
+        text_append(&text, count, strlen(count));
+        HASH_DELETE(hash_handle, sampler->stacks, entry);
+        MVM_free(entry->stack);
+        MVM_free(entry);
+    }
+    num_samples          = sampler->num_samples;
+    sampler->num_samples = 0;
+    path                 = sampler->path;
+    sampler->path        = NULL;
+    uv_mutex_unlock(&sampler->lock);
+
+    /* Write the output file, if we were asked to. */
+    if (path) {
+        FILE *fh = fopen(path, "w");
+        if (!fh) {
+            char *waste[] = { path, text.data, NULL };
+            MVM_exception_throw_adhoc_free(tc, waste,
+                "Could not open sampling profile output file '%s': %s", path, strerror(errno));
+        }
+        fwrite(text.data, 1, text.len, fh);
+        fclose(fh);
+        MVM_free(path);
+    }
+
+    /* Build the result. */
+    collapsed = MVM_string_utf8_decode(tc, tc->instance->VMString, text.data, text.len);
+    MVM_free(text.data);
+    MVMROOT(tc, collapsed, {
+        result = MVM_repr_alloc_init(tc, tc->instance->boot_types.BOOTHash);
+        MVMROOT(tc, result, {
+            boxed = MVM_repr_box_str(tc, tc->instance->boot_types.BOOTStr, collapsed);
+            bind_result(tc, result, "collapsed", boxed);
+            boxed = MVM_repr_box_int(tc, tc->instance->boot_types.BOOTInt, (MVMint64)num_samples);
+            bind_result(tc, result, "samples", boxed);
+        });
+    });
+    return result;
+}
+
+/* Marks the static frames referenced from sample buffers. */
+void MVM_profile_sampling_mark_data(MVMThreadContext *tc, MVMGCWorklist *worklist) {
+    MVMProfileSampler      *sampler = tc->instance->sampler;
+    MVMProfileSampleBuffer *buffer;
+    if (!sampler)
+        return;
+    for (buffer = sampler->buffers; buffer; buffer = buffer->next) {
+        MVMuint32 i;
+        for (i = 0; i < buffer->used; i++)
+            if (buffer->frames[i].sf)
+                MVM_gc_worklist_add(tc, worklist, &(buffer->frames[i].sf));
+    }
+}
+
+/* Frees the sampler when the instance is destroyed. */
+void MVM_profile_sampling_destroy(MVMInstance *instance) {
+    MVMProfileSampler      *sampler = instance->sampler;
+    MVMProfileSampleBuffer *buffer;
+    MVMProfileSampleStack  *entry, *tmp;
+    unsigned                bucket_tmp;
+    MVMThreadContext       *tc = instance->main_thread;
+    if (!sampler)
+        return;
+    if (MVM_load(&sampler->active)) {
+        MVM_store(&sampler->active, 0);
+        uv_thread_join(&sampler->thread);
+    }
+    buffer = sampler->buffers;
+    while (buffer) {
+        MVMProfileSampleBuffer *next = buffer->next;
+        MVM_free(buffer->frames);
+        MVM_free(buffer);
+        buffer = next;
+    }
+    HASH_ITER(hash_handle, sampler->stacks, entry, tmp, bucket_tmp) {
+        HASH_DELETE(hash_handle, sampler->stacks, entry);
+        MVM_free(entry->stack);
+        MVM_free(entry);
+    }
+    MVM_free(sampler->path);
+    uv_mutex_destroy(&sampler->lock);
+    MVM_free(sampler);
+    instance->sampler = NULL;
+}
@@ -0,0 +1,94 @@
+/* The sampling profiler. Rather than instrumenting every frame, a dedicated
+ * thread wakes up every interval and flags each registered thread as having a
+ * sample pending. A thread notices this at its next GC sync point or frame
+ * invocation, and records its call stack into a per-thread buffer. Full
+ * buffers are folded into a table of distinct stacks, which is output in the
+ * collapsed stack format read by flame graph tools when profiling ends. */
+
+/* Default sampling interval, in microseconds. */
+#define MVM_PROFILE_SAMPLE_INTERVAL     1000
+
+/* Number of frame records in a thread's sample buffer. */
+#define MVM_PROFILE_SAMPLE_BUFFER_SIZE  16384
+
+/* Deepest stack we record; deeper stacks are truncated at the root end. */
+#define MVM_PROFILE_SAMPLE_MAX_DEPTH    256
+
+/* What kind of code a sampled frame was running. */
+#define MVM_PROFILE_SAMPLE_INTERP       0
+#define MVM_PROFILE_SAMPLE_SPESH        1
+#define MVM_PROFILE_SAMPLE_JIT          2
+
+/* A record in a sample buffer. Each sample starts with a header record with a
+ * NULL sf and the number of frames in offset, followed by the frames from the
+ * innermost outwards. */
+struct MVMProfileSampleFrame {
+    /* The static frame, or NULL for a header. */
+    MVMStaticFrame *sf;
+
+    /* Bytecode offset in the frame, or the depth for a header. */
+    MVMuint32 offset;
+
+    /* One of the MVM_PROFILE_SAMPLE_* kinds. */
+    MVMuint32 kind;
+};
+
+/* Samples recorded by a thread and not yet folded into the stacks table. */
+struct MVMProfileSampleBuffer {
+    /* The thread the buffer belongs to; NULL once it has been destroyed. */
+    MVMThreadContext *tc;
+    MVMuint32 thread_id;
+
+    /* The records and how many of them are in use. */
+    MVMProfileSampleFrame *frames;
+    MVMuint32 used;
+
+    /* Next buffer in the sampler's list. */
+    MVMProfileSampleBuffer *next;
+};
+
+/* An entry in the table of distinct collapsed stacks. */
+struct MVMProfileSampleStack {
+    char *stack;
+    MVMuint64 count;
+    UT_hash_handle hash_handle;
+};
+
+/* State of the sampling profiler. Once created this lives as long as the
+ * instance, so that threads never see it go away. Everything apart from the
+ * active flag is protected by the lock. */
+struct MVMProfileSampler {
+    uv_mutex_t lock;
+
+    /* Whether sampling is currently turned on. */
+    AO_t active;
+
+    /* The thread that raises the sample flags, and the interval it uses. */
+    uv_thread_t thread;
+    MVMuint64   interval;
+
+    /* Where to write the collapsed stacks to, if anywhere. */
+    char *path;
+
+    /* Buffers of registered threads. */
+    MVMProfileSampleBuffer *buffers;
+
+    /* Distinct stacks seen so far, and the total number of samples. */
+    MVMProfileSampleStack *stacks;
+    MVMuint64 num_samples;
+};
+
+/* Checks if a sample has been requested, and takes it if so. */
+#define MVM_PROFILE_SAMPLE_POINT(tc) \
+    if (tc->sample_pending) { \
+        MVM_profile_sampling_take(tc); \
+    }
+
+void MVM_profile_sampling_start(MVMThreadContext *tc, MVMObject *config);
+MVMObject * MVM_profile_sampling_end(MVMThreadContext *tc);
+MVMint32 MVM_profile_sampling_active(MVMThreadContext *tc);
+void MVM_profile_sampling_take(MVMThreadContext *tc);
+void MVM_profile_sampling_thread_start(MVMThreadContext *tc);
+void MVM_profile_sampling_thread_gone(MVMThreadContext *tc);
+void MVM_profile_sampling_mark_data(MVMThreadContext *tc, MVMGCWorklist *worklist);
+void MVM_profile_sampling_destroy(MVMInstance *instance);
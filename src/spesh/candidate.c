@@ -19,6 +19,57 @@ static void calculate_work_env_sizes(MVMThreadContext *tc, MVMStaticFrame *sf,
     c->env_size = c->num_lexicals * sizeof(MVMRegister);
 }
 
+/* Candidates are indexed for dispatch on their callsite and the type their
+ * first argument must have, if they guard on it directly; candidates that
+ * don't are found under a type ID of zero. */
+static MVMuint32 dispatch_bucket(MVMCallsite *cs, MVMuint64 type_id) {
+    MVMuint64 h = ((MVMuint64)(uintptr_t)cs >> 4) ^ (type_id / MVM_TYPE_CACHE_ID_INCR);
+    return (MVMuint32)((h * 0x9E3779B97F4A7C15ULL) >> 32) % MVM_SPESH_DISPATCH_BUCKETS;
+}
+
+static MVMuint64 dispatch_type_id(MVMSpeshCandidate *cand) {
+    MVMuint32 i;
+    for (i = 0; i < cand->num_guards; i++)
+        if (cand->guards[i].slot == 0 && (cand->guards[i].kind == MVM_SPESH_GUARD_CONC ||
+                cand->guards[i].kind == MVM_SPESH_GUARD_TYPE))
+            return ((MVMSTable *)cand->guards[i].match)->type_cache_id;
+    return 0;
+}
+
+/* Adds a candidate to the front of its dispatch chain, or removes it. Must
+ * be called with mutex_spesh_install held. Readers walk the chains without
+ * a lock; a removed candidate keeps its link onwards, so a reader that is
+ * on it still reaches the rest of the chain. */
+static void dispatch_link(MVMStaticFrameBody *body, MVMuint32 idx) {
+    MVMSpeshCandidate *cand   = MVM_spesh_candidate_at(body, idx);
+    MVMuint32          bucket = dispatch_bucket(cand->cs, cand->dispatch_type_id);
+    cand->dispatch_next = body->spesh_dispatch[bucket];
+    MVM_barrier();
+    body->spesh_dispatch[bucket] = (MVMuint8)(idx + 1);
+}
+
+static void dispatch_unlink(MVMStaticFrameBody *body, MVMuint32 idx) {
+    MVMSpeshCandidate *cand = MVM_spesh_candidate_at(body, idx);
+    MVMuint8          *link = &body->spesh_dispatch[dispatch_bucket(cand->cs, cand->dispatch_type_id)];
+    while (*link && *link != idx + 1)
+        link = &MVM_spesh_candidate_at(body, *link - 1)->dispatch_next;
+    if (*link)
+        *link = cand->dispatch_next;
+}
+
+/* Finds the slot of a retired candidate that a new one may take over once
+ * all slots are used, or returns -1. A slot is only reused so many times,
+ * since references to it carry its generation. */
+static MVMint32 reusable_slot(MVMStaticFrameBody *body) {
+    MVMuint32 i;
+    for (i = 0; i < body->num_spesh_candidates; i++) {
+        MVMSpeshCandidate *cand = MVM_spesh_candidate_at(body, i);
+        if (cand->retired && cand->generation < MVM_SPESH_MAX_GENERATION)
+            return i;
+    }
+    return -1;
+}
+
 /* Tries to set up a specialization of the bytecode for a given arg tuple.
  * Doesn't do the actual optimizations, just works out the guards and does
  * any simple argument transformations, and then inserts logging to record
@@ -36,6 +87,7 @@ MVMSpeshCandidate * MVM_spesh_candidate_setup(MVMThreadContext *tc,
     char *before = 0;
     char *after = 0;
     MVMSpeshGraph *sg;
+    MVMuint64 start_time = 0;
 
     /* If we've reached our specialization limit, don't continue. */
     if (tc->instance->spesh_limit)
@@ -49,6 +101,11 @@ MVMSpeshCandidate * MVM_spesh_candidate_setup(MVMThreadContext *tc,
 #if MVM_GC_DEBUG
     tc->in_spesh = 1;
 #endif
+    if (tc->instance->spesh_event_log) {
+        start_time = uv_hrtime();
+        MVM_spesh_event(tc, MVM_SPESH_EVENT_SPESH_START, MVM_SPESH_EVENT_PHASE_LOGGING,
+            static_frame, 0, 0);
+    }
 
     /* Do initial generation of the specialization, working out the argument
      * guards and adding logging. */
@@ -73,28 +130,41 @@ MVMSpeshCandidate * MVM_spesh_candidate_setup(MVMThreadContext *tc,
 
     /* Now try to add it. Note there's a slim chance another thread beat us
      * to doing so. Also other threads can read the specializations without
-     * lock, so make absolutely sure we increment the count of them after we
-     * add the new one. */
+     * lock, so make absolutely sure we increment the count of them, or put
+     * the new one in a reused slot, only after it is filled out. */
     result    = NULL;
     used      = 0;
     uv_mutex_lock(&tc->instance->mutex_spesh_install);
-    if (static_frame->body.num_spesh_candidates < MVM_SPESH_LIMIT) {
+    {
         MVMint32 num_spesh = static_frame->body.num_spesh_candidates;
+        MVMint32 slot      = num_spesh < MVM_SPESH_MAX_CANDIDATES
+            ? num_spesh
+            : reusable_slot(&static_frame->body);
         MVMint32 i;
         for (i = 0; i < num_spesh; i++) {
-            MVMSpeshCandidate *compare = &static_frame->body.spesh_candidates[i];
+            MVMSpeshCandidate *compare = MVM_spesh_candidate_at(&static_frame->body, i);
             if (compare->cs == callsite && compare->num_guards == num_guards &&
                 memcmp(compare->guards, guards, num_guards * sizeof(MVMSpeshGuard)) == 0) {
-                /* Beaten! */
-                result = osr ? NULL : &static_frame->body.spesh_candidates[i];
+                /* Beaten! If it was retired for being cold, it's evidently
+                 * wanted again. */
+                if (compare->retired) {
+                    compare->retired = 0;
+                    compare->hits    = 0;
+                    static_frame->body.num_retired_spesh_candidates--;
+                    dispatch_link(&static_frame->body, i);
+                }
+                result = osr ? NULL : compare;
                 break;
             }
         }
-        if (!result) {
+        if (!result && slot >= 0) {
+            MVMSpeshCandidate *replaced = slot < num_spesh
+                ? MVM_spesh_candidate_at(&static_frame->body, slot)
+                : NULL;
             if (!static_frame->body.spesh_candidates)
                 static_frame->body.spesh_candidates = MVM_calloc(
-                    MVM_SPESH_LIMIT, sizeof(MVMSpeshCandidate));
-            result                      = &static_frame->body.spesh_candidates[num_spesh];
+                    MVM_SPESH_MAX_CANDIDATES, sizeof(MVMSpeshCandidate *));
+            result                      = MVM_calloc(1, sizeof(MVMSpeshCandidate));
             result->cs                  = callsite;
             result->num_guards          = num_guards;
             result->guards              = guards;
@@ -116,10 +186,25 @@ MVMSpeshCandidate * MVM_spesh_candidate_setup(MVMThreadContext *tc,
             result->log_enter_idx       = 0;
             result->log_exits_remaining = MVM_SPESH_LOG_RUNS;
             calculate_work_env_sizes(tc, static_frame, result);
+            result->dispatch_type_id    = dispatch_type_id(result);
             if (osr)
                 result->osr_logging = 1;
-            MVM_barrier();
-            static_frame->body.num_spesh_candidates++;
+            if (replaced) {
+                /* The retired candidate may still be running, or be called
+                 * by code holding a reference to its slot, so keep it. */
+                result->generation      = replaced->generation + 1;
+                replaced->next_replaced = static_frame->body.replaced_spesh_candidates;
+                static_frame->body.replaced_spesh_candidates = replaced;
+                static_frame->body.num_retired_spesh_candidates--;
+                MVM_barrier();
+                static_frame->body.spesh_candidates[slot] = result;
+            }
+            else {
+                static_frame->body.spesh_candidates[slot] = result;
+                MVM_barrier();
+                static_frame->body.num_spesh_candidates++;
+            }
+            dispatch_link(&static_frame->body, slot);
             if (static_frame->common.header.flags & MVM_CF_SECOND_GEN)
                 MVM_gc_write_barrier_hit(tc, (MVMCollectable *)static_frame);
             if (tc->instance->spesh_log_fh) {
@@ -152,6 +237,9 @@ MVMSpeshCandidate * MVM_spesh_candidate_setup(MVMThreadContext *tc,
 #if MVM_GC_DEBUG
     tc->in_spesh = 0;
 #endif
+    if (tc->instance->spesh_event_log)
+        MVM_spesh_event(tc, MVM_SPESH_EVENT_SPESH_FINISH, MVM_SPESH_EVENT_PHASE_LOGGING,
+            static_frame, 0, uv_hrtime() - start_time);
 
     MVM_free(sc);
     return result;
@@ -166,6 +254,7 @@ void MVM_spesh_candidate_specialize(MVMThreadContext *tc, MVMStaticFrame *static
     MVMSpeshCode  *sc;
     MVMSpeshGraph *sg;
     MVMJitGraph   *jg = NULL;
+    MVMuint64      start_time = 0;
 
     /* If we're profiling or GC debugging, log we're starting spesh work. */
     if (tc->instance->profiling)
@@ -173,6 +262,11 @@ void MVM_spesh_candidate_specialize(MVMThreadContext *tc, MVMStaticFrame *static
 #if MVM_GC_DEBUG
     tc->in_spesh = 1;
 #endif
+    if (tc->instance->spesh_event_log) {
+        start_time = uv_hrtime();
+        MVM_spesh_event(tc, MVM_SPESH_EVENT_SPESH_START, MVM_SPESH_EVENT_PHASE_OPTIMIZE,
+            static_frame, 0, 0);
+    }
 
     /* Obtain the graph, add facts, and do optimization work. */
     sg = candidate->sg;
@@ -254,6 +348,12 @@ void MVM_spesh_candidate_specialize(MVMThreadContext *tc, MVMStaticFrame *static
 #if MVM_GC_DEBUG
     tc->in_spesh = 0;
 #endif
+    if (tc->instance->spesh_event_log) {
+        MVM_spesh_event(tc, MVM_SPESH_EVENT_SPESH_FINISH, MVM_SPESH_EVENT_PHASE_OPTIMIZE,
+            static_frame, 0, uv_hrtime() - start_time);
+        MVM_spesh_event(tc, MVM_SPESH_EVENT_CANDIDATE_INSTALLED, candidate->jitcode != NULL,
+            static_frame, 0, candidate->bytecode_size);
+    }
 }
 
 
@@ -272,3 +372,180 @@ void MVM_spesh_candidate_destroy(MVMThreadContext *tc, MVMSpeshCandidate *candid
     if (candidate->jitcode)
         MVM_jit_destroy_code(tc, candidate->jitcode);
 }
+
+/* Destroys all candidates of a static frame, including replaced ones, and
+ * their storage. */
+void MVM_spesh_candidate_destroy_all(MVMThreadContext *tc, MVMStaticFrameBody *body) {
+    MVMSpeshCandidate *cand = body->replaced_spesh_candidates;
+    MVMuint32 i;
+    for (i = 0; i < body->num_spesh_candidates; i++) {
+        MVM_spesh_candidate_destroy(tc, MVM_spesh_candidate_at(body, i));
+        MVM_free(MVM_spesh_candidate_at(body, i));
+    }
+    MVM_free(body->spesh_candidates);
+    while (cand) {
+        MVMSpeshCandidate *next = cand->next_replaced;
+        MVM_spesh_candidate_destroy(tc, cand);
+        MVM_free(cand);
+        cand = next;
+    }
+}
+
+/* Checks if the incoming arguments satisfy a candidate's guards. */
+static MVMint32 guards_match(MVMThreadContext *tc, MVMSpeshCandidate *cand, MVMRegister *args) {
+    MVMuint32 j;
+    for (j = 0; j < cand->num_guards; j++) {
+        MVMint32   pos = cand->guards[j].slot;
+        MVMSTable *st  = (MVMSTable *)cand->guards[j].match;
+        MVMObject *arg = args[pos].o;
+        if (!arg)
+            return 0;
+        switch (cand->guards[j].kind) {
+        case MVM_SPESH_GUARD_CONC:
+            if (!IS_CONCRETE(arg) || STABLE(arg) != st)
+                return 0;
+            break;
+        case MVM_SPESH_GUARD_TYPE:
+            if (IS_CONCRETE(arg) || STABLE(arg) != st)
+                return 0;
+            break;
+        case MVM_SPESH_GUARD_DC_CONC: {
+            MVMRegister dc;
+            STABLE(arg)->container_spec->fetch(tc, arg, &dc);
+            if (!dc.o || !IS_CONCRETE(dc.o) || STABLE(dc.o) != st)
+                return 0;
+            break;
+        }
+        case MVM_SPESH_GUARD_DC_TYPE: {
+            MVMRegister dc;
+            STABLE(arg)->container_spec->fetch(tc, arg, &dc);
+            if (!dc.o || IS_CONCRETE(dc.o) || STABLE(dc.o) != st)
+                return 0;
+            break;
+        }
+        case MVM_SPESH_GUARD_DC_CONC_RW: {
+            MVMRegister dc;
+            if (!STABLE(arg)->container_spec->can_store(tc, arg))
+                return 0;
+            STABLE(arg)->container_spec->fetch(tc, arg, &dc);
+            if (!dc.o || !IS_CONCRETE(dc.o) || STABLE(dc.o) != st)
+                return 0;
+            break;
+        }
+        case MVM_SPESH_GUARD_DC_TYPE_RW: {
+            MVMRegister dc;
+            if (!STABLE(arg)->container_spec->can_store(tc, arg))
+                return 0;
+            STABLE(arg)->container_spec->fetch(tc, arg, &dc);
+            if (!dc.o || IS_CONCRETE(dc.o) || STABLE(dc.o) != st)
+                return 0;
+            break;
+        }
+        }
+    }
+    return 1;
+}
+
+/* Walks the dispatch chain for a callsite and first argument type, looking
+ * for a candidate whose guards match, other than the one at index skip. */
+static MVMSpeshCandidate * find_in_chain(MVMThreadContext *tc, MVMStaticFrameBody *body,
+        MVMCallsite *callsite, MVMuint64 type_id, MVMRegister *args, MVMuint32 skip) {
+    MVMuint32 idx = body->spesh_dispatch[dispatch_bucket(callsite, type_id)];
+    while (idx) {
+        MVMSpeshCandidate *cand = MVM_spesh_candidate_at(body, idx - 1);
+        if (idx - 1 != skip && cand->cs == callsite && cand->dispatch_type_id == type_id
+                && !cand->retired && guards_match(tc, cand, args)) {
+            cand->hits++;
+            body->last_spesh_candidate = idx - 1;
+            return cand;
+        }
+        idx = cand->dispatch_next;
+    }
+    return NULL;
+}
+
+/* Finds a live specialization whose callsite and guards match the incoming
+ * arguments, or returns NULL. The most recently matched candidate is tried
+ * first, which makes the common monomorphic case a single guard check no
+ * matter how many candidates there are. After that, only the candidates
+ * indexed under the callsite and the type of the first argument, and then
+ * those with the callsite that don't guard on the first argument's type,
+ * have their guards checked; retired candidates are not in the index. */
+MVMSpeshCandidate * MVM_spesh_candidate_find(MVMThreadContext *tc, MVMStaticFrame *static_frame,
+        MVMCallsite *callsite, MVMRegister *args) {
+    MVMStaticFrameBody *body      = &static_frame->body;
+    MVMuint32           num_spesh = body->num_spesh_candidates;
+    MVMuint32           last      = body->last_spesh_candidate;
+    MVMSpeshCandidate  *found;
+    if (!num_spesh)
+        return NULL;
+    if (last < num_spesh) {
+        MVMSpeshCandidate *cand = MVM_spesh_candidate_at(body, last);
+        if (cand->cs == callsite && !cand->retired && guards_match(tc, cand, args)) {
+            cand->hits++;
+            return cand;
+        }
+    }
+    if (callsite->num_pos && (callsite->arg_flags[0] & MVM_CALLSITE_ARG_MASK) == MVM_CALLSITE_ARG_OBJ
+            && args[0].o) {
+        found = find_in_chain(tc, body, callsite, STABLE(args[0].o)->type_cache_id, args, last);
+        if (found)
+            return found;
+    }
+    found = find_in_chain(tc, body, callsite, 0, args, last);
+    if (found)
+        return found;
+    if (tc->instance->spesh_event_log)
+        MVM_spesh_event(tc, MVM_SPESH_EVENT_GUARD_FAIL, 0, static_frame, 0, num_spesh);
+    return NULL;
+}
+
+/* Looks for a candidate that gets only a tiny share of the dispatches and
+ * retires it. Candidates still being produced are never retired. The hit
+ * counts are halved afterwards, so coldness reflects recent behavior. */
+static MVMint32 retire_cold_candidate(MVMThreadContext *tc, MVMStaticFrameBody *body) {
+    MVMSpeshCandidate *coldest     = NULL;
+    MVMuint32          coldest_idx = 0;
+    MVMuint64          total       = 0;
+    MVMuint32          i;
+    MVMint32           retired     = 0;
+
+    uv_mutex_lock(&tc->instance->mutex_spesh_install);
+    for (i = 0; i < body->num_spesh_candidates; i++) {
+        MVMSpeshCandidate *cand = MVM_spesh_candidate_at(body, i);
+        if (cand->retired || cand->sg)
+            continue;
+        total += cand->hits;
+        if (!coldest || cand->hits < coldest->hits) {
+            coldest     = cand;
+            coldest_idx = i;
+        }
+    }
+    if (coldest && (MVMuint64)coldest->hits * MVM_SPESH_RETIRE_RATIO < total) {
+        coldest->retired = 1;
+        body->num_retired_spesh_candidates++;
+        dispatch_unlink(body, coldest_idx);
+        retired = 1;
+    }
+    for (i = 0; i < body->num_spesh_candidates; i++)
+        MVM_spesh_candidate_at(body, i)->hits /= 2;
+    uv_mutex_unlock(&tc->instance->mutex_spesh_install);
+
+    return retired;
+}
+
+/* Checks if another specialization may be produced for the static frame.
+ * When the live candidates are at the limit, each dispatch miss counts
+ * towards looking for a cold one to retire to make room. */
+MVMint32 MVM_spesh_candidate_has_room(MVMThreadContext *tc, MVMStaticFrame *static_frame) {
+    MVMStaticFrameBody *body = &static_frame->body;
+    if (body->num_spesh_candidates - body->num_retired_spesh_candidates >= MVM_SPESH_LIMIT) {
+        if (++body->spesh_dispatch_misses < MVM_SPESH_RETIRE_MISSES)
+            return 0;
+        body->spesh_dispatch_misses = 0;
+        if (!retire_cold_candidate(tc, body))
+            return 0;
+    }
+    return body->num_spesh_candidates < MVM_SPESH_MAX_CANDIDATES
+        || reusable_slot(body) >= 0;
+}
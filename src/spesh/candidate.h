@@ -84,10 +84,60 @@ struct MVMSpeshCandidate {
 
     /* JIT-code structure */
     MVMJitCode *jitcode;
+
+    /* Rough count of the times this candidate was picked by the dispatcher,
+     * used to spot cold candidates. May lose the odd count when threads
+     * race, which is fine. */
+    MVMuint32 hits;
+
+    /* Whether the candidate has been retired for being cold. Retired
+     * candidates stay valid for any frame or code still using them, but
+     * the dispatcher no longer picks them. */
+    MVMuint32 retired;
+
+    /* The type cache ID of the type the candidate requires its first
+     * argument to have, or zero if it doesn't guard on it directly, and the
+     * next candidate (index plus one) in its dispatch chain. */
+    MVMuint64 dispatch_type_id;
+    MVMuint8  dispatch_next;
+
+    /* How many times the candidate's slot has been reused; see
+     * MVM_spesh_candidate_ref. */
+    MVMuint16 generation;
+
+    /* The next candidate that was replaced in its slot by a newer one. Such
+     * candidates are kept alive, as frames may still be running them. */
+    MVMSpeshCandidate *next_replaced;
 };
 
-/* The number of specializations we'll allow per static frame. */
-#define MVM_SPESH_LIMIT 4
+/* The number of specializations in active use we'll allow per static frame.
+ * Once reached, the coldest one may be retired to make room for another. */
+#define MVM_SPESH_LIMIT 16
+
+/* The number of slots for specializations of a static frame. Once all are
+ * used, a new specialization can only take the slot of a retired one. */
+#define MVM_SPESH_CANDIDATE_IDX_BITS 6
+#define MVM_SPESH_MAX_CANDIDATES     (1 << MVM_SPESH_CANDIDATE_IDX_BITS)
+
+/* How many dispatch misses a frame that is at the limit takes between looks
+ * for a cold candidate to retire, and how many times hotter than a candidate
+ * the sum of all live candidates must be for it to count as cold. */
+#define MVM_SPESH_RETIRE_MISSES 128
+#define MVM_SPESH_RETIRE_RATIO  64
+
+/* Candidates are allocated individually and the slots holding them are never
+ * moved, so the dispatcher can read them without a lock. */
+#define MVM_spesh_candidate_at(body, i) ((body)->spesh_candidates[i])
+
+/* Code that refers to a candidate by slot, such as sp_fastinvoke, also
+ * carries the slot's generation, so that it doesn't run a newer candidate
+ * that took over the slot, whose guards it has not checked. References must
+ * fit in an int16 operand, which bounds how often a slot may be reused. */
+#define MVM_SPESH_MAX_GENERATION (0x7FFF >> MVM_SPESH_CANDIDATE_IDX_BITS)
+#define MVM_spesh_candidate_ref(idx, gen) \
+    ((MVMint16)((idx) | ((gen) << MVM_SPESH_CANDIDATE_IDX_BITS)))
+#define MVM_spesh_candidate_ref_idx(ref) ((ref) & (MVM_SPESH_MAX_CANDIDATES - 1))
+#define MVM_spesh_candidate_ref_gen(ref) ((ref) >> MVM_SPESH_CANDIDATE_IDX_BITS)
 
 /* A specialization guard. */
 struct MVMSpeshGuard {
@@ -116,3 +166,7 @@ MVMSpeshCandidate * MVM_spesh_candidate_setup(MVMThreadContext *tc,
 void MVM_spesh_candidate_specialize(MVMThreadContext *tc, MVMStaticFrame *static_frame,
         MVMSpeshCandidate *candidate);
 void MVM_spesh_candidate_destroy(MVMThreadContext *tc, MVMSpeshCandidate *candidate);
+void MVM_spesh_candidate_destroy_all(MVMThreadContext *tc, MVMStaticFrameBody *body);
+MVMSpeshCandidate * MVM_spesh_candidate_find(MVMThreadContext *tc, MVMStaticFrame *static_frame,
+    MVMCallsite *callsite, MVMRegister *args);
+MVMint32 MVM_spesh_candidate_has_room(MVMThreadContext *tc, MVMStaticFrame *static_frame);
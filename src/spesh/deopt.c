@@ -217,6 +217,8 @@ void MVM_spesh_deopt_one(MVMThreadContext *tc) {
     if (f->effective_bytecode != f->static_info->body.bytecode) {
         MVMint32 deopt_offset = *(tc->interp_cur_op) - f->effective_bytecode;
         MVMint32 deopt_target = find_deopt_target(tc, f, deopt_offset);
+        if (tc->instance->spesh_event_log)
+            MVM_spesh_event(tc, MVM_SPESH_EVENT_DEOPT_ONE, 0, f->static_info, deopt_offset, 0);
         deopt_frame(tc, tc->cur_frame, deopt_offset, deopt_target);
     }
     else {
@@ -234,6 +236,8 @@ void MVM_spesh_deopt_one_direct(MVMThreadContext *tc, MVMint32 deopt_offset,
         MVM_profiler_log_deopt_one(tc);
     clear_dynlex_cache(tc, f);
     if (f->effective_bytecode != f->static_info->body.bytecode) {
+        if (tc->instance->spesh_event_log)
+            MVM_spesh_event(tc, MVM_SPESH_EVENT_DEOPT_ONE, 0, f->static_info, deopt_offset, 0);
         deopt_frame(tc, tc->cur_frame, deopt_offset, deopt_target);
     } else {
         MVM_oops(tc, "deopt_one_direct failed for %s (%s)",
@@ -250,6 +254,7 @@ void MVM_spesh_deopt_all(MVMThreadContext *tc) {
     /* Walk frames looking for any callers in specialized bytecode. */
     MVMFrame *l = MVM_frame_force_to_heap(tc, tc->cur_frame);
     MVMFrame *f = tc->cur_frame->caller;
+    MVMuint64 num_deopted = 0;
     if (tc->instance->profiling)
         MVM_profiler_log_deopt_all(tc);
     while (f) {
@@ -335,8 +340,13 @@ void MVM_spesh_deopt_all(MVMThreadContext *tc) {
                     }
                 }
             }
+            if (!f->spesh_cand)
+                num_deopted++;
         }
         l = f;
         f = f->caller;
     }
+    if (tc->instance->spesh_event_log)
+        MVM_spesh_event(tc, MVM_SPESH_EVENT_DEOPT_ALL, 0, tc->cur_frame->static_info, 0,
+            num_deopted);
 }
@@ -0,0 +1,129 @@
+#include "moar.h"
+
+/* Sets up the event log to write to the given file, writing the header. */
+void MVM_spesh_event_log_open(MVMInstance *instance, FILE *fh) {
+    MVMSpeshEventLog *log = MVM_calloc(1, sizeof(MVMSpeshEventLog));
+    MVMuint32 header[2] = { MVM_SPESH_EVENT_VERSION, sizeof(MVMSpeshEvent) };
+    int init_stat;
+    if ((init_stat = uv_mutex_init(&log->lock)) < 0) {
+        fprintf(stderr, "MoarVM: Initialization of spesh event log mutex failed\n    %s\n",
+            uv_strerror(init_stat));
+        exit(1);
+    }
+    log->fh         = fh;
+    log->start_time = uv_hrtime();
+    fwrite(MVM_SPESH_EVENT_MAGIC, 1, strlen(MVM_SPESH_EVENT_MAGIC), fh);
+    fwrite(header, sizeof(MVMuint32), 2, fh);
+    instance->spesh_event_log = log;
+}
+
+/* Writes a record; must hold the lock. */
+static void write_record(MVMSpeshEventLog *log, MVMuint32 thread_id, MVMuint16 kind,
+                         MVMuint16 detail, MVMuint32 frame, MVMuint32 offset, MVMuint64 value) {
+    MVMSpeshEvent ev;
+    memset(&ev, 0, sizeof(MVMSpeshEvent));
+    ev.time      = uv_hrtime() - log->start_time;
+    ev.thread_id = thread_id;
+    ev.kind      = kind;
+    ev.detail    = detail;
+    ev.frame     = frame;
+    ev.offset    = offset;
+    ev.value     = value;
+    fwrite(&ev, sizeof(MVMSpeshEvent), 1, log->fh);
+}
+
+/* Writes a definition record followed by its text; must hold the lock. */
+static void write_definition(MVMThreadContext *tc, MVMSpeshEventLog *log, MVMuint16 kind,
+                             MVMuint32 id, const char *text) {
+    size_t len = strlen(text);
+    write_record(log, tc->thread_id, kind, 0, id, 0, len);
+    fwrite(text, 1, len, log->fh);
+}
+
+/* Gets the ID of a static frame, giving it one if it has none yet. */
+static MVMuint32 frame_id(MVMThreadContext *tc, MVMSpeshEventLog *log, MVMStaticFrame *sf) {
+    char      *name, *cuid, *text;
+    MVMuint32  id;
+
+    if (!sf)
+        return 0;
+    if (sf->body.spesh_event_id)
+        return sf->body.spesh_event_id;
+
+    /* Make the description before taking the lock, since it allocates. */
+    name = MVM_string_utf8_encode_C_string(tc, sf->body.name);
+    cuid = MVM_string_utf8_encode_C_string(tc, sf->body.cuuid);
+    text = MVM_malloc(strlen(name) + strlen(cuid) + 4);
+    sprintf(text, "%s (%s)", name, cuid);
+    MVM_free(name);
+    MVM_free(cuid);
+
+    uv_mutex_lock(&log->lock);
+    id = sf->body.spesh_event_id;
+    if (!id) {
+        id = ++log->last_frame_id;
+        write_definition(tc, log, MVM_SPESH_EVENT_DEF_FRAME, id, text);
+        sf->body.spesh_event_id = id;
+    }
+    uv_mutex_unlock(&log->lock);
+
+    MVM_free(text);
+    return id;
+}
+
+/* Gets the ID of a string that lives as long as the VM, giving it one if it
+ * has none yet; must hold the lock. */
+static MVMuint32 string_id(MVMThreadContext *tc, MVMSpeshEventLog *log, const char *str) {
+    MVMSpeshEventString *entry;
+    HASH_FIND(hash_handle, log->strings, (char *)&str, sizeof(const char *), entry);
+    if (!entry) {
+        entry      = MVM_malloc(sizeof(MVMSpeshEventString));
+        entry->str = str;
+        entry->id  = ++log->last_string_id;
+        HASH_ADD_KEYPTR(hash_handle, log->strings, (char *)&(entry->str),
+            sizeof(const char *), entry);
+        write_definition(tc, log, MVM_SPESH_EVENT_DEF_STRING, entry->id, str);
+    }
+    return entry->id;
+}
+
+/* Logs an event about a static frame. */
+void MVM_spesh_event(MVMThreadContext *tc, MVMuint16 kind, MVMuint16 detail,
+                     MVMStaticFrame *sf, MVMuint32 offset, MVMuint64 value) {
+    MVMSpeshEventLog *log = tc->instance->spesh_event_log;
+    MVMuint32         id  = frame_id(tc, log, sf);
+    uv_mutex_lock(&log->lock);
+    write_record(log, tc->thread_id, kind, detail, id, offset, value);
+    uv_mutex_unlock(&log->lock);
+}
+
+/* Logs an event about a static frame, whose value is another frame. */
+void MVM_spesh_event_frames(MVMThreadContext *tc, MVMuint16 kind, MVMuint16 detail,
+                            MVMStaticFrame *sf, MVMStaticFrame *other) {
+    MVMSpeshEventLog *log = tc->instance->spesh_event_log;
+    MVMuint32         id  = frame_id(tc, log, other);
+    MVM_spesh_event(tc, kind, detail, sf, 0, id);
+}
+
+/* Logs an event about a static frame, whose value is a string that lives as
+ * long as the VM (such as an op name). */
+void MVM_spesh_event_string(MVMThreadContext *tc, MVMuint16 kind, MVMuint16 detail,
+                            MVMStaticFrame *sf, const char *str) {
+    MVMSpeshEventLog *log = tc->instance->spesh_event_log;
+    MVMuint32         id  = frame_id(tc, log, sf);
+    uv_mutex_lock(&log->lock);
+    write_record(log, tc->thread_id, kind, detail, id, 0, string_id(tc, log, str));
+    uv_mutex_unlock(&log->lock);
+}
+
+/* Closes the event log, freeing its state. */
+void MVM_spesh_event_log_close(MVMInstance *instance) {
+    MVMSpeshEventLog *log = instance->spesh_event_log;
+    if (log) {
+        fclose(log->fh);
+        MVM_HASH_DESTROY(hash_handle, MVMSpeshEventString, log->strings);
+        uv_mutex_destroy(&log->lock);
+        MVM_free(log);
+        instance->spesh_event_log = NULL;
+    }
+}
@@ -0,0 +1,117 @@
+/* The spesh event log records the decisions made by the specializer and the
+ * JIT as fixed-size binary records, so it is cheap enough to leave turned on
+ * in production. It is enabled by setting MVM_SPESH_EVENT_LOG to a file name
+ * (which, as with the other logs, may contain %d for the process ID), and
+ * tools/spesh-events-summary.pl aggregates it.
+ *
+ * The file starts with the magic string, then the format version and record
+ * size as 32-bit integers, followed by records. All integers are in native
+ * byte order. Frames and strings are referred to by ID; the first time one
+ * is used, a definition record is written giving its ID in the frame field
+ * and the length of its text in the value field, immediately followed by
+ * the text itself. */
+
+#define MVM_SPESH_EVENT_MAGIC    "MOARSPEV"
+#define MVM_SPESH_EVENT_VERSION  1
+
+/* Definition records. */
+#define MVM_SPESH_EVENT_DEF_FRAME           1
+#define MVM_SPESH_EVENT_DEF_STRING          2
+
+/* Specialization started and finished; detail says which phase, and for the
+ * finish the value is the duration in nanoseconds. */
+#define MVM_SPESH_EVENT_SPESH_START         3
+#define MVM_SPESH_EVENT_SPESH_FINISH        4
+
+/* A finished candidate became available; detail is 1 if it was JIT
+ * compiled, and value is the bytecode size. */
+#define MVM_SPESH_EVENT_CANDIDATE_INSTALLED 5
+
+/* A frame with candidates was invoked with arguments matching none of their
+ * guards; value is the number of candidates. */
+#define MVM_SPESH_EVENT_GUARD_FAIL          6
+
+/* Deoptimization of one frame, due to a failed guard, at offset. */
+#define MVM_SPESH_EVENT_DEOPT_ONE           7
+
+/* Deoptimization of all frames on the stack, from frame; value is the number
+ * of frames that were deoptimized. */
+#define MVM_SPESH_EVENT_DEOPT_ALL           8
+
+/* On-stack replacement into the logging or the optimized code; detail says
+ * which phase. */
+#define MVM_SPESH_EVENT_OSR                 9
+
+/* Inlining into frame was done, or refused; value is the ID of the frame we
+ * tried to inline, and detail the reason for refusal. */
+#define MVM_SPESH_EVENT_INLINE_ACCEPTED     10
+#define MVM_SPESH_EVENT_INLINE_REJECTED     11
+
+/* The JIT gave up on frame; value is the string ID of the op name. */
+#define MVM_SPESH_EVENT_JIT_BAIL            12
+
+/* Phases, for the detail field of start, finish and OSR events. */
+#define MVM_SPESH_EVENT_PHASE_LOGGING       0
+#define MVM_SPESH_EVENT_PHASE_OPTIMIZE      1
+
+/* Reasons for refusing to inline. */
+#define MVM_SPESH_INLINE_DISABLED           1
+#define MVM_SPESH_INLINE_TOO_BIG            2
+#define MVM_SPESH_INLINE_RECURSIVE          3
+#define MVM_SPESH_INLINE_HLL_MISMATCH       4
+#define MVM_SPESH_INLINE_STILL_LOGGING      5
+#define MVM_SPESH_INLINE_NO_INLINE_OP       6
+#define MVM_SPESH_INLINE_OUTER_LEXICAL      7
+#define MVM_SPESH_INLINE_TOO_MANY_ARGS      8
+
+/* A record in the event log. */
+struct MVMSpeshEvent {
+    /* Nanoseconds since the log was opened. */
+    MVMuint64 time;
+
+    /* The thread the event happened on. */
+    MVMuint32 thread_id;
+
+    /* The kind of event, and a kind-specific detail. */
+    MVMuint16 kind;
+    MVMuint16 detail;
+
+    /* The frame ID (zero if none) and bytecode offset in it. */
+    MVMuint32 frame;
+    MVMuint32 offset;
+
+    /* Kind-specific value. */
+    MVMuint64 value;
+};
+
+/* An entry in the table of strings given an ID. */
+struct MVMSpeshEventString {
+    const char *str;
+    MVMuint32   id;
+    UT_hash_handle hash_handle;
+};
+
+/* State of the event log. */
+struct MVMSpeshEventLog {
+    uv_mutex_t lock;
+    FILE      *fh;
+
+    /* When the log was opened. */
+    MVMuint64 start_time;
+
+    /* Last frame and string IDs handed out. */
+    MVMuint32 last_frame_id;
+    MVMuint32 last_string_id;
+
+    /* Strings given an ID so far, keyed on their address. */
+    MVMSpeshEventString *strings;
+};
+
+void MVM_spesh_event_log_open(MVMInstance *instance, FILE *fh);
+void MVM_spesh_event(MVMThreadContext *tc, MVMuint16 kind, MVMuint16 detail,
+    MVMStaticFrame *sf, MVMuint32 offset, MVMuint64 value);
+void MVM_spesh_event_frames(MVMThreadContext *tc, MVMuint16 kind, MVMuint16 detail,
+    MVMStaticFrame *sf, MVMStaticFrame *other);
+void MVM_spesh_event_string(MVMThreadContext *tc, MVMuint16 kind, MVMuint16 detail,
+    MVMStaticFrame *sf, const char *str);
+void MVM_spesh_event_log_close(MVMInstance *instance);
@@ -43,6 +43,16 @@ static void demand_extop(MVMThreadContext *tc, MVMCompUnit *target_cu, MVMCompUn
     MVM_oops(tc, "Spesh: inline failed to find source CU extop entry");
 }
 
+/* Logs that inlining was refused, if we're logging spesh events. Always
+ * returns NULL, for the convenience of the caller. */
+static MVMSpeshGraph * rejected(MVMThreadContext *tc, MVMSpeshGraph *inliner,
+                                MVMCode *target, MVMuint16 reason) {
+    if (tc->instance->spesh_event_log)
+        MVM_spesh_event_frames(tc, MVM_SPESH_EVENT_INLINE_REJECTED, reason,
+            inliner->sf, target->body.sf);
+    return NULL;
+}
+
 /* Sees if it will be possible to inline the target code ref, given we could
  * already identify a spesh candidate. Returns NULL if no inlining is possible
  * or a graph ready to be merged if it will be possible. */
@@ -50,26 +60,27 @@ MVMSpeshGraph * MVM_spesh_inline_try_get_graph(MVMThreadContext *tc, MVMSpeshGra
                                                MVMCode *target, MVMSpeshCandidate *cand) {
     MVMSpeshGraph *ig;
     MVMSpeshBB    *bb;
+    MVMuint16      reason;
 
     /* Check inlining is enabled. */
     if (!tc->instance->spesh_inline_enabled)
-        return NULL;
+        return rejected(tc, inliner, target, MVM_SPESH_INLINE_DISABLED);
 
     /* Check bytecode size is within the inline limit. */
     if (cand->bytecode_size > MVM_SPESH_MAX_INLINE_SIZE)
-        return NULL;
+        return rejected(tc, inliner, target, MVM_SPESH_INLINE_TOO_BIG);
 
     /* Ensure that this isn't a recursive inlining. */
     if (target->body.sf == inliner->sf)
-        return NULL;
+        return rejected(tc, inliner, target, MVM_SPESH_INLINE_RECURSIVE);
 
     /* Ensure they're from the same HLL. */
     if (target->body.sf->body.cu->body.hll_config != inliner->sf->body.cu->body.hll_config)
-        return NULL;
+        return rejected(tc, inliner, target, MVM_SPESH_INLINE_HLL_MISMATCH);
 
     /* Ensure the candidate isn't still logging. */
     if (cand->sg)
-        return NULL;
+        return rejected(tc, inliner, target, MVM_SPESH_INLINE_STILL_LOGGING);
 
     /* Build graph from the already-specialized bytecode. */
     ig = MVM_spesh_graph_create_from_cand(tc, target->body.sf, cand, 0);
@@ -94,17 +105,23 @@ MVMSpeshGraph * MVM_spesh_inline_try_get_graph(MVMThreadContext *tc, MVMSpeshGra
 
             /* Instruction may be marked directly as not being inlinable, in
              * which case we're done. */
-            if (!is_phi && ins->info->no_inline)
+            if (!is_phi && ins->info->no_inline) {
+                reason = MVM_SPESH_INLINE_NO_INLINE_OP;
                 goto not_inlinable;
+            }
 
             /* If we have lexical access, make sure it's within the frame. */
             if (ins->info->opcode == MVM_OP_getlex) {
-                if (ins->operands[1].lex.outers > 0)
+                if (ins->operands[1].lex.outers > 0) {
+                    reason = MVM_SPESH_INLINE_OUTER_LEXICAL;
                     goto not_inlinable;
+                }
             }
             else if (ins->info->opcode == MVM_OP_bindlex) {
-                if (ins->operands[0].lex.outers > 0)
+                if (ins->operands[0].lex.outers > 0) {
+                    reason = MVM_SPESH_INLINE_OUTER_LEXICAL;
                     goto not_inlinable;
+                }
             }
 
             /* Check we don't have too many args for inlining to work out. */
@@ -112,8 +129,10 @@ MVMSpeshGraph * MVM_spesh_inline_try_get_graph(MVMThreadContext *tc, MVMSpeshGra
                     ins->info->opcode == MVM_OP_sp_getarg_i ||
                     ins->info->opcode == MVM_OP_sp_getarg_n ||
                     ins->info->opcode == MVM_OP_sp_getarg_s) {
-                if (ins->operands[1].lit_i16 >= MAX_ARGS_FOR_OPT)
+                if (ins->operands[1].lit_i16 >= MAX_ARGS_FOR_OPT) {
+                    reason = MVM_SPESH_INLINE_TOO_MANY_ARGS;
                     goto not_inlinable;
+                }
             }
 
             /* Ext-ops need special care in inter-comp-unit inlines. */
@@ -130,12 +149,15 @@ MVMSpeshGraph * MVM_spesh_inline_try_get_graph(MVMThreadContext *tc, MVMSpeshGra
     }
 
     /* If we found nothing we can't inline, inlining is fine. */
+    if (tc->instance->spesh_event_log)
+        MVM_spesh_event_frames(tc, MVM_SPESH_EVENT_INLINE_ACCEPTED, 0,
+            inliner->sf, target->body.sf);
     return ig;
 
     /* If we can't find a way to inline, we end up here. */
   not_inlinable:
     MVM_spesh_graph_destroy(tc, ig);
-    return NULL;
+    return rejected(tc, inliner, target, reason);
 }
 
 /* Finds the deopt index of the return. */
@@ -743,6 +743,38 @@ static void optimize_repr_op(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB
         }
 }
 
+/* Boxing an integer whose value and box type are both known, and which the
+ * boxed integer cache holds, can just load the cached box. Returns non-zero
+ * if the instruction was rewritten. */
+static MVMint32 optimize_box_int_const(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshIns *ins) {
+    MVMSpeshFacts *value_facts = MVM_spesh_get_facts(tc, g, ins->operands[1]);
+    MVMSpeshFacts *type_facts  = MVM_spesh_get_facts(tc, g, ins->operands[2]);
+    if (value_facts->flags & MVM_SPESH_FACT_KNOWN_VALUE
+            && type_facts->flags & MVM_SPESH_FACT_KNOWN_TYPE && type_facts->type) {
+        MVMObject *box = MVM_intcache_get(tc, type_facts->type, value_facts->value.i);
+        if (box) {
+            MVMSpeshFacts *tgt_facts = MVM_spesh_get_facts(tc, g, ins->operands[0]);
+
+            MVM_spesh_use_facts(tc, g, value_facts);
+            MVM_spesh_use_facts(tc, g, type_facts);
+            value_facts->usages--;
+            type_facts->usages--;
+
+            ins->info = MVM_op_get_op(MVM_OP_sp_getspeshslot);
+            ins->operands[1].lit_i16 = MVM_spesh_add_spesh_slot_try_reuse(tc, g,
+                (MVMCollectable *)box);
+
+            /* The writer is no longer a box, so the source register must
+             * not be looked for any more. */
+            tgt_facts->flags &= ~MVM_SPESH_FACT_KNOWN_BOX_SRC;
+            tgt_facts->flags |= MVM_SPESH_FACT_KNOWN_VALUE;
+            tgt_facts->value.o = box;
+            return 1;
+        }
+    }
+    return 0;
+}
+
 /* smrt_strify and smrt_numify can turn into unboxes, but at least
  * for smrt_numify it's "complicated". Also, later when we know how
  * to put new invocations into spesh'd code, we could make direct
@@ -988,14 +1020,16 @@ static void optimize_getlex_known(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpe
 }
 
 /* Determines if there's a matching spesh candidate for a callee and a given
- * set of argument info. */
-static MVMint32 try_find_spesh_candidate(MVMThreadContext *tc, MVMCode *code, MVMSpeshCallInfo *arg_info) {
+ * set of argument info. If so, returns it, along with the reference to its
+ * slot that a fast invoke should carry. */
+static MVMSpeshCandidate * try_find_spesh_candidate(MVMThreadContext *tc, MVMCode *code,
+        MVMSpeshCallInfo *arg_info, MVMint16 *ref) {
     MVMStaticFrameBody *sfb = &(code->body.sf->body);
     MVMint32 num_spesh      = sfb->num_spesh_candidates;
     MVMint32 i, j;
     for (i = 0; i < num_spesh; i++) {
-        MVMSpeshCandidate *cand = &sfb->spesh_candidates[i];
-        if (cand->cs == arg_info->cs) {
+        MVMSpeshCandidate *cand = MVM_spesh_candidate_at(sfb, i);
+        if (cand->cs == arg_info->cs && !cand->retired) {
             /* Matching callsite, now see if we have enough information to
              * test the guards. */
             MVMint32 guard_failed = 0;
@@ -1053,11 +1087,13 @@ static MVMint32 try_find_spesh_candidate(MVMThreadContext *tc, MVMCode *code, MV
                 if (guard_failed)
                     break;
             }
-            if (!guard_failed)
-                return i;
+            if (!guard_failed) {
+                *ref = MVM_spesh_candidate_ref(i, cand->generation);
+                return cand;
+            }
         }
     }
-    return -1;
+    return NULL;
 }
 
 /* Drives optimization of a call. */
@@ -1166,11 +1202,12 @@ static void optimize_call(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb
         /* See if we can point the call at a particular specialization. */
         if (target && ((MVMCode *)target)->body.sf->body.instrumentation_level == tc->instance->instrumentation_level) {
             MVMCode *target_code  = (MVMCode *)target;
-            MVMint32 spesh_cand = try_find_spesh_candidate(tc, target_code, arg_info);
-            if (spesh_cand >= 0) {
+            MVMint16 spesh_cand;
+            MVMSpeshCandidate *cand = try_find_spesh_candidate(tc, target_code, arg_info, &spesh_cand);
+            if (cand) {
                 /* Yes. Will we be able to inline? */
                 MVMSpeshGraph *inline_graph = MVM_spesh_inline_try_get_graph(tc, g,
-                    target_code, &target_code->body.sf->body.spesh_candidates[spesh_cand]);
+                    target_code, cand);
                 if (inline_graph) {
                     /* Yes, have inline graph, so go ahead and do it. */
 #if MVM_LOG_INLINES
@@ -1623,6 +1660,9 @@ static void optimize_bb(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb)
             optimize_repr_op(tc, g, bb, ins, 1);
             break;
         case MVM_OP_box_i:
+            if (!optimize_box_int_const(tc, g, ins))
+                optimize_repr_op(tc, g, bb, ins, 2);
+            break;
         case MVM_OP_box_n:
         case MVM_OP_box_s:
             optimize_repr_op(tc, g, bb, ins, 2);
@@ -1701,8 +1741,13 @@ static void eliminate_dead_ins(MVMThreadContext *tc, MVMSpeshGraph *g) {
                         death = 1;
                     }
                 }
-                else if (ins->info->pure) {
-                    /* Sanity check to make sure it's a write reg as first operand. */
+                else if (ins->info->pure || ins->info->opcode == MVM_OP_takeclosure) {
+                    /* Sanity check to make sure it's a write reg as first operand.
+                     * A takeclosure is not pure, but its only side-effect is to
+                     * force the current frame on to the heap so the closure can
+                     * reference it as its outer. If nothing uses the closure -
+                     * for example, because the calls using it were optimized
+                     * away - then the frame can stay on the call stack. */
                     if ((ins->info->operands[0] & MVM_operand_rw_mask) == MVM_operand_write_reg) {
                         MVMSpeshFacts *facts = get_facts_direct(tc, g, ins->operands[0]);
                         if (facts->usages == 0) {
@@ -1873,9 +1918,984 @@ static void eliminate_unused_log_guards(MVMThreadContext *tc, MVMSpeshGraph *g)
                 g->log_guards[i].ins);
 }
 
+/* Checks if an instruction reads the given SSA register version. */
+static MVMint32 ins_reads_reg(MVMSpeshIns *ins, MVMSpeshOperand reg) {
+    MVMint32 i;
+    for (i = 0; i < ins->info->num_operands; i++)
+        if ((ins->info->operands[i] & MVM_operand_rw_mask) == MVM_operand_read_reg
+                && ins->operands[i].reg.orig == reg.reg.orig
+                && ins->operands[i].reg.i == reg.reg.i)
+            return 1;
+    return 0;
+}
+
+/* Checks if an instruction writes any version of the given register. Code
+ * generation maps all versions back onto the same register, so a value can
+ * not be forwarded past such a write. */
+static MVMint32 ins_writes_orig(MVMSpeshIns *ins, MVMuint16 orig) {
+    MVMint32 i;
+    for (i = 0; i < ins->info->num_operands; i++)
+        if ((ins->info->operands[i] & MVM_operand_rw_mask) == MVM_operand_write_reg
+                && ins->operands[i].reg.orig == orig)
+            return 1;
+    return 0;
+}
+
+/* Updates the deopt index in effect as we walk forward over an instruction,
+ * as facts discovery does. */
+static MVMint32 deopt_idx_after(MVMSpeshIns *ins, MVMint32 cur_deopt_idx) {
+    MVMSpeshAnn *ann;
+    for (ann = ins->annotations; ann; ann = ann->next)
+        if (ann->type == MVM_SPESH_ANN_DEOPT_ONE_INS || ann->type == MVM_SPESH_ANN_DEOPT_ALL_INS)
+            return ann->data.deopt_idx;
+    return cur_deopt_idx;
+}
+
+/* Turns an instruction reading from a non-escaping object into a set from
+ * the register holding the value it would have read. The new read of the
+ * value counts double if a deopt point lies between it and the write of the
+ * value, as in facts discovery, so that it is kept for deoptimization. */
+static void replace_with_set(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshIns *ins,
+                             MVMSpeshOperand obj, MVMSpeshOperand value, MVMint32 cur_deopt_idx) {
+    MVMSpeshOperand *operands    = MVM_spesh_alloc(tc, g, 2 * sizeof(MVMSpeshOperand));
+    MVMSpeshFacts   *value_facts = get_facts_direct(tc, g, value);
+    operands[0]   = ins->operands[0];
+    operands[1]   = value;
+    ins->info     = MVM_op_get_op(MVM_OP_set);
+    ins->operands = operands;
+    get_facts_direct(tc, g, obj)->usages--;
+    value_facts->usages += value_facts->deopt_idx == cur_deopt_idx ? 1 : 2;
+}
+
+/* A box that is unboxed again before it is used in any other way is never
+ * seen by anything else, so the unbox can just take the value that was
+ * boxed. Once all unboxes are replaced, dead code elimination will get rid
+ * of the box; if it is still needed for deoptimization, it will be kept. */
+static void scalar_replace_box(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshIns *box_ins) {
+    MVMSpeshFacts        *type_facts = get_facts_direct(tc, g, box_ins->operands[2]);
+    MVMSpeshOperand       obj        = box_ins->operands[0];
+    MVMSpeshOperand       value      = box_ins->operands[1];
+    const MVMStorageSpec *ss;
+    MVMSpeshIns          *ins;
+    MVMuint16             unbox_op, primitive;
+    MVMint32              cur_deopt_idx;
+
+    if (!(type_facts->flags & MVM_SPESH_FACT_KNOWN_TYPE) || !type_facts->type)
+        return;
+    switch (box_ins->info->opcode) {
+        case MVM_OP_box_i:
+            unbox_op  = MVM_OP_unbox_i;
+            primitive = MVM_STORAGE_SPEC_BP_INT;
+            break;
+        case MVM_OP_box_n:
+            unbox_op  = MVM_OP_unbox_n;
+            primitive = MVM_STORAGE_SPEC_BP_NUM;
+            break;
+        case MVM_OP_box_s:
+            unbox_op  = MVM_OP_unbox_s;
+            primitive = MVM_STORAGE_SPEC_BP_STR;
+            break;
+        default:
+            return;
+    }
+
+    /* The round trip is only an identity if the type boxes exactly that
+     * primitive, at full width; sized or unsigned storage truncates or
+     * converts the value on the way in. */
+    ss = REPR(type_facts->type)->get_storage_spec(tc, STABLE(type_facts->type));
+    if (ss->boxed_primitive != primitive)
+        return;
+    if (primitive == MVM_STORAGE_SPEC_BP_INT && (ss->bits != 64 || ss->is_unsigned))
+        return;
+    if (primitive == MVM_STORAGE_SPEC_BP_NUM && ss->bits != 64)
+        return;
+
+    cur_deopt_idx = get_facts_direct(tc, g, obj)->deopt_idx;
+    for (ins = box_ins->next; ins; ins = ins->next) {
+        cur_deopt_idx = deopt_idx_after(ins, cur_deopt_idx);
+        if (ins_reads_reg(ins, obj)) {
+            if (ins->info->opcode != unbox_op)
+                break; /* Escapes, or is used in some other way. */
+            MVM_spesh_use_facts(tc, g, type_facts);
+            replace_with_set(tc, g, ins, obj, value, cur_deopt_idx);
+        }
+        if (ins_writes_orig(ins, value.reg.orig))
+            break;
+    }
+}
+
+/* Maps an attribute bind instruction to the matching read instruction. Only
+ * full width native binds are paired; the sized ones truncate the value. */
+static MVMuint16 matching_attr_get(MVMuint16 bind_op) {
+    switch (bind_op) {
+        case MVM_OP_sp_p6obind_o: return MVM_OP_sp_p6oget_o;
+        case MVM_OP_sp_p6obind_i: return MVM_OP_sp_p6oget_i;
+        case MVM_OP_sp_p6obind_n: return MVM_OP_sp_p6oget_n;
+        case MVM_OP_sp_p6obind_s: return MVM_OP_sp_p6oget_s;
+        case MVM_OP_sp_bind_o:    return MVM_OP_sp_get_o;
+        case MVM_OP_sp_bind_i64:  return MVM_OP_sp_get_i64;
+        case MVM_OP_sp_bind_n:    return MVM_OP_sp_get_n;
+        case MVM_OP_sp_bind_s:    return MVM_OP_sp_get_s;
+        default:                  return 0;
+    }
+}
+
+/* Values stored into a fresh object that is yet to escape, by offset. */
+#define MVM_SPESH_MAX_SCALAR_ATTRS 16
+typedef struct {
+    MVMSpeshOperand value;
+    MVMuint16       offset;
+    MVMuint16       get_op;
+} ScalarAttr;
+
+/* For an object from sp_fastcreate, forwards values bound into attributes
+ * to reads of those attributes, up until the object escapes. If all that
+ * remains is binds within this basic block and there is no deopt point in
+ * between needing the object, the binds are removed too, which lets dead
+ * code elimination throw away the allocation itself. */
+static void scalar_replace_fastcreate(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshBB *bb,
+                                      MVMSpeshIns *create_ins) {
+    ScalarAttr       attrs[MVM_SPESH_MAX_SCALAR_ATTRS];
+    MVMint32         num_attrs = 0;
+    MVMint32         escaped   = 0;
+    MVMint32         num_binds = 0;
+    MVMint32         i;
+    MVMSpeshOperand  obj       = create_ins->operands[0];
+    MVMSpeshIns     *ins;
+    MVMint32         cur_deopt_idx;
+
+    cur_deopt_idx = get_facts_direct(tc, g, obj)->deopt_idx;
+    for (ins = create_ins->next; ins && !escaped; ins = ins->next) {
+        cur_deopt_idx = deopt_idx_after(ins, cur_deopt_idx);
+        if (ins_reads_reg(ins, obj)) {
+            MVMuint16 get_op = matching_attr_get(ins->info->opcode);
+            if (get_op && ins->operands[0].reg.orig == obj.reg.orig
+                    && ins->operands[0].reg.i == obj.reg.i
+                    && !(ins->operands[2].reg.orig == obj.reg.orig
+                         && ins->operands[2].reg.i == obj.reg.i)) {
+                /* A bind; remember (or replace) the value for the offset. */
+                MVMuint16 offset = ins->operands[1].lit_i16;
+                for (i = 0; i < num_attrs; i++)
+                    if (attrs[i].offset == offset)
+                        break;
+                if (i == num_attrs) {
+                    if (num_attrs == MVM_SPESH_MAX_SCALAR_ATTRS) {
+                        escaped = 1;
+                        break;
+                    }
+                    num_attrs++;
+                }
+                attrs[i].offset = offset;
+                attrs[i].get_op = get_op;
+                attrs[i].value  = ins->operands[2];
+
+                /* An object register may only be forwarded if something
+                 * wrote it, so we never hand out a NULL in place of the
+                 * VMNull a read of an unset attribute gives. */
+                if (get_op == MVM_OP_sp_p6oget_o || get_op == MVM_OP_sp_get_o)
+                    if (!get_facts_direct(tc, g, ins->operands[2])->writer)
+                        attrs[i].get_op = 0;
+                num_binds++;
+            }
+            else {
+                /* Maybe a read of a known attribute; if not, it escapes. */
+                MVMint32 replaced = 0;
+                for (i = 0; i < num_attrs; i++) {
+                    if (attrs[i].get_op && attrs[i].get_op == ins->info->opcode
+                            && attrs[i].offset == ins->operands[2].lit_i16) {
+                        replace_with_set(tc, g, ins, obj, attrs[i].value, cur_deopt_idx);
+                        replaced = 1;
+                        break;
+                    }
+                }
+                if (!replaced)
+                    escaped = 1;
+            }
+        }
+
+        /* Values whose registers get overwritten can't be forwarded. */
+        for (i = 0; i < num_attrs; i++)
+            if (ins_writes_orig(ins, attrs[i].value.reg.orig))
+                attrs[i].get_op = 0;
+    }
+
+    /* If the binds account for every use, and each was counted only once
+     * (so no deopt point lies between the allocation and any of them), then
+     * nothing will ever look at the object. */
+    if (!escaped && num_binds > 0 && get_facts_direct(tc, g, obj)->usages == num_binds) {
+        ins = create_ins->next;
+        while (ins) {
+            MVMSpeshIns *next = ins->next;
+            if (matching_attr_get(ins->info->opcode) && ins_reads_reg(ins, obj)) {
+                get_facts_direct(tc, g, obj)->usages--;
+                get_facts_direct(tc, g, ins->operands[2])->usages--;
+                MVM_spesh_manipulate_delete_ins(tc, g, bb, ins);
+            }
+            ins = next;
+        }
+    }
+}
+
+/* Looks for allocations that do not escape before the values put into them
+ * are read back out again, and replaces those reads with the values. */
+static void scalar_replace(MVMThreadContext *tc, MVMSpeshGraph *g) {
+    MVMSpeshBB *bb = g->entry;
+    while (bb && !bb->inlined) {
+        MVMSpeshIns *ins = bb->first_ins;
+        while (ins) {
+            switch (ins->info->opcode) {
+                case MVM_OP_box_i:
+                case MVM_OP_box_n:
+                case MVM_OP_box_s:
+                    scalar_replace_box(tc, g, ins);
+                    break;
+                case MVM_OP_sp_fastcreate:
+                    scalar_replace_fastcreate(tc, g, bb, ins);
+                    break;
+            }
+            ins = ins->next;
+        }
+        bb = bb->linear_next;
+    }
+}
+
+/* Instructions that compute their result purely from their operands and can
+ * never throw, and so may be executed ahead of a loop even if the loop body
+ * would not have run. */
+static MVMint32 is_loop_hoistable(MVMuint16 opcode) {
+    switch (opcode) {
+        case MVM_OP_sp_getspeshslot:
+        case MVM_OP_hllboxtype_i:
+        case MVM_OP_hllboxtype_n:
+        case MVM_OP_hllboxtype_s:
+        case MVM_OP_add_i:
+        case MVM_OP_sub_i:
+        case MVM_OP_mul_i:
+        case MVM_OP_neg_i:
+        case MVM_OP_abs_i:
+        case MVM_OP_band_i:
+        case MVM_OP_bor_i:
+        case MVM_OP_bxor_i:
+        case MVM_OP_bnot_i:
+        case MVM_OP_blshift_i:
+        case MVM_OP_brshift_i:
+        case MVM_OP_not_i:
+        case MVM_OP_add_n:
+        case MVM_OP_sub_n:
+        case MVM_OP_mul_n:
+        case MVM_OP_div_n:
+        case MVM_OP_neg_n:
+        case MVM_OP_abs_n:
+        case MVM_OP_eq_i:
+        case MVM_OP_ne_i:
+        case MVM_OP_lt_i:
+        case MVM_OP_le_i:
+        case MVM_OP_gt_i:
+        case MVM_OP_ge_i:
+        case MVM_OP_cmp_i:
+        case MVM_OP_eq_n:
+        case MVM_OP_ne_n:
+        case MVM_OP_lt_n:
+        case MVM_OP_le_n:
+        case MVM_OP_gt_n:
+        case MVM_OP_ge_n:
+        case MVM_OP_cmp_n:
+        case MVM_OP_coerce_in:
+        case MVM_OP_isconcrete:
+        case MVM_OP_isnull:
+        case MVM_OP_eqaddr:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/* Constants, which are moved ahead of a loop by move_const_ins. */
+static MVMint32 is_loop_const(MVMuint16 opcode) {
+    switch (opcode) {
+        case MVM_OP_const_i64:
+        case MVM_OP_const_i64_16:
+        case MVM_OP_const_i64_32:
+        case MVM_OP_const_n64:
+        case MVM_OP_const_s:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/* Guards whose checked value is invariant in a loop may be done once ahead
+ * of it, deoptimizing to the start of the loop if they fail. */
+static MVMint32 is_loop_guard(MVMuint16 opcode) {
+    switch (opcode) {
+        case MVM_OP_sp_guardconc:
+        case MVM_OP_sp_guardtype:
+        case MVM_OP_sp_guardcontconc:
+        case MVM_OP_sp_guardconttype:
+        case MVM_OP_sp_guardrwconc:
+        case MVM_OP_sp_guardrwtype:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/* Reads of lexicals and containers, which only give the same value on each
+ * iteration if nothing in the loop can write to them; see loop_is_read_only.
+ * A decont must be of a type that never runs code to fetch its value. */
+static MVMint32 is_loop_read(MVMThreadContext *tc, MVMSpeshGraph *g, MVMSpeshIns *ins) {
+    switch (ins->info->opcode) {
+        case MVM_OP_getlex:
+            return 1;
+        case MVM_OP_decont: {
+            MVMSpeshFacts *facts = get_facts_direct(tc, g, ins->operands[1]);
+            return (facts->flags & MVM_SPESH_FACT_KNOWN_TYPE) && facts->type
+                && (!STABLE(facts->type)->container_spec
+                    || STABLE(facts->type)->container_spec->fetch_never_invokes);
+        }
+        default:
+            return 0;
+    }
+}
+
+/* State for loop-invariant code motion over a graph. Registers versions are
+ * numbered flat, using per-local offsets, so they can be flagged cheaply;
+ * anything created after we started (our own temporaries) is outside the
+ * numbering. */
+typedef struct {
+    MVMSpeshBB     **idom;
+    MVMint32         num_bb_idx;
+    MVMuint8        *in_loop;
+    MVMuint32       *reg_offsets;
+    MVMuint16        num_locals;
+    MVMuint16       *fact_counts;
+    MVMuint8        *variant;
+    MVMuint8        *is_hoisted;
+    MVMSpeshOperand *hoisted_to;
+    MVMuint8        *single_version;
+    MVMint32         preheader_deopt_idx;
+    MVMint32         loop_deopt_target;
+    MVMint32         read_only;
+} LoopState;
+
+static MVMint32 loop_reg_idx(LoopState *ls, MVMSpeshOperand o) {
+    if (o.reg.orig >= ls->num_locals || o.reg.i >= ls->fact_counts[o.reg.orig])
+        return -1;
+    return ls->reg_offsets[o.reg.orig] + o.reg.i;
+}
+
+static MVMint32 dominates(LoopState *ls, MVMSpeshBB *dom, MVMSpeshBB *bb) {
+    while (bb) {
+        if (bb == dom)
+            return 1;
+        bb = ls->idom[bb->idx];
+    }
+    return 0;
+}
+
+static void record_idoms(LoopState *ls, MVMSpeshBB *bb) {
+    MVMint32 i;
+    for (i = 0; i < bb->num_children; i++) {
+        ls->idom[bb->children[i]->idx] = bb;
+        record_idoms(ls, bb->children[i]);
+    }
+}
+
+/* Finds the deopt index in effect at an instruction, or at the end of its
+ * block if it is NULL, as facts discovery has it: that of the closest deopt
+ * point before it, walking up the dominator tree. */
+static MVMint32 deopt_idx_at(LoopState *ls, MVMSpeshBB *bb, MVMSpeshIns *ins) {
+    MVMSpeshIns *cur = ins ? ins : bb->last_ins;
+    while (bb) {
+        for (; cur; cur = cur->prev) {
+            MVMSpeshAnn *ann;
+            for (ann = cur->annotations; ann; ann = ann->next)
+                if (ann->type == MVM_SPESH_ANN_DEOPT_ONE_INS || ann->type == MVM_SPESH_ANN_DEOPT_ALL_INS)
+                    return ann->data.deopt_idx;
+        }
+        bb  = ls->idom[bb->idx];
+        cur = bb ? bb->last_ins : NULL;
+    }
+    return -1;
+}
+
+/* Accounts for a read moving to the end of the preheader. Facts discovery
+ * counted it once or twice; should a deopt point now lie between it and its
+ * write, it needs counting twice, so is given one more usage. */
+static void use_in_preheader(MVMThreadContext *tc, MVMSpeshGraph *g, LoopState *ls, MVMSpeshOperand o) {
+    MVMSpeshFacts *facts = get_facts_direct(tc, g, o);
+    if (facts->deopt_idx != ls->preheader_deopt_idx)
+        facts->usages++;
+}
+
+/* Checks that no instruction in the loop can write to a lexical or to an
+ * object, nor run code that might. */
+static MVMint32 loop_is_read_only(MVMThreadContext *tc, MVMSpeshGraph *g, LoopState *ls) {
+    MVMSpeshBB *bb;
+    for (bb = g->entry; bb; bb = bb->linear_next) {
+        MVMSpeshIns *ins;
+        if (!ls->in_loop[bb->idx])
+            continue;
+        for (ins = bb->first_ins; ins; ins = ins->next) {
+            switch (ins->info->opcode) {
+                case MVM_SSA_PHI:
+                case MVM_OP_set:
+                case MVM_OP_goto:
+                case MVM_OP_if_i:
+                case MVM_OP_unless_i:
+                case MVM_OP_if_n:
+                case MVM_OP_unless_n:
+                case MVM_OP_inc_i:
+                case MVM_OP_dec_i:
+                case MVM_OP_osrpoint:
+                    break;
+                default:
+                    if (!is_loop_const(ins->info->opcode) && !is_loop_hoistable(ins->info->opcode)
+                            && !is_loop_guard(ins->info->opcode) && !is_loop_read(tc, g, ins))
+                        return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+/* Checks if any instruction in the loop touches any version of a local. */
+static MVMint32 loop_uses_orig(MVMThreadContext *tc, MVMSpeshGraph *g, LoopState *ls, MVMuint16 orig) {
+    MVMSpeshBB *bb;
+    for (bb = g->entry; bb; bb = bb->linear_next) {
+        MVMSpeshIns *ins;
+        if (!ls->in_loop[bb->idx])
+            continue;
+        for (ins = bb->first_ins; ins; ins = ins->next) {
+            MVMint32 i;
+            for (i = 0; i < ins->info->num_operands; i++) {
+                MVMuint8 rw = ins->info->operands[i] & MVM_operand_rw_mask;
+                if ((ins->info->opcode == MVM_SSA_PHI || rw == MVM_operand_read_reg
+                        || rw == MVM_operand_write_reg) && ins->operands[i].reg.orig == orig)
+                    return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+/* Gets a temporary register that nothing in the loop touches, as it must
+ * hold its value across every iteration. */
+static MVMSpeshOperand get_loop_temp(MVMThreadContext *tc, MVMSpeshGraph *g, LoopState *ls, MVMuint16 kind) {
+    MVMSpeshOperand  rejected[8];
+    MVMint32         num_rejected = 0;
+    MVMSpeshOperand  temp         = MVM_spesh_manipulate_get_temp_reg(tc, g, kind);
+    while (loop_uses_orig(tc, g, ls, temp.reg.orig) && num_rejected < 8) {
+        rejected[num_rejected++] = temp;
+        temp = MVM_spesh_manipulate_get_temp_reg(tc, g, kind);
+    }
+    while (num_rejected > 0)
+        MVM_spesh_manipulate_release_temp_reg(tc, g, rejected[--num_rejected]);
+    if (temp.reg.orig < ls->num_locals)
+        ls->single_version[temp.reg.orig] = 0;
+    return temp;
+}
+
+/* Checks that a read operand of an instruction in the loop has the same
+ * value on every iteration. Registers outside of the numbering were written
+ * by code hoisted out of an inner loop, which may still be inside of this
+ * one, so they are never taken as invariant. */
+static MVMint32 operand_invariant(LoopState *ls, MVMSpeshOperand o) {
+    MVMint32 idx = loop_reg_idx(ls, o);
+    return idx >= 0 && (!ls->variant[idx] || ls->is_hoisted[idx]);
+}
+
+/* Flags the locals that only ever appear in the graph with one version, and
+ * so hold the same value wherever they are used. */
+static void find_single_versions(MVMThreadContext *tc, MVMSpeshGraph *g, LoopState *ls) {
+    MVMint32   *seen = MVM_malloc(ls->num_locals * sizeof(MVMint32));
+    MVMSpeshBB *bb;
+    MVMint32    i;
+    for (i = 0; i < ls->num_locals; i++) {
+        seen[i] = -1;
+        ls->single_version[i] = 1;
+    }
+    for (bb = g->entry; bb; bb = bb->linear_next) {
+        MVMSpeshIns *ins;
+        for (ins = bb->first_ins; ins; ins = ins->next) {
+            for (i = 0; i < ins->info->num_operands; i++) {
+                MVMuint8 rw = ins->info->operands[i] & MVM_operand_rw_mask;
+                if (ins->info->opcode == MVM_SSA_PHI || rw == MVM_operand_read_reg
+                        || rw == MVM_operand_write_reg) {
+                    MVMSpeshOperand o = ins->operands[i];
+                    if (o.reg.orig >= ls->num_locals)
+                        continue;
+                    if (seen[o.reg.orig] < 0)
+                        seen[o.reg.orig] = o.reg.i;
+                    else if (seen[o.reg.orig] != o.reg.i)
+                        ls->single_version[o.reg.orig] = 0;
+                }
+            }
+        }
+    }
+    MVM_free(seen);
+}
+
+/* Inserts an instruction at the end of the preheader, before the jump into
+ * the loop if there is one. */
+static void insert_in_preheader(MVMThreadContext *tc, MVMSpeshBB *preheader, MVMSpeshIns *ins) {
+    MVMSpeshIns *last = preheader->last_ins;
+    MVMint32     i;
+    if (last) {
+        for (i = 0; i < last->info->num_operands; i++) {
+            if ((last->info->operands[i] & MVM_operand_type_mask) == MVM_operand_ins) {
+                last = last->prev;
+                break;
+            }
+        }
+    }
+    MVM_spesh_manipulate_insert_ins(tc, preheader, last, ins);
+}
+
+/* Counts the reads of a register version anywhere in the graph. */
+static MVMint32 count_reads(MVMSpeshGraph *g, MVMSpeshOperand reg) {
+    MVMSpeshBB *bb;
+    MVMint32    count = 0;
+    for (bb = g->entry; bb; bb = bb->linear_next) {
+        MVMSpeshIns *ins;
+        for (ins = bb->first_ins; ins; ins = ins->next) {
+            MVMint32 is_phi = ins->info->opcode == MVM_SSA_PHI;
+            MVMint32 i;
+            for (i = is_phi ? 1 : 0; i < ins->info->num_operands; i++)
+                if ((is_phi || (ins->info->operands[i] & MVM_operand_rw_mask) == MVM_operand_read_reg)
+                        && ins->operands[i].reg.orig == reg.reg.orig
+                        && ins->operands[i].reg.i == reg.reg.i)
+                    count++;
+        }
+    }
+    return count;
+}
+
+/* Constants cost no more to evaluate than the set hoist_ins would leave in
+ * their place, so are instead moved into the preheader as they are, when
+ * their register holds nothing else anywhere in the graph. The write now
+ * comes before any deopt point in the loop, so each read is counted as
+ * being across one. Returns non-zero if the constant was moved. */
+static MVMint32 move_const_ins(MVMThreadContext *tc, MVMSpeshGraph *g, LoopState *ls,
+                               MVMSpeshBB *preheader, MVMSpeshBB *bb, MVMSpeshIns *ins) {
+    MVMSpeshOperand  dst     = ins->operands[0];
+    MVMint32         dst_idx = loop_reg_idx(ls, dst);
+    MVMSpeshFacts   *facts;
+    if (dst_idx < 0 || !ls->single_version[dst.reg.orig] || ins->annotations)
+        return 0;
+
+    MVM_spesh_manipulate_delete_ins(tc, g, bb, ins);
+    insert_in_preheader(tc, preheader, ins);
+
+    facts = get_facts_direct(tc, g, dst);
+    if (facts->deopt_idx != ls->preheader_deopt_idx) {
+        facts->usages   += count_reads(g, dst);
+        facts->deopt_idx = ls->preheader_deopt_idx;
+    }
+
+    ls->is_hoisted[dst_idx] = 1;
+    ls->hoisted_to[dst_idx] = dst;
+    return 1;
+}
+
+/* Moves an invariant instruction to the end of the preheader, writing into a
+ * fresh temporary, and turns the original into a set from it. The temporary
+ * is written at the preheader's deopt point, not the one in the loop. */
+static MVMSpeshIns * hoist_ins(MVMThreadContext *tc, MVMSpeshGraph *g, LoopState *ls,
+                               MVMSpeshBB *preheader, MVMSpeshBB *bb, MVMSpeshIns *ins) {
+    MVMSpeshIns     *hoisted  = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshIns));
+    MVMSpeshOperand *operands = MVM_spesh_alloc(tc, g, ins->info->num_operands * sizeof(MVMSpeshOperand));
+    MVMSpeshOperand *set_ops  = MVM_spesh_alloc(tc, g, 2 * sizeof(MVMSpeshOperand));
+    MVMSpeshOperand  dst      = ins->operands[0];
+    MVMuint16        kind     = (ins->info->operands[0] & MVM_operand_type_mask) == MVM_operand_type_var
+        ? (g->local_types ? g->local_types : g->sf->body.local_types)[dst.reg.orig]
+        : (ins->info->operands[0] & MVM_operand_type_mask) >> 3;
+    MVMSpeshOperand  temp     = get_loop_temp(tc, g, ls, kind);
+    MVMSpeshFacts   *tfacts;
+    MVMint32         i, dst_idx;
+
+    /* Build the hoisted instruction, reading earlier hoisted values from
+     * their temporaries, as the sets in the loop haven't run yet. */
+    memcpy(operands, ins->operands, ins->info->num_operands * sizeof(MVMSpeshOperand));
+    operands[0] = temp;
+    for (i = 1; i < ins->info->num_operands; i++) {
+        if ((ins->info->operands[i] & MVM_operand_rw_mask) == MVM_operand_read_reg) {
+            MVMint32 idx = loop_reg_idx(ls, operands[i]);
+            if (idx >= 0 && ls->is_hoisted[idx]) {
+                MVMSpeshFacts *hfacts;
+                get_facts_direct(tc, g, operands[i])->usages--;
+                operands[i] = ls->hoisted_to[idx];
+                hfacts      = get_facts_direct(tc, g, operands[i]);
+                hfacts->usages += hfacts->deopt_idx == ls->preheader_deopt_idx ? 1 : 2;
+            }
+            else {
+                use_in_preheader(tc, g, ls, operands[i]);
+            }
+        }
+    }
+    hoisted->info     = ins->info;
+    hoisted->operands = operands;
+    insert_in_preheader(tc, preheader, hoisted);
+
+    /* The temporary gets the facts of the original target. It is read by
+     * the set in the loop. */
+    tfacts            = get_facts_direct(tc, g, temp);
+    *tfacts           = *get_facts_direct(tc, g, dst);
+    tfacts->writer    = hoisted;
+    tfacts->deopt_idx = ls->preheader_deopt_idx;
+    tfacts->usages    = deopt_idx_at(ls, bb, ins) == ls->preheader_deopt_idx ? 1 : 2;
+
+    /* The original becomes a copy of the hoisted value. */
+    set_ops[0]    = dst;
+    set_ops[1]    = temp;
+    ins->info     = MVM_op_get_op(MVM_OP_set);
+    ins->operands = set_ops;
+
+    dst_idx = loop_reg_idx(ls, dst);
+    if (dst_idx >= 0) {
+        ls->is_hoisted[dst_idx] = 1;
+        ls->hoisted_to[dst_idx] = temp;
+    }
+    return hoisted;
+}
+
+/* Moves a guard on an invariant value to the end of the preheader, where it
+ * checks the hoisted value. If it fails there, nothing of the loop has run
+ * yet, so it deoptimizes to the start of the loop. That is a new deopt point
+ * in the preheader, so values already written there and read in the loop
+ * are now read across it. Returns the hoisted guard, or NULL if the guard
+ * could not be hoisted. */
+static MVMSpeshIns * hoist_guard(MVMThreadContext *tc, MVMSpeshGraph *g, LoopState *ls,
+                                 MVMSpeshBB *preheader, MVMSpeshBB *bb, MVMSpeshIns *ins) {
+    MVMSpeshIns     *hoisted;
+    MVMSpeshOperand *operands;
+    MVMSpeshFacts   *vfacts;
+    MVMint32         idx = loop_reg_idx(ls, ins->operands[0]);
+    MVMint32         i;
+
+    /* Only hoist guards that are in use; the others are deleted anyway. */
+    for (i = 0; i < g->num_log_guards; i++)
+        if (g->log_guards[i].ins == ins)
+            break;
+    if (i == g->num_log_guards || !g->log_guards[i].used)
+        return NULL;
+
+    hoisted  = MVM_spesh_alloc(tc, g, sizeof(MVMSpeshIns));
+    operands = MVM_spesh_alloc(tc, g, ins->info->num_operands * sizeof(MVMSpeshOperand));
+    memcpy(operands, ins->operands, ins->info->num_operands * sizeof(MVMSpeshOperand));
+    if (idx >= 0 && ls->is_hoisted[idx])
+        operands[0] = ls->hoisted_to[idx];
+    hoisted->info     = ins->info;
+    hoisted->operands = operands;
+    insert_in_preheader(tc, preheader, hoisted);
+    MVM_spesh_graph_add_deopt_annotation(tc, g, hoisted, ls->loop_deopt_target,
+        MVM_SPESH_ANN_DEOPT_ONE_INS);
+    g->log_guards[i].ins = hoisted;
+    g->log_guards[i].bb  = preheader;
+
+    /* Account for the reads, and for the new deopt point. */
+    get_facts_direct(tc, g, ins->operands[0])->usages--;
+    MVM_spesh_manipulate_delete_ins(tc, g, bb, ins);
+    vfacts = get_facts_direct(tc, g, operands[0]);
+    vfacts->usages += 2;
+    for (i = 0; i < ls->reg_offsets[ls->num_locals]; i++)
+        if (ls->is_hoisted[i])
+            get_facts_direct(tc, g, ls->hoisted_to[i])->usages++;
+    ls->preheader_deopt_idx = hoisted->annotations->data.deopt_idx;
+    return hoisted;
+}
+
+/* Finds the OSR entry annotations in a loop. OSR enters at the loop header,
+ * so if we hoist anything the entry has to move to the hoisted code; that
+ * is only possible when the annotation is at the very start of the header.
+ * Returns non-zero if the loop is fine to hoist out of. */
+static MVMint32 find_loop_osr(MVMThreadContext *tc, MVMSpeshGraph *g, LoopState *ls,
+                              MVMSpeshBB *header, MVMSpeshIns **osr_ins) {
+    MVMSpeshBB *bb;
+    *osr_ins = NULL;
+    for (bb = g->entry; bb; bb = bb->linear_next) {
+        MVMSpeshIns *ins;
+        MVMint32     at_start = bb == header;
+        if (!ls->in_loop[bb->idx])
+            continue;
+        for (ins = bb->first_ins; ins; ins = ins->next) {
+            MVMSpeshAnn *ann;
+            for (ann = ins->annotations; ann; ann = ann->next) {
+                if (ann->type == MVM_SPESH_ANN_DEOPT_OSR) {
+                    if (!at_start)
+                        return 0;
+                    *osr_ins = ins;
+                }
+            }
+            if (ins->info->opcode != MVM_SSA_PHI)
+                at_start = 0;
+        }
+    }
+    return 1;
+}
+
+/* Moves OSR annotations from the loop header to the first hoisted
+ * instruction, which falls through into the header. */
+static void move_loop_osr(MVMSpeshIns *from, MVMSpeshIns *to) {
+    MVMSpeshAnn *ann  = from->annotations;
+    MVMSpeshAnn *prev = NULL;
+    while (ann) {
+        MVMSpeshAnn *next = ann->next;
+        if (ann->type == MVM_SPESH_ANN_DEOPT_OSR) {
+            if (prev)
+                prev->next = next;
+            else
+                from->annotations = next;
+            ann->next = to->annotations;
+            to->annotations = ann;
+        }
+        else {
+            prev = ann;
+        }
+        ann = next;
+    }
+}
+
+/* Checks if a block is run on every iteration of the loop, which is so if
+ * it dominates every block jumping back to the header. */
+static MVMint32 runs_every_iteration(LoopState *ls, MVMSpeshBB *header, MVMSpeshBB *bb) {
+    MVMint32 i;
+    for (i = 0; i < header->num_pred; i++)
+        if (ls->in_loop[header->pred[i]->idx] && !dominates(ls, bb, header->pred[i]))
+            return 0;
+    return 1;
+}
+
+/* Checks if the read operands of an instruction in the loop are invariant,
+ * starting from the given operand. */
+static MVMint32 operands_invariant(LoopState *ls, MVMSpeshIns *ins, MVMint32 first) {
+    MVMint32 i;
+    for (i = first; i < ins->info->num_operands; i++)
+        if ((ins->info->operands[i] & MVM_operand_rw_mask) == MVM_operand_read_reg
+                && !operand_invariant(ls, ins->operands[i]))
+            return 0;
+    return 1;
+}
+
+/* Hoists invariant instructions out of the loop with the given header,
+ * whose body blocks are flagged in ls->in_loop. Pure instructions may always
+ * be hoisted. Reads of lexicals and containers may be hoisted when nothing
+ * in the loop can write to them, as may guards on invariant values, when
+ * the loop can also be deoptimized to from before it, which needs its OSR
+ * point. Such guards must be run on every iteration, so that they would
+ * have failed on the first one anyway. */
+static void hoist_loop_invariants(MVMThreadContext *tc, MVMSpeshGraph *g, LoopState *ls,
+                                  MVMSpeshBB *header) {
+    MVMSpeshBB  *preheader = NULL;
+    MVMSpeshIns *osr_ins, *first_hoisted = NULL;
+    MVMSpeshBB  *bb;
+    MVMint32     i, changed;
+
+    /* Need a single block entering the loop, and going nowhere else. */
+    for (i = 0; i < header->num_pred; i++) {
+        if (!ls->in_loop[header->pred[i]->idx]) {
+            if (preheader)
+                return;
+            preheader = header->pred[i];
+        }
+    }
+    if (!preheader || preheader->num_succ != 1)
+        return;
+    if (!find_loop_osr(tc, g, ls, header, &osr_ins))
+        return;
+    ls->preheader_deopt_idx = deopt_idx_at(ls, preheader, NULL);
+    ls->loop_deopt_target   = -1;
+    if (osr_ins && !header->inlined && !preheader->inlined) {
+        MVMSpeshAnn *ann;
+        for (ann = osr_ins->annotations; ann; ann = ann->next)
+            if (ann->type == MVM_SPESH_ANN_DEOPT_OSR)
+                ls->loop_deopt_target = g->deopt_addrs[2 * ann->data.deopt_idx];
+    }
+    ls->read_only = loop_is_read_only(tc, g, ls);
+
+    /* Flag everything written inside of the loop as variant. */
+    memset(ls->variant, 0, ls->reg_offsets[ls->num_locals]);
+    memset(ls->is_hoisted, 0, ls->reg_offsets[ls->num_locals]);
+    for (bb = g->entry; bb; bb = bb->linear_next) {
+        MVMSpeshIns *ins;
+        if (!ls->in_loop[bb->idx])
+            continue;
+        for (ins = bb->first_ins; ins; ins = ins->next) {
+            for (i = 0; i < ins->info->num_operands; i++) {
+                if ((ins->info->opcode == MVM_SSA_PHI && i == 0)
+                        || (ins->info->opcode != MVM_SSA_PHI &&
+                            (ins->info->operands[i] & MVM_operand_rw_mask) == MVM_operand_write_reg)) {
+                    MVMint32 idx = loop_reg_idx(ls, ins->operands[i]);
+                    if (idx >= 0)
+                        ls->variant[idx] = 1;
+                }
+            }
+        }
+    }
+
+    /* Hoist until nothing more becomes invariant. */
+    do {
+        changed = 0;
+        for (bb = g->entry; bb; bb = bb->linear_next) {
+            MVMSpeshIns *ins, *next;
+            if (!ls->in_loop[bb->idx])
+                continue;
+            for (ins = bb->first_ins; ins; ins = next) {
+                MVMSpeshIns *hoisted = NULL;
+                next = ins->next;
+                if (is_loop_const(ins->info->opcode)) {
+                    if (move_const_ins(tc, g, ls, preheader, bb, ins))
+                        hoisted = ins;
+                }
+                else if (is_loop_guard(ins->info->opcode)) {
+                    if (ls->read_only && ls->loop_deopt_target >= 0 && operands_invariant(ls, ins, 0)
+                            && runs_every_iteration(ls, header, bb))
+                        hoisted = hoist_guard(tc, g, ls, preheader, bb, ins);
+                }
+                else if (is_loop_hoistable(ins->info->opcode)
+                        || (ls->read_only && is_loop_read(tc, g, ins))) {
+                    if (operands_invariant(ls, ins, 1)) {
+                        if (ins->info->opcode == MVM_OP_decont)
+                            MVM_spesh_use_facts(tc, g, get_facts_direct(tc, g, ins->operands[1]));
+                        hoisted = hoist_ins(tc, g, ls, preheader, bb, ins);
+                    }
+                }
+                if (hoisted) {
+                    if (!first_hoisted)
+                        first_hoisted = hoisted;
+                    changed = 1;
+                }
+            }
+        }
+    } while (changed);
+
+    if (first_hoisted && osr_ins)
+        move_loop_osr(osr_ins, first_hoisted);
+}
+
+/* Flags the blocks of the natural loop with the given header in ls->in_loop,
+ * by walking backwards from the back edges. Returns the number of blocks. */
+static MVMint32 find_loop_body(LoopState *ls, MVMSpeshBB *header, MVMSpeshBB **worklist) {
+    MVMint32 num_work = 0;
+    MVMint32 size     = 1;
+    MVMint32 i;
+    memset(ls->in_loop, 0, ls->num_bb_idx);
+    ls->in_loop[header->idx] = 1;
+    for (i = 0; i < header->num_pred; i++) {
+        MVMSpeshBB *pred = header->pred[i];
+        if (dominates(ls, header, pred) && !ls->in_loop[pred->idx]) {
+            ls->in_loop[pred->idx] = 1;
+            worklist[num_work++] = pred;
+        }
+    }
+    while (num_work) {
+        MVMSpeshBB *cur = worklist[--num_work];
+        size++;
+        for (i = 0; i < cur->num_pred; i++) {
+            if (!ls->in_loop[cur->pred[i]->idx]) {
+                ls->in_loop[cur->pred[i]->idx] = 1;
+                worklist[num_work++] = cur->pred[i];
+            }
+        }
+    }
+    return size;
+}
+
+/* Finds natural loops, using the dominator tree to spot back edges, and
+ * moves loop-invariant computations out of them, innermost loops first. */
+static void loop_invariant_code_motion(MVMThreadContext *tc, MVMSpeshGraph *g) {
+    LoopState    ls;
+    MVMSpeshBB  *bb;
+    MVMSpeshBB **headers;
+    MVMSpeshBB **worklist;
+    MVMint32    *sizes;
+    MVMint32     num_headers = 0;
+    MVMint32     i, j;
+    MVMuint32    total_regs  = 0;
+
+    /* Set up dominator lookup. */
+    ls.num_bb_idx = 0;
+    for (bb = g->entry; bb; bb = bb->linear_next)
+        if (bb->idx >= ls.num_bb_idx)
+            ls.num_bb_idx = bb->idx + 1;
+    ls.idom = MVM_calloc(ls.num_bb_idx, sizeof(MVMSpeshBB *));
+    record_idoms(&ls, g->entry);
+
+    /* Find loop headers: targets of edges from blocks they dominate. */
+    headers = MVM_malloc(ls.num_bb_idx * sizeof(MVMSpeshBB *));
+    sizes   = MVM_malloc(ls.num_bb_idx * sizeof(MVMint32));
+    for (bb = g->entry; bb; bb = bb->linear_next) {
+        for (i = 0; i < bb->num_pred; i++) {
+            if (dominates(&ls, bb, bb->pred[i])) {
+                headers[num_headers++] = bb;
+                break;
+            }
+        }
+    }
+    if (num_headers == 0) {
+        MVM_free(ls.idom);
+        MVM_free(headers);
+        MVM_free(sizes);
+        return;
+    }
+
+    /* Set up register version numbering. */
+    ls.num_locals  = g->num_locals;
+    ls.fact_counts = MVM_malloc(ls.num_locals * sizeof(MVMuint16));
+    ls.reg_offsets = MVM_malloc((ls.num_locals + 1) * sizeof(MVMuint32));
+    for (i = 0; i < ls.num_locals; i++) {
+        ls.fact_counts[i] = g->fact_counts[i];
+        ls.reg_offsets[i] = total_regs;
+        total_regs       += g->fact_counts[i];
+    }
+    ls.reg_offsets[ls.num_locals] = total_regs;
+    ls.variant    = MVM_malloc(total_regs ? total_regs : 1);
+    ls.is_hoisted = MVM_malloc(total_regs ? total_regs : 1);
+    ls.hoisted_to = MVM_malloc((total_regs ? total_regs : 1) * sizeof(MVMSpeshOperand));
+    ls.single_version = MVM_malloc(ls.num_locals ? ls.num_locals : 1);
+    find_single_versions(tc, g, &ls);
+    ls.in_loop    = MVM_malloc(ls.num_bb_idx);
+    worklist      = MVM_malloc(ls.num_bb_idx * sizeof(MVMSpeshBB *));
+
+    /* Work out loop sizes, so inner loops get done first. */
+    for (i = 0; i < num_headers; i++) {
+        sizes[i] = find_loop_body(&ls, headers[i], worklist);
+    }
+    for (i = 1; i < num_headers; i++) {
+        MVMSpeshBB *h = headers[i];
+        MVMint32    s = sizes[i];
+        for (j = i; j > 0 && sizes[j - 1] > s; j--) {
+            headers[j] = headers[j - 1];
+            sizes[j]   = sizes[j - 1];
+        }
+        headers[j] = h;
+        sizes[j]   = s;
+    }
+
+    /* Process each loop, recomputing its body. */
+    for (i = 0; i < num_headers; i++) {
+        find_loop_body(&ls, headers[i], worklist);
+        hoist_loop_invariants(tc, g, &ls, headers[i]);
+    }
+
+    MVM_free(worklist);
+    MVM_free(ls.in_loop);
+    MVM_free(ls.single_version);
+    MVM_free(ls.hoisted_to);
+    MVM_free(ls.is_hoisted);
+    MVM_free(ls.variant);
+    MVM_free(ls.reg_offsets);
+    MVM_free(ls.fact_counts);
+    MVM_free(sizes);
+    MVM_free(headers);
+    MVM_free(ls.idom);
+}
+
 /* Drives the overall optimization work taking place on a spesh graph. */
 void MVM_spesh_optimize(MVMThreadContext *tc, MVMSpeshGraph *g) {
     optimize_bb(tc, g, g->entry);
+    scalar_replace(tc, g);
+    loop_invariant_code_motion(tc, g);
     eliminate_dead_ins(tc, g);
     eliminate_dead_bbs(tc, g);
     eliminate_unused_log_guards(tc, g);
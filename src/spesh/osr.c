@@ -45,7 +45,7 @@ void MVM_spesh_osr(MVMThreadContext *tc) {
         return;
     if (!tc->cur_frame->params.callsite->is_interned)
         return;
-    if (tc->cur_frame->static_info->body.num_spesh_candidates == MVM_SPESH_LIMIT)
+    if (!MVM_spesh_candidate_has_room(tc, tc->cur_frame->static_info))
         return;
 
     /* Produce logging spesh candidate. */
@@ -64,6 +64,9 @@ void MVM_spesh_osr(MVMThreadContext *tc) {
         /* Work out deopt index that applies, and move interpreter into the
          * logging version of the code. */
         osr_index = get_osr_deopt_index(tc, specialized);
+        if (tc->instance->spesh_event_log)
+            MVM_spesh_event(tc, MVM_SPESH_EVENT_OSR, MVM_SPESH_EVENT_PHASE_LOGGING,
+                tc->cur_frame->static_info, specialized->deopts[2 * osr_index + 1], 0);
         *(tc->interp_bytecode_start) = specialized->bytecode;
         *(tc->interp_cur_op)         = specialized->bytecode +
                                        specialized->deopts[2 * osr_index + 1] +
@@ -140,6 +143,9 @@ void MVM_spesh_osr_finalize(MVMThreadContext *tc) {
             MVM_profiler_log_osr(tc, 0);
     }
     *(tc->interp_reg_base) = tc->cur_frame->work;
+    if (tc->instance->spesh_event_log)
+        MVM_spesh_event(tc, MVM_SPESH_EVENT_OSR, MVM_SPESH_EVENT_PHASE_OPTIMIZE,
+            tc->cur_frame->static_info, specialized->deopts[2 * osr_index + 1], 0);
 
     /* Tweak frame invocation count so future invocations will use the code
      * produced by OSR. */
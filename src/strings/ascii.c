@@ -6,17 +6,21 @@ MVMString * MVM_string_ascii_decode(MVMThreadContext *tc, const MVMObject *resul
     MVMString *result = (MVMString *)REPR(result_type)->allocate(tc, STABLE(result_type));
     size_t i, result_graphs;
 
-    result->body.storage_type    = MVM_STRING_GRAPHEME_32;
-    result->body.storage.blob_32 = MVM_malloc(sizeof(MVMGrapheme32) * bytes);
+    /* Everything valid fits in 8 bits, so we decode straight to ASCII
+     * storage, switching to 8-bit NFG storage if we meet a \r\n (which,
+     * like in latin1 decoding, is a synthetic that fits in 8 bits). */
+    result->body.storage_type   = MVM_STRING_GRAPHEME_ASCII;
+    result->body.storage.blob_8 = MVM_malloc(sizeof(MVMGrapheme8) * bytes);
 
     result_graphs = 0;
     for (i = 0; i < bytes; i++) {
         if (ascii[i] == '\r' && i + 1 < bytes && ascii[i + 1] == '\n') {
-            result->body.storage.blob_32[result_graphs++] = MVM_nfg_crlf_grapheme(tc);
+            result->body.storage.blob_8[result_graphs++] = MVM_nfg_crlf_grapheme(tc);
+            result->body.storage_type = MVM_STRING_GRAPHEME_8;
             i++;
         }
         else if (ascii[i] >= 0) {
-            result->body.storage.blob_32[result_graphs++] = ascii[i];
+            result->body.storage.blob_8[result_graphs++] = ascii[i];
         }
         else {
             MVM_exception_throw_adhoc(tc,
@@ -0,0 +1,113 @@
+#include "moar.h"
+
+/* Sets up the string intern table, unless interning has been disabled by
+ * setting MVM_STRING_INTERN_DISABLE. */
+void MVM_string_intern_init(MVMInstance *instance) {
+    MVMStringInternTable *table;
+    if (getenv("MVM_STRING_INTERN_DISABLE"))
+        return;
+    table            = MVM_calloc(1, sizeof(MVMStringInternTable));
+    table->num_slots = MVM_STRING_INTERN_INITIAL_SIZE;
+    table->slots     = MVM_calloc(table->num_slots, sizeof(MVMString *));
+    instance->string_interns = table;
+}
+
+/* Finds the slot holding a string equal to the one passed, or the empty slot
+ * it would go in if there is none. Must hold the lock, or be in GC. */
+static MVMuint32 find_slot(MVMThreadContext *tc, MVMStringInternTable *table, MVMString *s) {
+    MVMuint32 mask = table->num_slots - 1;
+    MVMuint32 slot = (MVMuint32)s->body.cached_hash_code & mask;
+    MVMString *cur;
+    while ((cur = table->slots[slot])) {
+        if (cur == s || (cur->body.cached_hash_code == s->body.cached_hash_code
+                && MVM_string_equal(tc, cur, s)))
+            break;
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/* Moves the entries of the table into a new set of slots. When in a full
+ * collection, the entries for strings that it didn't find to be live are
+ * dropped. Must hold the lock, or be in GC. */
+static void resize(MVMThreadContext *tc, MVMStringInternTable *table, MVMuint32 num_slots,
+                   MVMint32 only_live) {
+    MVMString **old_slots     = table->slots;
+    MVMuint32   old_num_slots = table->num_slots;
+    MVMuint32   mask          = num_slots - 1;
+    MVMuint32   i;
+    table->slots     = MVM_calloc(num_slots, sizeof(MVMString *));
+    table->num_slots = num_slots;
+    table->num_used  = 0;
+    for (i = 0; i < old_num_slots; i++) {
+        MVMString *s = old_slots[i];
+        if (s && (!only_live || (s->common.header.flags & MVM_CF_GEN2_LIVE))) {
+            /* The strings are all different, so just find an empty slot. */
+            MVMuint32 slot = (MVMuint32)s->body.cached_hash_code & mask;
+            while (table->slots[slot])
+                slot = (slot + 1) & mask;
+            table->slots[slot] = s;
+            table->num_used++;
+        }
+    }
+    MVM_free(old_slots);
+}
+
+/* Returns the interned string equal to the one passed, if there is one. If
+ * not, the string is returned, and if it's in gen2 it is also interned. Long
+ * strings and strand strings are never interned. */
+MVMString * MVM_string_intern(MVMThreadContext *tc, MVMString *s) {
+    MVMStringInternTable *table = tc->instance->string_interns;
+    MVMString            *result;
+    MVMuint32             slot;
+
+    if (!table || s->body.storage_type == MVM_STRING_STRAND
+            || s->body.num_graphs > MVM_STRING_INTERN_MAX_GRAPHS)
+        return s;
+    if (!s->body.cached_hash_code)
+        MVM_string_compute_hash_code(tc, s);
+
+    uv_mutex_lock(&tc->instance->mutex_string_interns);
+    slot   = find_slot(tc, table, s);
+    result = table->slots[slot];
+    if (!result) {
+        result = s;
+        if (s->common.header.flags & MVM_CF_SECOND_GEN) {
+            table->slots[slot] = s;
+            if (++table->num_used * 4 > table->num_slots * 3)
+                resize(tc, table, table->num_slots * 2, 0);
+        }
+    }
+    uv_mutex_unlock(&tc->instance->mutex_string_interns);
+
+    return result;
+}
+
+/* Called by the GC co-ordinator during a full collection, after marking but
+ * before gen2 is swept, to remove the entries of strings that are now dead.
+ * The table is also shrunk if it has become mostly empty. */
+void MVM_string_intern_gc_cleanup(MVMThreadContext *tc) {
+    MVMStringInternTable *table = tc->instance->string_interns;
+    MVMuint32             num_slots, num_live = 0, i;
+    if (!table)
+        return;
+    for (i = 0; i < table->num_slots; i++)
+        if (table->slots[i] && (table->slots[i]->common.header.flags & MVM_CF_GEN2_LIVE))
+            num_live++;
+    if (num_live == table->num_used)
+        return;
+    num_slots = table->num_slots;
+    while (num_slots > MVM_STRING_INTERN_INITIAL_SIZE && num_live * 8 < num_slots)
+        num_slots /= 2;
+    resize(tc, table, num_slots, 1);
+}
+
+/* Frees the string intern table. */
+void MVM_string_intern_destroy(MVMInstance *instance) {
+    MVMStringInternTable *table = instance->string_interns;
+    if (table) {
+        MVM_free(table->slots);
+        MVM_free(table);
+        instance->string_interns = NULL;
+    }
+}
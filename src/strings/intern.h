@@ -0,0 +1,25 @@
+/* Strings of up to this many graphemes may be interned. */
+#define MVM_STRING_INTERN_MAX_GRAPHS    64
+
+/* Number of slots the intern table starts out with; always a power of 2. */
+#define MVM_STRING_INTERN_INITIAL_SIZE  1024
+
+/* The table of interned strings, used so that equal short strings coming
+ * from different places (such as the string heaps of different compilation
+ * units) can be the same object, and so compare equal by pointer. It is an
+ * open addressing hash table, keyed on the strings' hash codes. Only strings
+ * in gen2 are added, and the table does not keep them alive; entries for any
+ * that die are removed during full collections. */
+struct MVMStringInternTable {
+    /* The slots, NULL where empty. */
+    MVMString **slots;
+
+    /* Number of slots, and the number of them in use. */
+    MVMuint32 num_slots;
+    MVMuint32 num_used;
+};
+
+void MVM_string_intern_init(MVMInstance *instance);
+MVMString * MVM_string_intern(MVMThreadContext *tc, MVMString *s);
+void MVM_string_intern_gc_cleanup(MVMThreadContext *tc);
+void MVM_string_intern_destroy(MVMInstance *instance);
@@ -5,14 +5,22 @@
 #define MVM_SYNTHETIC_GROW_ELEMS 32
 
 /* Finds the index of a given codepoint within a trie node. Returns it if
- * there is one, or negative if there is not (note 0 is a valid index). */
+ * there is one, or negative if there is not (note 0 is a valid index). The
+ * entries are sorted, so we can binary search them. */
 static MVMint32 find_child_node_idx(MVMThreadContext *tc, const MVMNFGTrieNode *node, MVMCodepoint cp) {
     if (node) {
-        /* TODO: update this to do a binary search later on. */
-        MVMint32 i;
-        for (i = 0; i < node->num_entries; i++)
-            if (node->next_codes[i].code == cp)
-                return i;
+        MVMint32 lo = 0;
+        MVMint32 hi = node->num_entries - 1;
+        while (lo <= hi) {
+            MVMint32     mid  = lo + (hi - lo) / 2;
+            MVMCodepoint code = node->next_codes[mid].code;
+            if (code == cp)
+                return mid;
+            if (code < cp)
+                lo = mid + 1;
+            else
+                hi = mid - 1;
+        }
     }
     return -1;
 }
@@ -190,11 +198,32 @@ static MVMGrapheme32 add_synthetic(MVMThreadContext *tc, MVMCodepoint *codes, MV
     return result;
 }
 
-/* Does a lookup of a synthetic in the trie. If we find one, returns it. If
- * not, acquires the update lock, re-checks that we really are missing the
- * synthetic, and then adds it. */
+/* Finds the entry in the thread's synthetics cache that a codepoint sequence
+ * would be held in, or NULL if the sequence is too long to be cached. */
+static MVMNFGCacheEntry * cache_entry_for(MVMThreadContext *tc, MVMCodepoint *codes, MVMint32 num_codes) {
+    MVMuint32 hash = (MVMuint32)num_codes;
+    MVMint32  i;
+    if (num_codes > MVM_NFG_CACHE_MAX_CODES)
+        return NULL;
+    if (!tc->nfg_cache)
+        tc->nfg_cache = MVM_calloc(MVM_NFG_CACHE_SIZE, sizeof(MVMNFGCacheEntry));
+    for (i = 0; i < num_codes; i++)
+        hash = hash * 31 + (MVMuint32)codes[i];
+    hash ^= hash >> 7;
+    return &(tc->nfg_cache[hash % MVM_NFG_CACHE_SIZE]);
+}
+
+/* Does a lookup of a synthetic, first in the thread's cache and then in the
+ * trie. If we find one, returns it. If not, acquires the update lock,
+ * re-checks that we really are missing the synthetic, and then adds it. */
 static MVMGrapheme32 lookup_or_add_synthetic(MVMThreadContext *tc, MVMCodepoint *codes, MVMint32 num_codes, MVMint32 utf8_c8) {
-    MVMGrapheme32 result = lookup_synthetic(tc, codes, num_codes);
+    MVMNFGCacheEntry *entry = cache_entry_for(tc, codes, num_codes);
+    MVMGrapheme32     result;
+    if (entry && entry->num_codes == num_codes
+            && memcmp(entry->codes, codes, num_codes * sizeof(MVMCodepoint)) == 0)
+        return entry->graph;
+
+    result = lookup_synthetic(tc, codes, num_codes);
     if (!result) {
         uv_mutex_lock(&tc->instance->nfg->update_mutex);
         result = lookup_synthetic(tc, codes, num_codes);
@@ -202,6 +231,12 @@ static MVMGrapheme32 lookup_or_add_synthetic(MVMThreadContext *tc, MVMCodepoint
             result = add_synthetic(tc, codes, num_codes, utf8_c8);
         uv_mutex_unlock(&tc->instance->nfg->update_mutex);
     }
+
+    if (entry) {
+        memcpy(entry->codes, codes, num_codes * sizeof(MVMCodepoint));
+        entry->num_codes = num_codes;
+        entry->graph     = result;
+    }
     return result;
 }
 
@@ -350,17 +385,20 @@ static MVMint32 passes_quickcheck_and_zero_ccc(MVMThreadContext *tc, MVMCodepoin
         (!ccc_str || strlen(ccc_str) > 3 || (strlen(ccc_str) == 1 && ccc_str[0] == 0));
 }
 MVMint32 MVM_nfg_is_concat_stable(MVMThreadContext *tc, MVMString *a, MVMString *b) {
-    MVMGrapheme32 last_a;
-    MVMGrapheme32 first_b;
-
     /* If either string is empty, we're good. */
     if (a->body.num_graphs == 0 || b->body.num_graphs == 0)
         return 1;
 
-    /* Get first and last graphemes of the strings. */
-    last_a = MVM_string_get_grapheme_at_nocheck(tc, a, a->body.num_graphs - 1);
-    first_b = MVM_string_get_grapheme_at_nocheck(tc, b, 0);
+    /* Otherwise, it's down to the first and last graphemes of the strings. */
+    return MVM_nfg_is_concat_stable_graphemes(tc,
+        MVM_string_get_grapheme_at_nocheck(tc, a, a->body.num_graphs - 1),
+        MVM_string_get_grapheme_at_nocheck(tc, b, 0));
+}
 
+/* Checks if placing grapheme first_b straight after grapheme last_a would
+ * leave us in NFG. */
+MVMint32 MVM_nfg_is_concat_stable_graphemes(MVMThreadContext *tc, MVMGrapheme32 last_a,
+                                            MVMGrapheme32 first_b) {
     /* If either is synthetic, assume we'll have to re-normalize (this is an
      * over-estimate, most likely). Note if you optimize this that it serves
      * as a guard for what follows. */
@@ -4,7 +4,9 @@
  * and be sure to validate nothing changed. We also must do sufficient copying
  * to ensure that we never break another thread doing a read. Memory to be
  * freed is thus done at a global safe point, which means we never have one
- * thread reading memory freed by another. */
+ * thread reading memory freed by another. On top of that, each thread keeps
+ * a small cache of the synthetics it recently looked up, so that it need not
+ * walk the trie again for the combining sequences that recur in its text. */
 struct MVMNFGState {
     /* Table of information about synthetic graphemes. Given some (negative)
      * synthetic S, we look up in this table with (-S - 1). */
@@ -71,6 +73,19 @@ struct MVMNFGTrieNodeEntry {
     MVMNFGTrieNode *node;
 };
 
+/* Number of entries in each thread's cache of recently looked up synthetics,
+ * and the most codepoints a sequence may have to be cached. */
+#define MVM_NFG_CACHE_SIZE       64
+#define MVM_NFG_CACHE_MAX_CODES  4
+
+/* An entry in a thread's synthetics cache. Synthetics are never removed, so
+ * an entry stays valid forever; a num_codes of zero marks an empty entry. */
+struct MVMNFGCacheEntry {
+    MVMCodepoint  codes[MVM_NFG_CACHE_MAX_CODES];
+    MVMint32      num_codes;
+    MVMGrapheme32 graph;
+};
+
 /* Functions related to grapheme handling. */
 MVMGrapheme32 MVM_nfg_codes_to_grapheme(MVMThreadContext *tc, MVMCodepoint *codes, MVMint32 num_codes);
 MVMGrapheme32 MVM_nfg_codes_to_grapheme_utf8_c8(MVMThreadContext *tc, MVMCodepoint *codes, MVMint32 num_codes);
@@ -78,6 +93,8 @@ MVMGrapheme32 MVM_nfg_crlf_grapheme(MVMThreadContext *tc);
 MVMNFGSynthetic * MVM_nfg_get_synthetic_info(MVMThreadContext *tc, MVMGrapheme32 synth);
 MVMuint32 MVM_nfg_get_case_change(MVMThreadContext *tc, MVMGrapheme32 codepoint, MVMint32 case_, MVMGrapheme32 **result);
 MVMint32 MVM_nfg_is_concat_stable(MVMThreadContext *tc, MVMString *a, MVMString *b);
+MVMint32 MVM_nfg_is_concat_stable_graphemes(MVMThreadContext *tc, MVMGrapheme32 last_a,
+    MVMGrapheme32 first_b);
 
 /* NFG subsystem cleanup. */
 void MVM_nfg_destroy(MVMThreadContext *tc);
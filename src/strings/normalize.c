@@ -37,7 +37,7 @@ void MVM_unicode_normalize_codepoints(MVMThreadContext *tc, const MVMObject *in,
     MVMNormalizer  norm;
     MVMCodepoint  *input;
     MVMCodepoint  *result;
-    MVMint64       input_pos, input_codes, result_pos, result_alloc;
+    MVMint64       input_codes, result_pos, result_alloc;
     MVMint32       ready;
 
     /* Validate input/output array. */
@@ -56,19 +56,9 @@ void MVM_unicode_normalize_codepoints(MVMThreadContext *tc, const MVMObject *in,
 
     /* Perform normalization. */
     MVM_unicode_normalizer_init(tc, &norm, form);
-    input_pos  = 0;
     result_pos = 0;
-    while (input_pos < input_codes) {
-        MVMCodepoint cp;
-        ready = MVM_unicode_normalizer_process_codepoint(tc, &norm, input[input_pos], &cp);
-        if (ready) {
-            maybe_grow_result(&result, &result_alloc, result_pos + ready);
-            result[result_pos++] = cp;
-            while (--ready > 0)
-                result[result_pos++] = MVM_unicode_normalizer_get_codepoint(tc, &norm);
-        }
-        input_pos++;
-    }
+    MVM_unicode_normalizer_process_codepoints(tc, &norm, input, input_codes,
+        &result, &result_alloc, &result_pos);
     MVM_unicode_normalizer_eof(tc, &norm);
     ready = MVM_unicode_normalizer_available(tc, &norm);
     maybe_grow_result(&result, &result_alloc, result_pos + ready);
@@ -83,7 +73,7 @@ void MVM_unicode_normalize_codepoints(MVMThreadContext *tc, const MVMObject *in,
 }
 MVMString * MVM_unicode_codepoints_c_array_to_nfg_string(MVMThreadContext *tc, MVMCodepoint * cp_v, MVMint64 cp_count) {
     MVMNormalizer  norm;
-    MVMint64       input_pos, result_pos, result_alloc;
+    MVMint64       result_pos, result_alloc;
     MVMGrapheme32 *result;
     MVMint32       ready;
     MVMString     *str;
@@ -97,19 +87,9 @@ MVMString * MVM_unicode_codepoints_c_array_to_nfg_string(MVMThreadContext *tc, M
 
     /* Perform normalization at grapheme level. */
     MVM_unicode_normalizer_init(tc, &norm, MVM_NORMALIZE_NFG);
-    input_pos  = 0;
     result_pos = 0;
-    while (input_pos < cp_count) {
-        MVMGrapheme32 g;
-        ready = MVM_unicode_normalizer_process_codepoint_to_grapheme(tc, &norm, cp_v[input_pos], &g);
-        if (ready) {
-            maybe_grow_result(&result, &result_alloc, result_pos + ready);
-            result[result_pos++] = g;
-            while (--ready > 0)
-                result[result_pos++] = MVM_unicode_normalizer_get_grapheme(tc, &norm);
-        }
-        input_pos++;
-    }
+    MVM_unicode_normalizer_process_codepoints(tc, &norm, cp_v, cp_count,
+        &result, &result_alloc, &result_pos);
     MVM_unicode_normalizer_eof(tc, &norm);
     ready = MVM_unicode_normalizer_available(tc, &norm);
     maybe_grow_result(&result, &result_alloc, result_pos + ready);
@@ -122,6 +102,7 @@ MVMString * MVM_unicode_codepoints_c_array_to_nfg_string(MVMThreadContext *tc, M
     str->body.storage.blob_32 = result;
     str->body.storage_type    = MVM_STRING_GRAPHEME_32;
     str->body.num_graphs      = result_pos;
+    MVM_string_try_narrow(tc, str);
     return str;
 }
 
@@ -640,6 +621,113 @@ static void grapheme_composition(MVMThreadContext *tc, MVMNormalizer *n, MVMint3
     }
 }
 
+/* Cache of whether codepoints in the BMP are safe starters for each of the
+ * normalization forms, so we need not look up their properties each time.
+ * Two bits per form are used: one saying if we know, the other if it is. The
+ * cache is filled in lazily; two threads racing to fill in the same entry can
+ * lose the other's bits, but never set wrong ones. */
+static MVMuint16 safe_starter_cache[0x10000];
+
+/* Computes whether a codepoint is a safe starter: it does not need to go
+ * through any real normalization machinery, and it prevents anything before
+ * it from interacting with anything after it. That's the case if it passes
+ * the quick check for the form and has a canonical combining class of zero,
+ * so long as it's not a normalization terminator, prepend, or \r. For NFG it
+ * must also have a Grapheme_Cluster_Break of Other, as anything else (such
+ * as spacing marks, extenders with a CCC of zero, ZWJ, regional indicators,
+ * emoji modifiers and bases, and Hangul jamo and syllables) may join onto
+ * its neighbours to form a grapheme. */
+static MVMint32 compute_safe_starter(MVMThreadContext *tc, const MVMNormalizer *n, MVMCodepoint cp) {
+    return !is_grapheme_prepend(tc, cp)
+        && !(cp > 0xFF && is_control_beyond_latin1(tc, cp))
+        && passes_quickcheck(tc, n, cp)
+        && ccc(tc, cp) == 0
+        && (n->form != MVM_NORMALIZE_NFG ||
+            MVM_unicode_codepoint_get_property_int(tc, cp,
+                MVM_UNICODE_PROPERTY_GRAPHEME_CLUSTER_BREAK) == MVM_UNICODE_PVALUE_GCB_OTHER);
+}
+static MVMint32 is_safe_starter(MVMThreadContext *tc, const MVMNormalizer *n, MVMCodepoint cp) {
+    if (cp < 0x20 || (cp >= 0x7F && cp <= 0x9F) || cp == 0xAD)
+        return 0;
+    if (cp < n->first_significant)
+        return 1;
+    if (cp < 0x10000) {
+        MVMuint32 shift = 2 * (n->form == MVM_NORMALIZE_NFG ? 4 : n->form);
+        MVMuint16 entry = safe_starter_cache[cp];
+        MVMint32  safe;
+        if (entry & (1 << shift))
+            return (entry >> (shift + 1)) & 1;
+        safe = compute_safe_starter(tc, n, cp);
+        safe_starter_cache[cp] = entry | (1 << shift) | (safe << (shift + 1));
+        return safe;
+    }
+    return compute_safe_starter(tc, n, cp);
+}
+
+/* Normalizes a block of codepoints, appending those that become available
+ * to a result buffer, which is grown as needed. Runs of safe starters are
+ * copied straight to the result when nothing waiting in the normalizer could
+ * interact with them; only the codepoints around anything else go through
+ * the normalizer one at a time. */
+void MVM_unicode_normalizer_process_codepoints(MVMThreadContext *tc, MVMNormalizer *n,
+        const MVMCodepoint *in, MVMint64 num_in, MVMCodepoint **result,
+        MVMint64 *result_alloc, MVMint64 *result_pos) {
+    MVMint32 composing = MVM_NORMALIZE_COMPOSE(n->form);
+    MVMint64 i = 0;
+    while (i < num_in) {
+        /* When composing, the normalizer must be holding back exactly one
+         * safe starter (which it does until it sees what follows); when
+         * decomposing, it must be holding nothing. */
+        MVMint32 idle = composing
+            ? n->buffer_end - n->buffer_start == 1 && n->buffer_norm_end == n->buffer_start
+                && is_safe_starter(tc, n, n->buffer[n->buffer_start])
+            : n->buffer_end == n->buffer_start;
+        if (idle) {
+            MVMint64 run_end = i;
+            while (run_end < num_in && is_safe_starter(tc, n, in[run_end]))
+                run_end++;
+            if (run_end > i) {
+                MVMint64 run = run_end - i;
+                if (*result_pos + run > *result_alloc) {
+                    while (*result_pos + run > *result_alloc)
+                        *result_alloc = *result_alloc ? *result_alloc * 2 : 32;
+                    *result = MVM_realloc(*result, *result_alloc * sizeof(MVMCodepoint));
+                }
+                if (composing) {
+                    /* Hand back the one held back, and hold back the last of
+                     * the run in its place. */
+                    (*result)[(*result_pos)++] = n->buffer[n->buffer_start];
+                    memcpy(*result + *result_pos, in + i, (run - 1) * sizeof(MVMCodepoint));
+                    *result_pos += run - 1;
+                    n->buffer[n->buffer_start] = in[run_end - 1];
+                }
+                else {
+                    memcpy(*result + *result_pos, in + i, run * sizeof(MVMCodepoint));
+                    *result_pos += run;
+                }
+                i = run_end;
+                continue;
+            }
+        }
+
+        /* Otherwise, pass the codepoint through the normalizer. */
+        {
+            MVMCodepoint cp;
+            MVMint32     ready = MVM_unicode_normalizer_process_codepoint(tc, n, in[i++], &cp);
+            if (ready) {
+                if (*result_pos + ready > *result_alloc) {
+                    while (*result_pos + ready > *result_alloc)
+                        *result_alloc = *result_alloc ? *result_alloc * 2 : 32;
+                    *result = MVM_realloc(*result, *result_alloc * sizeof(MVMCodepoint));
+                }
+                (*result)[(*result_pos)++] = cp;
+                while (--ready > 0)
+                    (*result)[(*result_pos)++] = MVM_unicode_normalizer_get_codepoint(tc, n);
+            }
+        }
+    }
+}
+
 /* Called when the very fast case of normalization fails (that is, when we get
  * any two codepoints in a row where at least one is greater than the first
  * significant codepoint identified by a quick check for the target form). We
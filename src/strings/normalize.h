@@ -118,6 +118,13 @@ MVM_STATIC_INLINE MVMint32 MVM_unicode_normalizer_process_codepoint_to_grapheme(
     return MVM_unicode_normalizer_process_codepoint(tc, n, in, (MVMGrapheme32 *)out);
 }
 
+/* Normalizes a block of codepoints, appending what becomes available to a
+ * growable result buffer; faster than one codepoint at a time for input that
+ * is mostly already normalized. */
+void MVM_unicode_normalizer_process_codepoints(MVMThreadContext *tc, MVMNormalizer *n,
+    const MVMCodepoint *in, MVMint64 num_in, MVMCodepoint **result, MVMint64 *result_alloc,
+    MVMint64 *result_pos);
+
 /* Push a number of codepoints into the "to normalize" buffer. */
 void MVM_unicode_normalizer_push_codepoints(MVMThreadContext *tc, MVMNormalizer *n, const MVMCodepoint *in, MVMint32 num_codepoints);
 
@@ -53,6 +53,57 @@ static void turn_32bit_into_8bit_unchecked(MVMThreadContext *tc, MVMString *str)
     MVM_free(old_buf);
 }
 
+/* Checks if all of the graphemes of a string are held in 8-bit storage,
+ * either its own or that of every one of its strands. */
+static MVMint32 is_8bit_storage(MVMString *s) {
+    switch (s->body.storage_type) {
+    case MVM_STRING_GRAPHEME_ASCII:
+    case MVM_STRING_GRAPHEME_8:
+        return 1;
+    case MVM_STRING_STRAND: {
+        MVMuint16 i;
+        for (i = 0; i < s->body.num_strands; i++)
+            if (s->body.storage.strands[i].blob_string->body.storage_type == MVM_STRING_GRAPHEME_32)
+                return 0;
+        return 1;
+    }
+    default:
+        return 0;
+    }
+}
+
+/* Copies count graphemes of a string that is_8bit_storage is true for,
+ * starting at the specified grapheme, into an 8-bit buffer. */
+static void copy_8bit_graphemes(MVMThreadContext *tc, MVMString *s, MVMStringIndex start,
+                                MVMStringIndex count, MVMGrapheme8 *out) {
+    if (s->body.storage_type == MVM_STRING_STRAND) {
+        MVMGraphemeIter gi;
+        MVMStringIndex  i;
+        MVM_string_gi_init(tc, &gi, s);
+        if (start)
+            MVM_string_gi_move_to(tc, &gi, start);
+        for (i = 0; i < count; i++)
+            out[i] = (MVMGrapheme8)MVM_string_gi_get_grapheme(tc, &gi);
+    }
+    else {
+        memcpy(out, s->body.storage.blob_8 + start, count * sizeof(MVMGrapheme8));
+    }
+}
+
+/* If a string is using 32-bit storage but all of its graphemes would fit in
+ * 8 bits, switches it over to 8-bit storage. For use on freshly produced
+ * strings where we only learn what was in them after building them. */
+void MVM_string_try_narrow(MVMThreadContext *tc, MVMString *s) {
+    if (s->body.storage_type == MVM_STRING_GRAPHEME_32 && s->body.num_graphs) {
+        MVMGrapheme32  *buf = s->body.storage.blob_32;
+        MVMStringIndex  i;
+        for (i = 0; i < s->body.num_graphs; i++)
+            if (buf[i] < -127 || buf[i] > 127)
+                return;
+        turn_32bit_into_8bit_unchecked(tc, s);
+    }
+}
+
 /* Collapses a bunch of strands into a single blob string. */
 static MVMString * collapse_strands(MVMThreadContext *tc, MVMString *orig) {
     MVMString       *result;
@@ -66,6 +117,12 @@ static MVMString * collapse_strands(MVMThreadContext *tc, MVMString *orig) {
     });
     ographs                      = MVM_string_graphs(tc, orig);
     result->body.num_graphs      = ographs;
+    if (is_8bit_storage(orig)) {
+        result->body.storage_type    = MVM_STRING_GRAPHEME_8;
+        result->body.storage.blob_8  = MVM_malloc(ographs * sizeof(MVMGrapheme8));
+        copy_8bit_graphemes(tc, orig, 0, ographs, result->body.storage.blob_8);
+        return result;
+    }
     result->body.storage_type    = MVM_STRING_GRAPHEME_32;
     result->body.storage.blob_32 = MVM_malloc(ographs * sizeof(MVMGrapheme32));
 
@@ -83,6 +140,133 @@ static MVMString * collapse_strands(MVMThreadContext *tc, MVMString *orig) {
     return result;
 }
 
+/* Number of graphemes a strand covers, including repetitions. */
+static MVMuint64 strand_graphs(MVMStringStrand *ss) {
+    return (MVMuint64)(ss->end - ss->start) * (ss->repetitions + 1);
+}
+
+/* Makes a blob string of the graphemes of a run of strands of a strand
+ * string, from first up to but excluding last, and replaces the run with a
+ * single strand referring to it. The string must be rooted by the caller. */
+static void merge_strands(MVMThreadContext *tc, MVMString *s, MVMuint16 first, MVMuint16 last) {
+    MVMString       *merged;
+    MVMStringStrand *ss;
+    MVMuint64        num_graphs = 0;
+    MVMuint32        pos = 0;
+    MVMuint16        i;
+    MVMint8          all_8bit = 1;
+    MVMint8          can_use_8bit = 1;
+
+    merged = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+    ss = s->body.storage.strands;
+    for (i = first; i < last; i++) {
+        num_graphs += strand_graphs(&ss[i]);
+        if (ss[i].blob_string->body.storage_type == MVM_STRING_GRAPHEME_32)
+            all_8bit = 0;
+    }
+    merged->body.num_graphs = (MVMuint32)num_graphs;
+
+    /* If all the strands are 8-bit, so is the result, and we can just copy. */
+    if (all_8bit) {
+        merged->body.storage_type   = MVM_STRING_GRAPHEME_8;
+        merged->body.storage.blob_8 = MVM_malloc(num_graphs * sizeof(MVMGrapheme8));
+        for (i = first; i < last; i++) {
+            MVMStringIndex len = ss[i].end - ss[i].start;
+            MVMuint32      rep;
+            for (rep = 0; rep <= ss[i].repetitions; rep++) {
+                memcpy(merged->body.storage.blob_8 + pos,
+                    ss[i].blob_string->body.storage.blob_8 + ss[i].start,
+                    len * sizeof(MVMGrapheme8));
+                pos += len;
+            }
+        }
+        can_use_8bit = 0;
+    }
+    else {
+        merged->body.storage_type    = MVM_STRING_GRAPHEME_32;
+        merged->body.storage.blob_32 = MVM_malloc(num_graphs * sizeof(MVMGrapheme32));
+    }
+
+    for (i = first; i < last && !all_8bit; i++) {
+        MVMString     *blob = ss[i].blob_string;
+        MVMStringIndex len  = ss[i].end - ss[i].start;
+        MVMuint32      rep;
+        for (rep = 0; rep <= ss[i].repetitions; rep++) {
+            MVMStringIndex j;
+            if (blob->body.storage_type == MVM_STRING_GRAPHEME_32) {
+                memcpy(merged->body.storage.blob_32 + pos,
+                    blob->body.storage.blob_32 + ss[i].start,
+                    len * sizeof(MVMGrapheme32));
+                for (j = 0; j < len && can_use_8bit; j++) {
+                    MVMGrapheme32 g = merged->body.storage.blob_32[pos + j];
+                    if (g < -127 || g > 127)
+                        can_use_8bit = 0;
+                }
+            }
+            else {
+                for (j = 0; j < len; j++)
+                    merged->body.storage.blob_32[pos + j] =
+                        blob->body.storage.blob_8[ss[i].start + j];
+            }
+            pos += len;
+        }
+    }
+    if (can_use_8bit)
+        turn_32bit_into_8bit_unchecked(tc, merged);
+
+    MVM_ASSIGN_REF(tc, &(s->common.header), ss[first].blob_string, merged);
+    ss[first].start       = 0;
+    ss[first].end         = (MVMStringIndex)num_graphs;
+    ss[first].repetitions = 0;
+    memmove(ss + first + 1, ss + last, (s->body.num_strands - last) * sizeof(MVMStringStrand));
+    s->body.num_strands -= last - first - 1;
+}
+
+/* Brings the strand string resulting from a concatenation back down to the
+ * maximum number of strands by merging runs of them. We look for the first
+ * strand that is no longer than all of those after it, and merge from there
+ * to the end; likewise from the other end. Whichever merge copies the fewest
+ * graphemes is done. That keeps strand lengths falling off geometrically
+ * towards the end a string is being built at, much like a binary counter, so
+ * building a string piece by piece copies each grapheme O(log n) times, not
+ * the whole string each time the strand limit is hit. The string must be
+ * rooted by the caller. */
+static void rebalance_strands(MVMThreadContext *tc, MVMString *s) {
+    /* Both sides of a concatenation have at most the maximum strands. */
+    MVMuint64 totals[2 * MVM_STRING_MAX_STRANDS + 1];
+    assert(s->body.num_strands <= 2 * MVM_STRING_MAX_STRANDS);
+    while (s->body.num_strands > MVM_STRING_MAX_STRANDS) {
+        MVMStringStrand *strands   = s->body.storage.strands;
+        MVMuint16        n         = s->body.num_strands;
+        MVMuint16        from_left = n - 2;
+        MVMuint16        to_right  = 2;
+        MVMuint16        i;
+
+        /* totals[i] is the graphemes in all strands before strand i. */
+        totals[0] = 0;
+        for (i = 0; i < n; i++)
+            totals[i + 1] = totals[i] + strand_graphs(&strands[i]);
+
+        for (i = 0; i < n - 1; i++) {
+            if (totals[i + 1] - totals[i] <= totals[n] - totals[i + 1]) {
+                from_left = i;
+                break;
+            }
+        }
+        for (i = n - 1; i > 0; i--) {
+            if (totals[i + 1] - totals[i] <= totals[i]) {
+                to_right = i + 1;
+                break;
+            }
+        }
+
+        if (totals[n] - totals[from_left] <= totals[to_right])
+            merge_strands(tc, s, from_left, n);
+        else
+            merge_strands(tc, s, 0, to_right);
+    }
+}
+
 /* Takes a string that is no longer in NFG form after some concatenation-style
  * operation, and returns a new string that is in NFG. Note that we could do a
  * much, much, smarter thing in the future that doesn't involve all of this
@@ -135,6 +319,7 @@ static MVMString * re_nfg(MVMThreadContext *tc, MVMString *in) {
     out->body.storage.blob_32 = out_buffer;
     out->body.storage_type    = MVM_STRING_GRAPHEME_32;
     out->body.num_graphs      = out_pos;
+    MVM_string_try_narrow(tc, out);
     return out;
 }
 
@@ -339,6 +524,14 @@ MVMString * MVM_string_substring(MVMThreadContext *tc, MVMString *a, MVMint64 of
             result->body.storage.strands[0].end         = orig_strand->start + end_pos;
             result->body.storage.strands[0].repetitions = 0;
         }
+        else if (is_8bit_storage(a)) {
+            /* Produce a new blob string, collapsing the strands; they're all
+             * 8-bit, so the result will be too. */
+            result->body.storage_type   = MVM_STRING_GRAPHEME_8;
+            result->body.storage.blob_8 = MVM_malloc(result->body.num_graphs * sizeof(MVMGrapheme8));
+            copy_8bit_graphemes(tc, a, start_pos, result->body.num_graphs,
+                result->body.storage.blob_8);
+        }
         else {
             /* Produce a new blob string, collapsing the strands. */
             MVMGraphemeIter gi;
@@ -434,52 +627,42 @@ MVMString * MVM_string_concatenate(MVMThreadContext *tc, MVMString *a, MVMString
 
         /* Otherwise, construct a new strand string. */
         else {
-            /* See if we have too many strands between the two. If so, we will
-             * collapse the biggest side. */
+            /* Take the strands of both sides. */
             MVMuint16 strands_a = a->body.storage_type == MVM_STRING_STRAND
                 ? a->body.num_strands
                 : 1;
             MVMuint16 strands_b = b->body.storage_type == MVM_STRING_STRAND
                 ? b->body.num_strands
                 : 1;
-            MVMString *effective_a = a;
-            MVMString *effective_b = b;
-            if (strands_a + strands_b > MVM_STRING_MAX_STRANDS) {
-                MVMROOT(tc, result, {
-                    if (strands_a >= strands_b) {
-                        effective_a = collapse_strands(tc, effective_a);
-                        strands_a   = 1;
-                    }
-                    else {
-                        effective_b = collapse_strands(tc, effective_b);
-                        strands_b   = 1;
-                    }
-                });
-            }
-
-            /* Assemble the result. */
-            result->body.num_strands = strands_a + strands_b;
             result->body.storage.strands = allocate_strands(tc, strands_a + strands_b);
-            if (effective_a->body.storage_type == MVM_STRING_STRAND) {
-                copy_strands(tc, effective_a, 0, result, 0, strands_a);
+            if (a->body.storage_type == MVM_STRING_STRAND) {
+                copy_strands(tc, a, 0, result, 0, strands_a);
             }
             else {
                 MVMStringStrand *ss = &(result->body.storage.strands[0]);
-                ss->blob_string = effective_a;
+                ss->blob_string = a;
                 ss->start       = 0;
-                ss->end         = effective_a->body.num_graphs;
+                ss->end         = a->body.num_graphs;
                 ss->repetitions = 0;
             }
-            if (effective_b->body.storage_type == MVM_STRING_STRAND) {
-                copy_strands(tc, effective_b, 0, result, strands_a, strands_b);
+            if (b->body.storage_type == MVM_STRING_STRAND) {
+                copy_strands(tc, b, 0, result, strands_a, strands_b);
             }
             else {
                 MVMStringStrand *ss = &(result->body.storage.strands[strands_a]);
-                ss->blob_string = effective_b;
+                ss->blob_string = b;
                 ss->start       = 0;
-                ss->end         = effective_b->body.num_graphs;
+                ss->end         = b->body.num_graphs;
                 ss->repetitions = 0;
             }
+            result->body.num_strands = strands_a + strands_b;
+
+            /* If there are too many strands between the two, merge some. */
+            if (result->body.num_strands > MVM_STRING_MAX_STRANDS) {
+                MVMROOT(tc, result, {
+                    rebalance_strands(tc, result);
+                });
+            }
         }
     });
     });
@@ -691,6 +874,57 @@ MVMint64 MVM_string_index_of_grapheme(MVMThreadContext *tc, MVMString *a, MVMGra
 
 /* Case change functions. */
 static MVMint64 grapheme_is_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMGrapheme32 g);
+
+/* Case changes a string with 8-bit storage. The non-negative graphemes that
+ * fit in 8 bits are all ASCII, for which upper and title case are the same,
+ * as are lower case and case folding, and none expand. So as long as there
+ * are no synthetics, it's a simple mapping over the buffer, written so the
+ * compiler can vectorize it. Returns NULL if there are synthetics, in which
+ * case the general path must be taken. */
+static MVMString * case_change_8bit(MVMThreadContext *tc, MVMString *s, MVMint32 type) {
+    MVMGrapheme8 *in = s->body.storage.blob_8;
+    MVMuint32     n  = s->body.num_graphs;
+    MVMGrapheme8  from, to, delta, any_synthetic = 0;
+    MVMGrapheme8 *out;
+    MVMString    *result;
+    MVMuint32     i, first_change;
+
+    if (type == MVM_unicode_case_change_type_upper || type == MVM_unicode_case_change_type_title) {
+        from  = 'a';
+        to    = 'z';
+        delta = 'A' - 'a';
+    }
+    else {
+        from  = 'A';
+        to    = 'Z';
+        delta = 'a' - 'A';
+    }
+
+    for (i = 0; i < n; i++)
+        any_synthetic |= in[i];
+    if (any_synthetic < 0)
+        return NULL;
+
+    for (first_change = 0; first_change < n; first_change++)
+        if (in[first_change] >= from && in[first_change] <= to)
+            break;
+    if (first_change == n)
+        return s;
+
+    out = MVM_malloc(n * sizeof(MVMGrapheme8));
+    memcpy(out, in, first_change * sizeof(MVMGrapheme8));
+    for (i = first_change; i < n; i++) {
+        MVMGrapheme8 g = in[i];
+        out[i] = g >= from && g <= to ? g + delta : g;
+    }
+
+    result = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
+    result->body.num_graphs     = n;
+    result->body.storage_type   = s->body.storage_type;
+    result->body.storage.blob_8 = out;
+    return result;
+}
+
 static MVMString * do_case_change(MVMThreadContext *tc, MVMString *s, MVMint32 type, char *error) {
     MVMint64 sgraphs;
     MVM_string_check_arg(tc, s, error);
@@ -698,10 +932,18 @@ static MVMString * do_case_change(MVMThreadContext *tc, MVMString *s, MVMint32 t
     if (sgraphs) {
         MVMString *result;
         MVMGraphemeIter gi;
-        MVMint64 result_graphs = sgraphs;
-        MVMGrapheme32 *result_buf = MVM_malloc(result_graphs * sizeof(MVMGrapheme32));
+        MVMint64 result_graphs;
+        MVMGrapheme32 *result_buf;
         MVMint32 changed = 0;
         MVMint64 i = 0;
+        if (s->body.storage_type == MVM_STRING_GRAPHEME_ASCII ||
+                s->body.storage_type == MVM_STRING_GRAPHEME_8) {
+            result = case_change_8bit(tc, s, type);
+            if (result)
+                return result;
+        }
+        result_graphs = sgraphs;
+        result_buf = MVM_malloc(result_graphs * sizeof(MVMGrapheme32));
         MVM_string_gi_init(tc, &gi, s);
         while (MVM_string_gi_has_more(tc, &gi)) {
             MVMGrapheme32 g = MVM_string_gi_get_grapheme(tc, &gi);
@@ -815,6 +1057,7 @@ static MVMString * do_case_change(MVMThreadContext *tc, MVMString *s, MVMint32 t
             result->body.num_graphs      = result_graphs;
             result->body.storage_type    = MVM_STRING_GRAPHEME_32;
             result->body.storage.blob_32 = result_buf;
+            MVM_string_try_narrow(tc, result);
             return result;
         }
         else {
@@ -1010,12 +1253,44 @@ MVMObject * MVM_string_split(MVMThreadContext *tc, MVMString *separator, MVMStri
     return result;
 }
 
+/* Copies the graphemes of a string into the buffer of a flat result string
+ * being built, at the specified position, returning the position after them.
+ * If the result has 8-bit storage, the string must have too. */
+static MVMint64 append_to_flat(MVMThreadContext *tc, MVMString *result, MVMint64 position,
+                               MVMString *s) {
+    MVMStringIndex  graphs = MVM_string_graphs(tc, s);
+    MVMGraphemeIter gi;
+    if (result->body.storage_type == MVM_STRING_GRAPHEME_8) {
+        copy_8bit_graphemes(tc, s, 0, graphs, result->body.storage.blob_8 + position);
+        return position + graphs;
+    }
+    switch (s->body.storage_type) {
+    case MVM_STRING_GRAPHEME_32:
+        memcpy(result->body.storage.blob_32 + position, s->body.storage.blob_32,
+            graphs * sizeof(MVMGrapheme32));
+        return position + graphs;
+    case MVM_STRING_GRAPHEME_ASCII:
+    case MVM_STRING_GRAPHEME_8: {
+        MVMStringIndex i;
+        for (i = 0; i < graphs; i++)
+            result->body.storage.blob_32[position++] = s->body.storage.blob_8[i];
+        return position;
+    }
+    default:
+        MVM_string_gi_init(tc, &gi, s);
+        while (MVM_string_gi_has_more(tc, &gi))
+            result->body.storage.blob_32[position++] = MVM_string_gi_get_grapheme(tc, &gi);
+        return position;
+    }
+}
+
 MVMString * MVM_string_join(MVMThreadContext *tc, MVMString *separator, MVMObject *input) {
     MVMString  *result;
     MVMString **pieces;
     MVMint64    elems, num_pieces, sgraphs, i, is_str_array, total_graphs;
     MVMuint16   sstrands, total_strands;
     MVMint32    concats_stable = 1;
+    MVMint32    all_8bit = 1;
 
     MVM_string_check_arg(tc, separator, "join separator");
     if (!IS_CONCRETE(input))
@@ -1079,6 +1354,8 @@ MVMString * MVM_string_join(MVMThreadContext *tc, MVMString *separator, MVMObjec
                 ? piece->body.num_strands
                 : 1;
             total_graphs += piece_graphs;
+            if (!is_8bit_storage(piece))
+                all_8bit = 0;
         }
 
         /* Store piece. */
@@ -1091,6 +1368,8 @@ MVMString * MVM_string_join(MVMThreadContext *tc, MVMString *separator, MVMObjec
         return tc->instance->str_consts.empty;
     }
     result->body.num_graphs = total_graphs;
+    if (num_pieces > 1 && sgraphs && !is_8bit_storage(separator))
+        all_8bit = 0;
 
     /* If we just collect all the things as strands, are we within bounds, and
      * will be come out ahead? */
@@ -1099,11 +1378,17 @@ MVMString * MVM_string_join(MVMThreadContext *tc, MVMString *separator, MVMObjec
     }
     /*else {*/
     if (1) {
-        /* We'll produce a single, flat string. */
-        MVMint64        position = 0;
-        MVMGraphemeIter gi;
-        result->body.storage_type    = MVM_STRING_GRAPHEME_32;
-        result->body.storage.blob_32 = MVM_malloc(total_graphs * sizeof(MVMGrapheme32));
+        /* We'll produce a single, flat string, which is 8-bit if all of
+         * the things going into it are. */
+        MVMint64 position = 0;
+        if (all_8bit) {
+            result->body.storage_type   = MVM_STRING_GRAPHEME_8;
+            result->body.storage.blob_8 = MVM_malloc(total_graphs * sizeof(MVMGrapheme8));
+        }
+        else {
+            result->body.storage_type    = MVM_STRING_GRAPHEME_32;
+            result->body.storage.blob_32 = MVM_malloc(total_graphs * sizeof(MVMGrapheme32));
+        }
         for (i = 0; i < num_pieces; i++) {
             /* Get piece. */
             MVMString *piece = pieces[i];
@@ -1118,22 +1403,7 @@ MVMString * MVM_string_join(MVMThreadContext *tc, MVMString *separator, MVMObjec
                     else if (!MVM_nfg_is_concat_stable(tc, separator, piece))
                         concats_stable = 0;
 
-                    switch (separator->body.storage_type) {
-                    case MVM_STRING_GRAPHEME_32:
-                        memcpy(
-                            result->body.storage.blob_32 + position,
-                            separator->body.storage.blob_32,
-                            sgraphs * sizeof(MVMGrapheme32));
-                        position += sgraphs;
-                        break;
-                    /* XXX Can special-case 8-bit NFG and ASCII here too. */
-                    default:
-                        MVM_string_gi_init(tc, &gi, separator);
-                        while (MVM_string_gi_has_more(tc, &gi))
-                            result->body.storage.blob_32[position++] =
-                                MVM_string_gi_get_grapheme(tc, &gi);
-                        break;
-                    }
+                    position = append_to_flat(tc, result, position, separator);
                 }
                 else {
                     /* Separator has no graphemes, so NFG stability check
@@ -1146,24 +1416,7 @@ MVMString * MVM_string_join(MVMThreadContext *tc, MVMString *separator, MVMObjec
             }
 
             /* Add piece. */
-            switch (piece->body.storage_type) {
-            case MVM_STRING_GRAPHEME_32: {
-                MVMint64 pgraphs = MVM_string_graphs(tc, piece);
-                memcpy(
-                    result->body.storage.blob_32 + position,
-                    piece->body.storage.blob_32,
-                    pgraphs * sizeof(MVMGrapheme32));
-                position += pgraphs;
-                break;
-            }
-            /* XXX Can special-case 8-bit NFG and ASCII here too. */
-            default:
-                MVM_string_gi_init(tc, &gi, piece);
-                while (MVM_string_gi_has_more(tc, &gi))
-                    result->body.storage.blob_32[position++] =
-                        MVM_string_gi_get_grapheme(tc, &gi);
-                break;
-            }
+            position = append_to_flat(tc, result, position, piece);
         }
     }
 
@@ -1247,30 +1500,7 @@ MVMint64 MVM_string_offset_has_unicode_property_value(MVMThreadContext *tc, MVMS
 MVMString * MVM_string_indexing_optimized(MVMThreadContext *tc, MVMString *s) {
     MVM_string_check_arg(tc, s, "indexingoptimized");
     if (s->body.storage_type == MVM_STRING_STRAND) {
-        MVMGrapheme32   *flat = MVM_malloc(MVM_string_graphs(tc, s) * sizeof(MVMGrapheme32));
-        MVMStringStrand *orig = s->body.storage.strands;
-        MVMuint32        i    = 0;
-        MVMString       *res;
-        MVMint8          can_fit_into_8bit = 1;
-
-        MVMGraphemeIter  gi;
-        MVM_string_gi_init(tc, &gi, s);
-        while (MVM_string_gi_has_more(tc, &gi)) {
-            MVMGrapheme32 g = MVM_string_gi_get_grapheme(tc, &gi);
-            if (g < -128 || g >= 128)
-                can_fit_into_8bit = 0;
-            flat[i++] = g;
-        }
-
-        res = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
-        res->body.storage_type    = MVM_STRING_GRAPHEME_32;
-        res->body.storage.blob_32 = flat;
-        res->body.num_graphs      = MVM_string_graphs(tc, s);
-
-        if (can_fit_into_8bit)
-            turn_32bit_into_8bit_unchecked(tc, res);
-
-        return res;
+        return collapse_strands(tc, s);
     }
     else {
         return s;
@@ -1362,15 +1592,23 @@ MVMString * MVM_string_flip(MVMThreadContext *tc, MVMString *s) {
     sgraphs = MVM_string_graphs(tc, s);
     rpos    = sgraphs;
 
-    if (s->body.storage_type == MVM_STRING_GRAPHEME_8) {
+    if (is_8bit_storage(s)) {
         MVMGrapheme8   *rbuffer;
+        MVMuint16       storage_type = s->body.storage_type == MVM_STRING_GRAPHEME_ASCII
+            ? MVM_STRING_GRAPHEME_ASCII
+            : MVM_STRING_GRAPHEME_8;
         rbuffer = MVM_malloc(sizeof(MVMGrapheme8) * sgraphs);
 
-        for (; spos < sgraphs; spos++)
-            rbuffer[--rpos] = s->body.storage.blob_8[spos];
+        /* Get the graphemes in order, then reverse them in place. */
+        copy_8bit_graphemes(tc, s, 0, sgraphs, rbuffer);
+        while (spos + 1 < rpos) {
+            MVMGrapheme8 g  = rbuffer[spos];
+            rbuffer[spos++] = rbuffer[--rpos];
+            rbuffer[rpos]   = g;
+        }
 
         res = (MVMString *)MVM_repr_alloc_init(tc, tc->instance->VMString);
-        res->body.storage_type    = MVM_STRING_GRAPHEME_8;
+        res->body.storage_type    = storage_type;
         res->body.storage.blob_8  = rbuffer;
     } else {
         MVMGrapheme32  *rbuffer;
@@ -1448,6 +1686,7 @@ MVMString * MVM_string_bitand(MVMThreadContext *tc, MVMString *a, MVMString *b)
     res->body.storage_type    = MVM_STRING_GRAPHEME_32;
     res->body.storage.blob_32 = buffer;
     res->body.num_graphs      = sgraphs;
+    MVM_string_try_narrow(tc, res);
 
     STRAND_CHECK(tc, res);
     return res;
@@ -1485,6 +1724,7 @@ MVMString * MVM_string_bitor(MVMThreadContext *tc, MVMString *a, MVMString *b) {
     res->body.storage_type    = MVM_STRING_GRAPHEME_32;
     res->body.storage.blob_32 = buffer;
     res->body.num_graphs      = sgraphs;
+    MVM_string_try_narrow(tc, res);
 
     STRAND_CHECK(tc, res);
     return res;
@@ -1522,6 +1762,7 @@ MVMString * MVM_string_bitxor(MVMThreadContext *tc, MVMString *a, MVMString *b)
     res->body.storage_type    = MVM_STRING_GRAPHEME_32;
     res->body.storage.blob_32 = buffer;
     res->body.num_graphs      = sgraphs;
+    MVM_string_try_narrow(tc, res);
 
     STRAND_CHECK(tc, res);
     return res;
@@ -1545,9 +1786,16 @@ static MVMint64 UPV_Pi = 0;
 static MVMint64 UPV_Pf = 0;
 static MVMint64 UPV_Po = 0;
 
+/* For each ASCII codepoint, a bitmap of the character classes it is in. The
+ * class constants are all single bits, so we can test membership with a
+ * mask. Filled out at startup from the general lookup, so the two agree. */
+static MVMuint16 ascii_cclasses[128];
+
 /* concatenating with "" ensures that only literal strings are accepted as argument. */
 #define STR_WITH_LEN(str)  ("" str ""), (sizeof(str) - 1)
 
+static void init_ascii_cclasses(MVMThreadContext *tc);
+
 /* Resolves various unicode property values that we'll need. */
 void MVM_string_cclass_init(MVMThreadContext *tc) {
     UPV_Nd = MVM_unicode_cname_to_property_value_code(tc,
@@ -1580,6 +1828,7 @@ void MVM_string_cclass_init(MVMThreadContext *tc) {
         MVM_UNICODE_PROPERTY_GENERAL_CATEGORY, STR_WITH_LEN("Pf"));
     UPV_Po = MVM_unicode_cname_to_property_value_code(tc,
         MVM_UNICODE_PROPERTY_GENERAL_CATEGORY, STR_WITH_LEN("Po"));
+    init_ascii_cclasses(tc);
 }
 
 /* Checks if the specified grapheme is in the given character class. */
@@ -1703,6 +1952,52 @@ static MVMint64 grapheme_is_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMGra
     }
 }
 
+/* Builds the ASCII character class bitmaps. */
+static void init_ascii_cclasses(MVMThreadContext *tc) {
+    static const MVMuint16 cclasses[] = {
+        MVM_CCLASS_UPPERCASE, MVM_CCLASS_LOWERCASE, MVM_CCLASS_ALPHABETIC,
+        MVM_CCLASS_NUMERIC, MVM_CCLASS_HEXADECIMAL, MVM_CCLASS_WHITESPACE,
+        MVM_CCLASS_PRINTING, MVM_CCLASS_BLANK, MVM_CCLASS_CONTROL,
+        MVM_CCLASS_PUNCTUATION, MVM_CCLASS_ALPHANUMERIC, MVM_CCLASS_NEWLINE,
+        MVM_CCLASS_WORD
+    };
+    MVMGrapheme32 cp;
+    MVMuint32     i;
+    for (cp = 0; cp < 128; cp++) {
+        MVMuint16 bits = 0;
+        for (i = 0; i < sizeof(cclasses) / sizeof(MVMuint16); i++)
+            if (grapheme_is_cclass(tc, cclasses[i], cp))
+                bits |= cclasses[i];
+        ascii_cclasses[cp] = bits;
+    }
+}
+
+/* Checks if the bitmaps can answer for a character class: it must be a single
+ * class (any other value is in no class) or be the class of everything. */
+MVM_STATIC_INLINE MVMint32 cclass_has_bitmap(MVMint64 cclass) {
+    return cclass == MVM_CCLASS_ANY ||
+        (cclass > 0 && cclass < MVM_CCLASS_ANY && (cclass & (cclass - 1)) == 0);
+}
+
+/* Scans a string with 8-bit storage from offset up to end for the first
+ * grapheme whose membership of the class is the wanted one; ASCII is looked
+ * up in the bitmaps, and only synthetics need the general path. */
+static MVMint64 find_cclass_8bit(MVMThreadContext *tc, MVMint64 cclass, MVMString *s,
+                                 MVMint64 offset, MVMint64 end, MVMint64 want) {
+    MVMGrapheme8 *blob = s->body.storage.blob_8;
+    MVMuint16     mask = (MVMuint16)cclass;
+    MVMint64      pos;
+    for (pos = offset; pos < end; pos++) {
+        MVMGrapheme8 g = blob[pos];
+        MVMint64     is = g >= 0
+            ? (ascii_cclasses[g] & mask) != 0
+            : grapheme_is_cclass(tc, cclass, g) != 0;
+        if (is == want)
+            return pos;
+    }
+    return end;
+}
+
 /* Checks if the character at the specified offset is a member of the
  * indicated character class. */
 MVMint64 MVM_string_is_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMString *s, MVMint64 offset) {
@@ -1711,6 +2006,8 @@ MVMint64 MVM_string_is_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMString *
     if (offset < 0 || offset >= MVM_string_graphs(tc, s))
         return 0;
     g = MVM_string_get_grapheme_at_nocheck(tc, s, offset);
+    if (g >= 0 && g < 128 && cclass_has_bitmap(cclass))
+        return (ascii_cclasses[g] & (MVMuint16)cclass) != 0;
     return grapheme_is_cclass(tc, cclass, g);
 }
 
@@ -1727,6 +2024,10 @@ MVMint64 MVM_string_find_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMString
     if (offset < 0 || offset >= length)
         return end;
 
+    if ((s->body.storage_type == MVM_STRING_GRAPHEME_ASCII ||
+            s->body.storage_type == MVM_STRING_GRAPHEME_8) && cclass_has_bitmap(cclass))
+        return find_cclass_8bit(tc, cclass, s, offset, end, 1);
+
     MVM_string_gi_init(tc, &gi, s);
     MVM_string_gi_move_to(tc, &gi, offset);
     for (pos = offset; pos < end; pos++) {
@@ -1751,6 +2052,10 @@ MVMint64 MVM_string_find_not_cclass(MVMThreadContext *tc, MVMint64 cclass, MVMSt
     if (offset < 0 || offset >= length)
         return end;
 
+    if ((s->body.storage_type == MVM_STRING_GRAPHEME_ASCII ||
+            s->body.storage_type == MVM_STRING_GRAPHEME_8) && cclass_has_bitmap(cclass))
+        return find_cclass_8bit(tc, cclass, s, offset, end, 0);
+
     MVM_string_gi_init(tc, &gi, s);
     MVM_string_gi_move_to(tc, &gi, offset);
     for (pos = offset; pos < end; pos++) {
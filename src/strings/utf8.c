@@ -166,20 +166,40 @@ static MVMint32 utf8_encode(MVMuint8 *bp, MVMCodepoint cp) {
 
  /* end not_gerd section */
 
-#define UTF8_MAXINC (32 * 1024 * 1024)
+/* Number of codepoints we decode before handing them to the normalizer. */
+#define UTF8_NORM_CHUNK 256
+
+/* Normalizes a chunk of decoded codepoints into the result buffer, keeping
+ * track of the lowest and highest grapheme seen. */
+static void normalize_chunk(MVMThreadContext *tc, MVMNormalizer *norm, MVMCodepoint *chunk,
+                            MVMint32 chunk_size, MVMGrapheme32 **buffer, MVMint64 *bufsize,
+                            MVMint64 *count, MVMGrapheme32 *lowest_graph,
+                            MVMGrapheme32 *highest_graph) {
+    MVMint64 i = *count;
+    MVM_unicode_normalizer_process_codepoints(tc, norm, chunk, chunk_size, buffer, bufsize, count);
+    for (; i < *count; i++) {
+        MVMGrapheme32 g = (*buffer)[i];
+        if (g < *lowest_graph)
+            *lowest_graph = g;
+        if (g > *highest_graph)
+            *highest_graph = g;
+    }
+}
 
 /* Decodes the specified number of bytes of utf8 into an NFG string, creating
  * a result of the specified type. The type must have the MVMString REPR. */
 MVMString * MVM_string_utf8_decode(MVMThreadContext *tc, const MVMObject *result_type, const char *utf8, size_t bytes) {
     MVMString *result = (MVMString *)REPR(result_type)->allocate(tc, STABLE(result_type));
-    MVMint32 count = 0;
+    MVMint64 count = 0;
     MVMCodepoint codepoint;
     MVMint32 line_ending = 0;
     MVMint32 state = 0;
-    MVMint32 bufsize = bytes;
+    MVMint64 bufsize = bytes;
     MVMGrapheme32 lowest_graph  =  0x7fffffff;
     MVMGrapheme32 highest_graph = -0x7fffffff;
     MVMGrapheme32 *buffer = MVM_malloc(sizeof(MVMGrapheme32) * bufsize);
+    MVMCodepoint chunk[UTF8_NORM_CHUNK];
+    MVMint32 chunk_size = 0;
     size_t orig_bytes;
     const char *orig_utf8;
     MVMint32 line;
@@ -195,27 +215,16 @@ MVMString * MVM_string_utf8_decode(MVMThreadContext *tc, const MVMObject *result
 
     for (; bytes; ++utf8, --bytes) {
         switch(decode_utf8_byte(&state, &codepoint, (MVMuint8)*utf8)) {
-        case UTF8_ACCEPT: { /* got a codepoint */
-            MVMGrapheme32 g;
-            ready = MVM_unicode_normalizer_process_codepoint_to_grapheme(tc, &norm, codepoint, &g);
-            if (ready) {
-                while (count + ready >= bufsize) { /* if the buffer's full make a bigger one */
-                    buffer = MVM_realloc(buffer, sizeof(MVMGrapheme32) * (
-                        bufsize >= UTF8_MAXINC ? (bufsize += UTF8_MAXINC) : (bufsize *= 2)
-                    ));
-                }
-                buffer[count++] = g;
-                lowest_graph = g < lowest_graph ? g : lowest_graph;
-                highest_graph = g > highest_graph ? g : highest_graph;
-                while (--ready > 0) {
-                    g = MVM_unicode_normalizer_get_grapheme(tc, &norm);
-                    lowest_graph = g < lowest_graph ? g : lowest_graph;
-                    highest_graph = g > highest_graph ? g : highest_graph;
-                    buffer[count++] = g;
-                }
+        case UTF8_ACCEPT: /* got a codepoint */
+            /* Collect a chunk of them to normalize together, which is much
+             * faster for text that is mostly already in normal form. */
+            chunk[chunk_size++] = codepoint;
+            if (chunk_size == UTF8_NORM_CHUNK) {
+                normalize_chunk(tc, &norm, chunk, chunk_size, &buffer, &bufsize, &count,
+                    &lowest_graph, &highest_graph);
+                chunk_size = 0;
             }
             break;
-        }
         case UTF8_REJECT:
             /* found a malformed sequence; parse it again this time tracking
              * line and col numbers. */
@@ -257,6 +266,8 @@ MVMString * MVM_string_utf8_decode(MVMThreadContext *tc, const MVMObject *result
         MVM_free(buffer);
         MVM_exception_throw_adhoc(tc, "Malformed termination of UTF-8 string");
     }
+    normalize_chunk(tc, &norm, chunk, chunk_size, &buffer, &bufsize, &count,
+        &lowest_graph, &highest_graph);
 
     /* Get any final graphemes from the normalizer, and clean it up. */
     MVM_unicode_normalizer_eof(tc, &norm);
@@ -405,6 +405,7 @@ MVMString * MVM_string_utf8_c8_decode(MVMThreadContext *tc, const MVMObject *res
         result->body.storage.blob_32 = state.result;
         result->body.storage_type    = MVM_STRING_GRAPHEME_32;
         result->body.num_graphs      = state.result_pos;
+        MVM_string_try_narrow(tc, result);
         return result;
     }
 }
@@ -243,6 +243,7 @@ MVMString * MVM_string_windows1252_decode(MVMThreadContext *tc,
         }
     }
     result->body.num_graphs = result_graphs;
+    MVM_string_try_narrow(tc, result);
 
     return result;
 }
@@ -51,6 +51,7 @@ typedef struct MVMFixedSizeAllocSizeClass MVMFixedSizeAllocSizeClass;
 typedef struct MVMFrame MVMFrame;
 typedef struct MVMFrameHandler MVMFrameHandler;
 typedef struct MVMGen2Allocator MVMGen2Allocator;
+typedef struct MVMGCStats MVMGCStats;
 typedef struct MVMGen2SizeClass MVMGen2SizeClass;
 typedef struct MVMGCPassedWork MVMGCPassedWork;
 typedef struct MVMGCWorklist MVMGCWorklist;
@@ -61,6 +62,9 @@ typedef struct MVMHashBody MVMHashBody;
 typedef struct MVMHashEntry MVMHashEntry;
 typedef struct MVMHLLConfig MVMHLLConfig;
 typedef struct MVMIntConstCache MVMIntConstCache;
+typedef struct MVMWorker MVMWorker;
+typedef struct MVMWorkerDequeArray MVMWorkerDequeArray;
+typedef struct MVMWorkerPool MVMWorkerPool;
 typedef struct MVMInstance MVMInstance;
 typedef struct MVMInvocationSpec MVMInvocationSpec;
 typedef struct MVMIter MVMIter;
@@ -76,6 +80,7 @@ typedef struct MVMLoadedCompUnitName MVMLoadedCompUnitName;
 typedef struct MVMNFA MVMNFA;
 typedef struct MVMNFABody MVMNFABody;
 typedef struct MVMNFAStateInfo MVMNFAStateInfo;
+typedef struct MVMNFGCacheEntry MVMNFGCacheEntry;
 typedef struct MVMNFGState MVMNFGState;
 typedef struct MVMNFGSynthetic MVMNFGSynthetic;
 typedef struct MVMNFGTrieNode MVMNFGTrieNode;
@@ -110,6 +115,7 @@ typedef struct MVMCUnionREPRData MVMCUnionREPRData;
 typedef struct MVMMultiCache MVMMultiCache;
 typedef struct MVMMultiCacheBody MVMMultiCacheBody;
 typedef struct MVMMultiCacheNode MVMMultiCacheNode;
+typedef struct MVMMultiCacheVersion MVMMultiCacheVersion;
 typedef struct MVMMultiDimArray MVMMultiDimArray;
 typedef struct MVMMultiDimArrayBody MVMMultiDimArrayBody;
 typedef struct MVMMultiDimArrayREPRData MVMMultiDimArrayREPRData;
@@ -117,6 +123,7 @@ typedef struct MVMContinuation MVMContinuation;
 typedef struct MVMContinuationBody MVMContinuationBody;
 typedef struct MVMReentrantMutex MVMReentrantMutex;
 typedef struct MVMReentrantMutexBody MVMReentrantMutexBody;
+typedef struct MVMLockContention MVMLockContention;
 typedef struct MVMConditionVariable MVMConditionVariable;
 typedef struct MVMConditionVariableBody MVMConditionVariableBody;
 typedef struct MVMSemaphore MVMSemaphore;
@@ -125,6 +132,11 @@ typedef struct MVMConcBlockingQueue MVMConcBlockingQueue;
 typedef struct MVMConcBlockingQueueBody MVMConcBlockingQueueBody;
 typedef struct MVMConcBlockingQueueNode MVMConcBlockingQueueNode;
 typedef struct MVMConcBlockingQueueLocks MVMConcBlockingQueueLocks;
+typedef struct MVMConcLockFreeQueue MVMConcLockFreeQueue;
+typedef struct MVMConcLockFreeQueueBody MVMConcLockFreeQueueBody;
+typedef struct MVMConcLockFreeQueueSegment MVMConcLockFreeQueueSegment;
+typedef struct MVMConcLockFreeQueueState MVMConcLockFreeQueueState;
+typedef struct MVMConcLockFreeQueueREPRData MVMConcLockFreeQueueREPRData;
 typedef struct MVMObject MVMObject;
 typedef struct MVMObjectId MVMObjectId;
 typedef struct MVMObjectStooge MVMObjectStooge;
@@ -173,14 +185,20 @@ typedef struct MVMSpeshGuard MVMSpeshGuard;
 typedef struct MVMSpeshLogGuard MVMSpeshLogGuard;
 typedef struct MVMSpeshCallInfo MVMSpeshCallInfo;
 typedef struct MVMSpeshInline MVMSpeshInline;
+typedef struct MVMSpeshEvent MVMSpeshEvent;
+typedef struct MVMSpeshEventString MVMSpeshEventString;
+typedef struct MVMSpeshEventLog MVMSpeshEventLog;
 typedef struct MVMSTable MVMSTable;
 typedef struct MVMStaticFrame MVMStaticFrame;
 typedef struct MVMStaticFrameBody MVMStaticFrameBody;
 typedef struct MVMStaticFrameInstrumentation MVMStaticFrameInstrumentation;
 typedef struct MVMStorageSpec MVMStorageSpec;
+typedef struct MVMStrBuilder MVMStrBuilder;
+typedef struct MVMStrBuilderBody MVMStrBuilderBody;
 typedef struct MVMString MVMString;
 typedef struct MVMStringBody MVMStringBody;
 typedef struct MVMStringConsts MVMStringConsts;
+typedef struct MVMStringInternTable MVMStringInternTable;
 typedef struct MVMStringStrand MVMStringStrand;
 typedef struct MVMGraphemeIter MVMGraphemeIter;
 typedef struct MVMCodepointIter MVMCodepointIter;
@@ -229,12 +247,17 @@ typedef struct MVMJitJumpList MVMJitJumpList;
 typedef struct MVMJitControl MVMJitControl;
 typedef struct MVMJitData MVMJitData;
 typedef struct MVMJitCode MVMJitCode;
+typedef struct MVMJitNativeCallStub MVMJitNativeCallStub;
 typedef struct MVMProfileThreadData MVMProfileThreadData;
 typedef struct MVMProfileGC MVMProfileGC;
 typedef struct MVMProfileCallNode MVMProfileCallNode;
 typedef struct MVMProfileAllocationCount MVMProfileAllocationCount;
 typedef struct MVMProfileContinuationData MVMProfileContinuationData;
 typedef struct MVMHeapSnapshotCollection MVMHeapSnapshotCollection;
+typedef struct MVMProfileSampleFrame MVMProfileSampleFrame;
+typedef struct MVMProfileSampleBuffer MVMProfileSampleBuffer;
+typedef struct MVMProfileSampleStack MVMProfileSampleStack;
+typedef struct MVMProfileSampler MVMProfileSampler;
 typedef struct MVMHeapSnapshot MVMHeapSnapshot;
 typedef struct MVMHeapSnapshotType MVMHeapSnapshotType;
 typedef struct MVMHeapSnapshotStaticFrame MVMHeapSnapshotStaticFrame;
@@ -243,3 +266,5 @@ typedef struct MVMHeapSnapshotReference MVMHeapSnapshotReference;
 typedef struct MVMHeapSnapshotState MVMHeapSnapshotState;
 typedef struct MVMHeapSnapshotWorkItem MVMHeapSnapshotWorkItem;
 typedef struct MVMHeapSnapshotSeen MVMHeapSnapshotSeen;
+typedef struct MVMHeapSnapshotStringEntry MVMHeapSnapshotStringEntry;
+typedef struct MVMHeapSnapshotTableEntry MVMHeapSnapshotTableEntry;
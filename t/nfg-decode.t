@@ -0,0 +1,36 @@
+# Checks that decoding forms graphemes from codepoints that join onto the one
+# before them, whatever their combining class, and that nothing joins onto a
+# run of ordinary characters. Each sequence is decoded from UTF-8, and built
+# with strfromcodes, as they go through the block normalizer separately.
+
+my @cases := [
+    ['Devanagari consonant and spacing mark',  [0x0915, 0x093E],                  1],
+    ['emoji and variation selector 16',         [0x2764, 0xFE0F],                  1],
+    ['letter and zero width non-joiner',        [0x0061, 0x200C],                  1],
+    ['emoji ZWJ sequence',                      [0x1F468, 0x200D, 0x1F469],        1],
+    ['regional indicator pair',                 [0x1F1EC, 0x1F1E7],                1],
+    ['two regional indicator pairs',            [0x1F1EC, 0x1F1E7, 0x1F1EB, 0x1F1F7], 2],
+    ['emoji base and modifier',                 [0x1F466, 0x1F3FB],                1],
+    ['Hangul L jamo and LV syllable',           [0x1100, 0xAC00],                  1],
+    ['Hangul L, V and T jamo',                  [0x1100, 0x1161, 0x11A8],          1],
+    ['text then spacing mark',                  [0x0061, 0x0062, 0x0915, 0x093E], 3],
+    ['spacing mark after a long run',           [0x0915, 0x0915, 0x0915, 0x0915, 0x0915, 0x093E], 5],
+    ['plain text',                              [0x0061, 0x0062, 0x0063, 0x0915], 4],
+];
+
+class Buf is repr('VMArray') { }
+nqp::composetype(Buf, nqp::hash('array', nqp::hash('type', uint8)));
+
+plan(2 * nqp::elems(@cases));
+
+for @cases -> @case {
+    my $name  := @case[0];
+    my @codes := nqp::list_i();
+    for @case[1] -> $cp {
+        nqp::push_i(@codes, $cp);
+    }
+    my $built := nqp::strfromcodes(@codes);
+    my $buf   := nqp::encode($built, 'utf8', nqp::create(Buf));
+    ok(nqp::chars($built) == @case[2], "$name: strfromcodes gives @case[2] grapheme(s)");
+    ok(nqp::chars(nqp::decode($buf, 'utf8')) == @case[2], "$name: utf8 decode gives @case[2] grapheme(s)");
+}
@@ -0,0 +1,99 @@
+# Checks that loop-invariant code motion leaves loops computing the same
+# results. Each routine is called often enough to be specialized and entered
+# by OSR, and every result is checked against one worked out without loops.
+
+# The inner loop computes values that are invariant within it but depend on
+# the outer loop variable, and reads constants and values hoisted out of the
+# inner loop, so a pass over the outer loop must not hoist anything that
+# reads them ahead of where they are written.
+sub nested(int $n, int $m) {
+    my int $total := 0;
+    my int $i     := 0;
+    while $i < $n {
+        my int $j := 0;
+        while $j < 10 {
+            my int $k := 3;
+            my int $x := $i * $k;
+            my int $y := $x + $m;
+            my int $z := $y * 2 - $k;
+            $total := $total + $z;
+            $j++;
+        }
+        $total := $total + $i * 5;
+        $i++;
+    }
+    $total
+}
+
+sub nested_expected(int $n, int $m) {
+    my int $total := 0;
+    my int $i     := 0;
+    while $i < $n {
+        $total := $total + 10 * ((3 * $i + $m) * 2 - 3) + $i * 5;
+        $i++;
+    }
+    $total
+}
+
+# The loop reads an outer lexical it never writes, so the read and the guard
+# on its type may be hoisted. Changing what the lexical holds then makes the
+# hoisted guard fail ahead of the loop.
+class Thing { }
+my $thing := Thing.new;
+
+sub count_concrete(int $n) {
+    my int $total := 0;
+    my int $i     := 0;
+    while $i < $n {
+        $total := $total + nqp::isconcrete($thing);
+        $i++;
+    }
+    $total
+}
+
+# Here the loop writes the lexical it reads, so nothing about it is invariant.
+sub count_alternating(int $n) {
+    my int $total := 0;
+    my int $i     := 0;
+    while $i < $n {
+        $total := $total + nqp::isconcrete($thing);
+        $thing := $i % 2 ?? Thing.new !! Thing;
+        $i++;
+    }
+    $total
+}
+
+plan(5);
+
+my int $calls  := 1000;
+my int $failed := 0;
+my int $c      := 0;
+while $c < $calls {
+    my int $n := 200 + $c % 7;
+    my int $m := $c % 13;
+    $failed++ if nested($n, $m) != nested_expected($n, $m);
+    $c++;
+}
+ok($failed == 0, "nested loops give the right results ($failed of $calls calls wrong)");
+
+$failed := 0;
+$c      := 0;
+while $c < $calls {
+    $failed++ if count_concrete(100 + $c % 7) != 100 + $c % 7;
+    $c++;
+}
+ok($failed == 0, "hoisted read of an outer lexical is right ($failed of $calls calls wrong)");
+
+$thing := Thing;
+ok(count_concrete(100) == 0, "hoisted guard failing ahead of the loop deoptimizes");
+$thing := Thing.new;
+ok(count_concrete(100) == 100, "loop is right again after deoptimizing");
+
+$failed := 0;
+$c      := 0;
+while $c < $calls {
+    $thing := Thing;
+    $failed++ if count_alternating(100) != 49;
+    $c++;
+}
+ok($failed == 0, "loop writing the lexical it reads is right ($failed of $calls calls wrong)");
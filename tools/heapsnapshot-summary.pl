@@ -0,0 +1,137 @@
+#!/usr/bin/env perl
+use v5.14;
+use warnings; use strict;
+
+# Reads a heap snapshot file written by the heap profiler when it is given a
+# path, and prints a summary of each snapshot in it: the number of objects,
+# their total size, and the types taking up the most space.
+#
+# Usage: heapsnapshot-summary.pl [--top=N] file
+#
+# See src/profiler/heapsnapshot.h for a description of the format.
+
+my $top = 20;
+if (@ARGV && $ARGV[0] =~ /^--top=(\d+)$/) {
+    $top = $1;
+    shift @ARGV;
+}
+die "Usage: $0 [--top=N] file\n" unless @ARGV == 1;
+
+my $file = $ARGV[0];
+open(my $fh, '<:raw', $file) or die "Cannot open $file: $!\n";
+local $/;
+my $data = <$fh>;
+close $fh;
+
+my $pos = 0;
+sub read_bytes {
+    my $len = shift;
+    die "Unexpected end of file at offset $pos\n" if $pos + $len > length($data);
+    my $bytes = substr($data, $pos, $len);
+    $pos += $len;
+    return $bytes;
+}
+sub read_varint {
+    my ($value, $shift) = (0, 0);
+    while (1) {
+        my $byte = ord(read_bytes(1));
+        $value |= ($byte & 0x7F) << $shift;
+        return $value unless $byte & 0x80;
+        $shift += 7;
+    }
+}
+
+my $magic = read_bytes(8);
+die "$file is not a MoarVM heap snapshot file\n" unless $magic eq 'MOARHEAP';
+my $version = read_varint();
+die "Unsupported heap snapshot format version $version\n" unless $version == 1;
+
+my $KIND_OBJECT      = 1;
+my $KIND_TYPE_OBJECT = 2;
+my $KIND_STABLE      = 3;
+my $KIND_FRAME       = 4;
+
+my (@strings, @types, @static_frames);
+my $snapshot = 0;
+
+while ($pos < length($data)) {
+    my $tag = read_bytes(1);
+    if ($tag eq 's') {
+        my $count = read_varint();
+        for (1..$count) {
+            push @strings, read_bytes(read_varint());
+        }
+    }
+    elsif ($tag eq 't') {
+        my $count = read_varint();
+        for (1..$count) {
+            push @types, [read_varint(), read_varint()];
+        }
+    }
+    elsif ($tag eq 'f') {
+        my $count = read_varint();
+        for (1..$count) {
+            push @static_frames, [read_varint(), read_varint(), read_varint(), read_varint()];
+        }
+    }
+    elsif ($tag eq 'h') {
+        my $num_collectables = read_varint();
+        my $num_references   = read_varint();
+        my (%by_name, $total_size, $total_unmanaged, $objects, $frames);
+        for my $i (0..$num_collectables - 1) {
+            my $kind           = read_varint();
+            my $index          = read_varint();
+            my $size           = read_varint();
+            my $unmanaged_size = read_varint();
+            my $num_refs       = read_varint();
+            for (1..$num_refs) {
+                read_varint();
+                read_varint();
+            }
+
+            my $name;
+            if ($kind == $KIND_OBJECT || $kind == $KIND_TYPE_OBJECT || $kind == $KIND_STABLE) {
+                my ($repr, $type) = @{$types[$index]};
+                $name = "$strings[$type] ($strings[$repr])";
+                $name .= ' type object' if $kind == $KIND_TYPE_OBJECT;
+                $name .= ' STable' if $kind == $KIND_STABLE;
+                $objects++;
+            }
+            elsif ($kind == $KIND_FRAME) {
+                my ($sf_name, $cuid, $line, $sf_file) = @{$static_frames[$index]};
+                $name = "frame '$strings[$sf_name]' ($strings[$sf_file]:$line)";
+                $frames++;
+            }
+            else {
+                next;
+            }
+            my $entry = $by_name{$name} //= [0, 0];
+            $entry->[0]++;
+            $entry->[1] += $size + $unmanaged_size;
+            $total_size      += $size;
+            $total_unmanaged += $unmanaged_size;
+        }
+
+        printf "Snapshot %d\n", $snapshot++;
+        printf "  %d collectables (%d objects, %d frames), %d references\n",
+            $num_collectables, $objects // 0, $frames // 0, $num_references;
+        printf "  %d bytes managed, %d bytes unmanaged\n",
+            $total_size // 0, $total_unmanaged // 0;
+        my @largest = sort { $by_name{$b}[1] <=> $by_name{$a}[1] } keys %by_name;
+        splice(@largest, $top) if @largest > $top;
+        printf "  %12s %10s  %s\n", 'bytes', 'count', 'type';
+        for my $name (@largest) {
+            printf "  %12d %10d  %s\n", $by_name{$name}[1], $by_name{$name}[0], $name;
+        }
+        print "\n";
+    }
+    elsif ($tag eq 'e') {
+        my $count = read_varint();
+        warn "End marker claims $count snapshots, but found $snapshot\n"
+            unless $count == $snapshot;
+        last;
+    }
+    else {
+        die sprintf("Unknown chunk tag 0x%02x at offset %d\n", ord($tag), $pos - 1);
+    }
+}
@@ -0,0 +1,167 @@
+#!/usr/bin/env perl
+use v5.14;
+use warnings; use strict;
+
+# Summarizes a spesh event log, as written when MVM_SPESH_EVENT_LOG is set.
+# Reports how often each kind of event happened, where the specializer spent
+# its time, which frames deoptimize most, any deopt storms (many deopts of a
+# frame within a short window), why inlining was refused, and which ops made
+# the JIT bail.
+#
+# Usage: spesh-events-summary.pl [--top=N] [--window=SECONDS] [--storm=COUNT] file
+#
+# The log must be read on a machine with the same byte order as the one that
+# wrote it. See src/spesh/events.h for a description of the format.
+
+my $top    = 15;
+my $window = 1;
+my $storm  = 100;
+while (@ARGV && $ARGV[0] =~ /^--(\w+)=(\S+)$/) {
+    if    ($1 eq 'top')    { $top = $2 }
+    elsif ($1 eq 'window') { $window = $2 }
+    elsif ($1 eq 'storm')  { $storm = $2 }
+    else { die "Unknown option --$1\n" }
+    shift @ARGV;
+}
+die "Usage: $0 [--top=N] [--window=SECONDS] [--storm=COUNT] file\n" unless @ARGV == 1;
+
+my @KIND_NAMES = (undef, 'frame definition', 'string definition',
+    'spesh start', 'spesh finish', 'candidate installed', 'guard failure',
+    'deopt one', 'deopt all', 'OSR', 'inline accepted', 'inline rejected',
+    'JIT bail');
+my @PHASES = ('logging', 'optimize');
+my @INLINE_REASONS = (undef, 'inlining disabled', 'too big', 'recursive',
+    'different HLL', 'still logging', 'op marked no-inline',
+    'outer lexical access', 'too many args');
+use constant {
+    DEF_FRAME => 1, DEF_STRING => 2, SPESH_START => 3, SPESH_FINISH => 4,
+    CANDIDATE_INSTALLED => 5, GUARD_FAIL => 6, DEOPT_ONE => 7, DEOPT_ALL => 8,
+    OSR => 9, INLINE_ACCEPTED => 10, INLINE_REJECTED => 11, JIT_BAIL => 12,
+};
+
+my $file = $ARGV[0];
+open(my $fh, '<:raw', $file) or die "Cannot open $file: $!\n";
+my $header;
+read($fh, $header, 16) == 16 or die "$file is too short to be a spesh event log\n";
+my ($magic, $version, $record_size) = unpack('a8 L L', $header);
+die "$file is not a MoarVM spesh event log\n" unless $magic eq 'MOARSPEV';
+die "Unsupported spesh event log version $version\n" unless $version == 1;
+die "Unexpected record size $record_size\n" unless $record_size == 32;
+
+my (%frames, %strings, %kinds);
+my (%spesh_time, %spesh_time_by_frame, %installed, %jitted);
+my (%guard_fails, %deopt_one, %deopt_one_at, %deopt_all, %deopted_by_all);
+my (%deopt_times, %osr, %inlined, %rejected_reason, %rejected_target, %bails);
+my ($num_events, $last_time) = (0, 0);
+
+my $record;
+while (read($fh, $record, $record_size) == $record_size) {
+    my ($time, $thread, $kind, $detail, $frame, $offset, $value) =
+        unpack('Q L S S L L Q', $record);
+    if ($kind == DEF_FRAME || $kind == DEF_STRING) {
+        my $text = '';
+        read($fh, $text, $value) == $value or die "Truncated definition in $file\n"
+            if $value;
+        ($kind == DEF_FRAME ? \%frames : \%strings)->{$frame} = $text;
+        next;
+    }
+    $num_events++;
+    $last_time = $time;
+    $kinds{$kind}++;
+    if ($kind == SPESH_FINISH) {
+        $spesh_time{$PHASES[$detail]} += $value;
+        $spesh_time_by_frame{$frame} += $value;
+    }
+    elsif ($kind == CANDIDATE_INSTALLED) {
+        $installed{$frame}++;
+        $jitted{$frame}++ if $detail;
+    }
+    elsif ($kind == GUARD_FAIL) {
+        $guard_fails{$frame}++;
+    }
+    elsif ($kind == DEOPT_ONE) {
+        $deopt_one{$frame}++;
+        $deopt_one_at{"$frame:$offset"}++;
+        push @{$deopt_times{$frame}}, $time;
+    }
+    elsif ($kind == DEOPT_ALL) {
+        $deopt_all{$frame}++;
+        $deopted_by_all{$frame} += $value;
+    }
+    elsif ($kind == OSR) {
+        $osr{$PHASES[$detail]}++;
+    }
+    elsif ($kind == INLINE_ACCEPTED) {
+        $inlined{$value}++;
+    }
+    elsif ($kind == INLINE_REJECTED) {
+        $rejected_reason{$detail}++;
+        $rejected_target{$value}++;
+    }
+    elsif ($kind == JIT_BAIL) {
+        $bails{$value}++;
+    }
+}
+close $fh;
+
+sub frame_name { my $id = shift; $id ? $frames{$id} // "<frame $id>" : '<none>' }
+sub ms { sprintf('%.3fms', $_[0] / 1e6) }
+sub top_of {
+    my $counts = shift;
+    my @keys = sort { $counts->{$b} <=> $counts->{$a} || $a cmp $b } keys %$counts;
+    splice(@keys, $top) if @keys > $top;
+    return @keys;
+}
+sub section {
+    my ($title, $counts, $namer) = @_;
+    return unless %$counts;
+    say "\n$title";
+    printf "  %10d  %s\n", $counts->{$_}, $namer->($_) for top_of($counts);
+}
+
+printf "%d events over %.3fs, %d frames\n", $num_events, $last_time / 1e9, scalar keys %frames;
+for my $kind (sort { $a <=> $b } keys %kinds) {
+    printf "  %10d  %s\n", $kinds{$kind}, $KIND_NAMES[$kind] // "kind $kind";
+}
+
+if (%spesh_time) {
+    say "\nSpecialization time";
+    printf "  %12s  %s\n", ms($spesh_time{$_}), $_ for sort keys %spesh_time;
+    say "\nFrames with most specialization time";
+    printf "  %12s  %s\n", ms($spesh_time_by_frame{$_}), frame_name($_)
+        for top_of(\%spesh_time_by_frame);
+}
+
+section('Frames with most candidates installed', \%installed,
+    sub { frame_name($_[0]) . sprintf(' (%d JIT compiled)', $jitted{$_[0]} // 0) });
+section('Frames with most argument guard failures', \%guard_fails, \&frame_name);
+section('Frames with most deopts', \%deopt_one, \&frame_name);
+section('Most frequent deopt points', \%deopt_one_at, sub {
+    my ($frame, $offset) = split /:/, $_[0];
+    frame_name($frame) . " at offset $offset";
+});
+section('Frames doing most deopt alls', \%deopt_all,
+    sub { frame_name($_[0]) . " ($deopted_by_all{$_[0]} frames deoptimized)" });
+
+# Look for storms: the most deopts of a frame within any window.
+my %storms;
+for my $frame (keys %deopt_times) {
+    my $times = $deopt_times{$frame};
+    my ($start, $most) = (0, 0);
+    for my $end (0..$#$times) {
+        $start++ while $times->[$end] - $times->[$start] > $window * 1e9;
+        $most = $end - $start + 1 if $end - $start + 1 > $most;
+    }
+    $storms{$frame} = $most if $most >= $storm;
+}
+if (%storms) {
+    say "\nDeopt storms (at least $storm deopts within ${window}s)";
+    printf "  %10d  %s\n", $storms{$_}, frame_name($_) for top_of(\%storms);
+}
+
+say "\nOSR: " . join(', ', map { "$osr{$_} $_" } sort keys %osr) if %osr;
+section('Most inlined frames', \%inlined, \&frame_name);
+section('Inlining refusals by reason', \%rejected_reason,
+    sub { $INLINE_REASONS[$_[0]] // "reason $_[0]" });
+section('Frames most often refused inlining', \%rejected_target, \&frame_name);
+section('JIT bails by op', \%bails, sub { $strings{$_[0]} // "<string $_[0]>" });